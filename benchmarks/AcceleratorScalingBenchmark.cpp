@@ -0,0 +1,238 @@
+/**
+ * @file AcceleratorScalingBenchmark.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Scaling benchmark for the Accelerator: client threads x emulated devices x batch size x inference mode
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * The benchmark runs against the xrt mock, so every configuration can be measured without hardware.
+ * Scaling curves can be exported with the usual google benchmark flags, e.g.
+ * --benchmark_out=scaling.json --benchmark_out_format=json (or csv). The AcceleratorScalingReport target does this automatically.
+ *
+ * Argument order of every benchmark: devices / batch size / dispatch mode. The number of client threads is given by the threads: suffix.
+ * Dispatch modes:
+ *  0: synchronous inference through Accelerator::run/wait/read, serialized by one driver wide lock (how BaseDriver is used today). Every iteration
+ *     stores one batch into every device, so it counts batch size x devices items
+ *  1: synchronous inference where each client thread drives "its" device (thread index % devices) under a per device lock
+ *  2: asynchronous inference, clients store into the ring buffers and wait until as many results were archived as they submitted
+ */
+
+#include <FINNCppDriver/core/Accelerator.h>
+#include <FINNCppDriver/core/DeviceHandler.h>
+#include <FINNCppDriver/utils/AllocationHooks.h>
+#include <FINNCppDriver/utils/ConfigurationStructs.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <boost/log/core/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounters.h"
+
+// Provides config and shapes for testing
+#include "../unittests/core/UnittestConfig.h"
+using namespace FinnUnittest;
+
+namespace {
+    /**
+     * @brief Dispatch modes of the scaling benchmark. See file description.
+     *
+     */
+    enum class DISPATCH_MODE { SYNC_ACCELERATOR = 0, SYNC_PER_DEVICE = 1, ASYNC = 2 };
+
+    const std::string xclbinName = "finn-accel.xclbin";
+
+    /**
+     * @brief State shared between all client threads of one benchmark run. Created by the Setup and destroyed by the Teardown callback.
+     *
+     */
+    struct ScalingEnvironment {
+        Finn::Accelerator accelerator;
+        std::mutex acceleratorMutex;
+        std::vector<std::unique_ptr<std::mutex>> deviceMutexes;
+        std::size_t inputElements = 0;
+        std::size_t outputSampleBytes = 0;
+    };
+
+    /**
+     * @brief Time an asynchronous client waits for its results before the benchmark is aborted
+     *
+     */
+    constexpr std::chrono::seconds asyncResultTimeout{10};
+
+    std::unique_ptr<ScalingEnvironment> env;
+
+    /**
+     * @brief Create a config with the given number of emulated devices. Every device carries the same network as the unittest config.
+     *
+     * @param devices
+     * @return std::vector<Finn::DeviceWrapper>
+     */
+    std::vector<Finn::DeviceWrapper> createDeviceWrappers(unsigned int devices) {
+        std::vector<Finn::DeviceWrapper> wrappers;
+        wrappers.reserve(devices);
+        for (unsigned int i = 0; i < devices; ++i) {
+            Finn::DeviceWrapper wrapper = unittestConfig.deviceWrappers[0];
+            wrapper.xclbin = xclbinName;
+            wrapper.xrtDeviceIndex = i;
+            wrappers.emplace_back(wrapper);
+        }
+        return wrappers;
+    }
+
+    void setupScaling(const benchmark::State& state) {
+        // Async buffers log every transfer, which would dominate the measurement
+        finnBoost::log::core::get()->set_filter(finnBoost::log::trivial::severity >= finnBoost::log::trivial::warning);
+        std::fstream tmpfile(xclbinName, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+
+        const auto devices = static_cast<unsigned int>(state.range(0));
+        const auto batchSize = static_cast<unsigned int>(state.range(1));
+        const auto mode = static_cast<DISPATCH_MODE>(state.range(2));
+
+        env = std::make_unique<ScalingEnvironment>();
+        env->accelerator = Finn::Accelerator(createDeviceWrappers(devices), mode != DISPATCH_MODE::ASYNC, batchSize);
+        for (unsigned int i = 0; i < devices; ++i) {
+            env->deviceMutexes.emplace_back(std::make_unique<std::mutex>());
+        }
+        env->inputElements = env->accelerator.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, inputDmaName) * batchSize;
+        env->outputSampleBytes = env->accelerator.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, outputDmaName);
+    }
+
+    void teardownScaling([[maybe_unused]] const benchmark::State& state) {
+        env.reset();
+        std::filesystem::remove(xclbinName);
+    }
+
+    /**
+     * @brief Returns the requested percentile of the sorted latency samples in microseconds
+     *
+     * @param sorted
+     * @param percentile
+     * @return double
+     */
+    double percentileMicroseconds(const std::vector<std::chrono::nanoseconds>& sorted, double percentile) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        const auto index = static_cast<std::size_t>(percentile * static_cast<double>(sorted.size() - 1));
+        return static_cast<double>(sorted[index].count()) / 1000.0;
+    }
+}  // namespace
+
+static void BM_AcceleratorScaling(benchmark::State& state) {
+    const auto devices = static_cast<unsigned int>(state.range(0));
+    const auto batchSize = static_cast<unsigned int>(state.range(1));
+    const auto mode = static_cast<DISPATCH_MODE>(state.range(2));
+    const unsigned int device = static_cast<unsigned int>(state.thread_index()) % devices;
+
+    FinnUtils::BufferFiller filler(0, 255);
+    Finn::vector<uint8_t> data(env->inputElements);
+    filler.fillRandom(data.begin(), data.end());
+
+    Finn::DeviceHandler& handler = env->accelerator.getDeviceHandler(device);
+    auto storeFunc = env->accelerator.storeFactory(device, inputDmaName);
+    // Accelerator::run starts every device, so every device gets its own input
+    std::vector<decltype(storeFunc)> deviceStoreFuncs;
+    for (unsigned int i = 0; i < devices; ++i) {
+        deviceStoreFuncs.emplace_back(env->accelerator.storeFactory(i, inputDmaName));
+    }
+    // Results of the asynchronous mode that arrived beyond the ones of the current batch are credited to the next batch
+    std::size_t submitted = 0;
+    std::size_t completed = 0;
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(1 << 16);
+
+    const FinnBenchmark::AllocationScope allocations;
+    for (auto _ : state) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        switch (mode) {
+            case DISPATCH_MODE::SYNC_ACCELERATOR: {
+                std::lock_guard guard(env->acceleratorMutex);
+                for (auto& deviceStore : deviceStoreFuncs) {
+                    deviceStore(data.begin(), data.end());
+                }
+                env->accelerator.run();
+                env->accelerator.wait();
+                env->accelerator.read();
+                for (unsigned int i = 0; i < devices; ++i) {
+                    auto result = env->accelerator.getOutputData(i, outputDmaName, false);
+                    benchmark::DoNotOptimize(result);
+                }
+                break;
+            }
+            case DISPATCH_MODE::SYNC_PER_DEVICE: {
+                std::lock_guard guard(*env->deviceMutexes[device]);
+                storeFunc(data.begin(), data.end());
+                handler.run();
+                handler.wait();
+                handler.read();
+                auto result = handler.retrieveResults(outputDmaName, false);
+                benchmark::DoNotOptimize(result);
+                break;
+            }
+            case DISPATCH_MODE::ASYNC: {
+                storeFunc(data.begin(), data.end());
+                submitted += batchSize;
+                const auto deadline = start + asyncResultTimeout;
+                while (completed < submitted) {
+                    auto result = handler.retrieveResults(outputDmaName, false);
+                    if (result.empty()) {
+                        if (std::chrono::high_resolution_clock::now() > deadline) {
+                            state.SkipWithError("No results arrived in time");
+                            return;
+                        }
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    completed += result.size() / env->outputSampleBytes;
+                    benchmark::DoNotOptimize(result);
+                }
+                break;
+            }
+            default:
+                FinnUtils::unreachable();
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        latencies.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+    }
+
+    allocations.report(state);
+    std::sort(latencies.begin(), latencies.end());
+    const int64_t batchesPerIteration = (mode == DISPATCH_MODE::SYNC_ACCELERATOR) ? devices : 1;
+    state.SetItemsProcessed(state.iterations() * batchesPerIteration * batchSize);
+    state.SetBytesProcessed(state.iterations() * batchesPerIteration * static_cast<int64_t>(env->inputElements));
+    // Configuration counters are averaged, otherwise google benchmark sums them up over all client threads
+    state.counters["devices"] = benchmark::Counter(devices, benchmark::Counter::kAvgThreads);
+    state.counters["batch"] = benchmark::Counter(batchSize, benchmark::Counter::kAvgThreads);
+    state.counters["mode"] = benchmark::Counter(static_cast<double>(mode), benchmark::Counter::kAvgThreads);
+    state.counters["latency_p50_us"] = benchmark::Counter(percentileMicroseconds(latencies, 0.5), benchmark::Counter::kAvgThreads);
+    state.counters["latency_p99_us"] = benchmark::Counter(percentileMicroseconds(latencies, 0.99), benchmark::Counter::kAvgThreads);
+    state.counters["latency_max_us"] = benchmark::Counter(percentileMicroseconds(latencies, 1.0), benchmark::Counter::kAvgThreads);
+}
+BENCHMARK(BM_AcceleratorScaling)
+    ->ArgNames({"devices", "batch", "mode"})
+    ->ArgsProduct({{1, 2, 4, 8}, {1, 16, 256}, {static_cast<int64_t>(DISPATCH_MODE::SYNC_ACCELERATOR), static_cast<int64_t>(DISPATCH_MODE::SYNC_PER_DEVICE), static_cast<int64_t>(DISPATCH_MODE::ASYNC)}})
+    ->ThreadRange(1, 32)
+    ->Setup(setupScaling)
+    ->Teardown(teardownScaling)
+    ->MinTime(0.2)
+    ->UseRealTime();
+
+
+BENCHMARK_MAIN();
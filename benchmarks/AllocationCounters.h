@@ -0,0 +1,57 @@
+/**
+ * @file AllocationCounters.h
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Reports the allocations of a benchmark as google benchmark counters
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * Global operator new is only counted if the benchmark includes FINNCppDriver/utils/AllocationHooks.h once.
+ */
+
+#ifndef BENCHMARK_ALLOCATIONCOUNTERS_H
+#define BENCHMARK_ALLOCATIONCOUNTERS_H
+
+#include <FINNCppDriver/utils/AllocationCounter.h>
+#include <benchmark/benchmark.h>
+
+namespace FinnBenchmark {
+    /**
+     * @brief Counts the allocations of all threads of the process between construction and report(), including OpenMP threads of the codecs and worker threads of executors.
+     * In benchmarks with several threads only the first benchmark thread reports the count, which then covers the iterations of all benchmark threads.
+     * Allocations of other benchmark threads that are still setting up when the first thread starts counting are included as well.
+     *
+     */
+    class AllocationScope {
+         private:
+        FinnUtils::AllocationStatistics before;
+
+         public:
+        /**
+         * @brief Enable allocation counting and remember the current count of the process
+         *
+         */
+        AllocationScope() {
+            FinnUtils::AllocationCounter::enable();
+            before = FinnUtils::AllocationCounter::total(FinnUtils::AllocationCounter::globalStatistics());
+        }
+
+        /**
+         * @brief Set the allocs_per_iter and alloc_bytes_per_iter counters. Has to be called after the benchmark loop, which waits for all benchmark threads.
+         *
+         * @param state
+         */
+        void report(benchmark::State& state) const {
+            if (state.thread_index() != 0) {
+                return;
+            }
+            const auto diff = FinnUtils::AllocationCounter::total(FinnUtils::AllocationCounter::globalStatistics()) - before;
+            state.counters["allocs_per_iter"] = benchmark::Counter(static_cast<double>(diff.allocations), benchmark::Counter::kAvgIterations);
+            state.counters["alloc_bytes_per_iter"] = benchmark::Counter(static_cast<double>(diff.bytes), benchmark::Counter::kAvgIterations);
+        }
+    };
+}  // namespace FinnBenchmark
+
+#endif  // BENCHMARK_ALLOCATIONCOUNTERS_H
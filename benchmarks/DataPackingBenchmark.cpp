@@ -1,234 +1,301 @@
 /**
  * @file DataPackingBenchmark.cpp
  * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
- * @brief Unittest for the data packing and unpacking functionalities of the FINN driver
- * @version 0.1
- * @date 2023-10-31
+ * @brief Benchmark matrix for the data packing and unpacking functionalities of the FINN driver
+ * @version 0.2
+ * @date 2026-10-18
  *
  * @copyright Copyright (c) 2023
  * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
  *
+ * Covers every bitwidth from 1 to 32 for signed, unsigned and fixed point datatypes plus bipolar, ternary and float, for pack and unpack at 600, 64K and 1M elements.
+ * Bytes per second always refer to the unpacked host representation of the data (elements * sizeof(host type)); for unpacking the host type is the type unpack returns, e.g. float for fixed point.
+ * The BM_Memcpy benchmarks copy the same number of bytes for host types of 1, 2 and 4 bytes and act as the bandwidth roofline for the codec benchmarks.
+ * allocs_per_iter and alloc_bytes_per_iter count the heap allocations of one pack or unpack call.
+ * BM_PackMultiDim_* and BM_UnpackMultiDim_* run the multi dimensional codecs on 1M INT3 elements folded as one row, 16 rows and 1024 rows.
+ * Rows are sharded between threads, so the throughput should not depend on the folding.
+ * BM_PackWorkload_* pack INT2 inputs (the input type of the default driver) replayed from a precomputed synthetic stream, including the copy of every batch.
+ * BM_Generate_* compare generating one batch of inputs with std::mt19937 against the WorkloadGenerator.
+ * Example: --benchmark_filter='BM_(Pack_INT|Memcpy_4B)' --benchmark_out=packing.json --benchmark_out_format=json
  */
 
+#include <FINNCppDriver/utils/AllocationHooks.h>
 #include <benchmark/benchmark.h>
 
 #include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/WorkloadGenerator.hpp>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
-std::random_device rnd_device;
-std::mt19937 mersenne_engine{rnd_device()};
+#include "AllocationCounters.h"
 
+namespace {
+    std::random_device rnd_device;
+    std::mt19937 mersenne_engine{rnd_device()};
 
-static void BM_PackUINT8_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeUInt<8>>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackUINT8_1M)->Iterations(1000);
-
-static void BM_PackINT3_1M(benchmark::State& state) {
-    std::uniform_int_distribution<int8_t> dist{-3, 3};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<int8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeInt<3>>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackINT3_1M)->Iterations(1000);
-
-static void BM_PackINT4_1M(benchmark::State& state) {
-    std::uniform_int_distribution<int8_t> dist{-8, 8};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<int8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeInt<4>>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackINT4_1M)->Iterations(1000);
-
-static void BM_PackINT7_1M(benchmark::State& state) {
-    std::uniform_int_distribution<int8_t> dist{-8, 8};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<int8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeInt<7>>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackINT7_1M)->Iterations(1000);
-
-static void BM_PackINT7_600(benchmark::State& state) {
-    std::uniform_int_distribution<int8_t> dist{-8, 8};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<int8_t> inp(600);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeInt<7>>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackINT7_600)->Iterations(10000);
-
-static void BM_PackINT32_1M(benchmark::State& state) {
-    std::uniform_int_distribution<int32_t> dist{-1000, 1000};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<int32_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeInt<32>>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackINT32_1M)->Iterations(1000);
-
-static void BM_PackFLOAT32_F_1M(benchmark::State& state) {
-    std::uniform_real_distribution<> dist{-1000, 1000};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<float> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeFloat>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackFLOAT32_F_1M)->Iterations(1000);
-
-static void BM_PackFLOAT32_D_1M(benchmark::State& state) {
-    std::uniform_real_distribution<> dist{-1000, 1000};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<double> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeFloat>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackFLOAT32_D_1M)->Iterations(1000);
-
-static void BM_PackFLOAT32_D_500K(benchmark::State& state) {
-    std::uniform_real_distribution<> dist{-1000, 1000};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<double> inp(500000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeFloat>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackFLOAT32_D_500K)->Iterations(1000);
-
-static void BM_PackFLOAT32_D_250K(benchmark::State& state) {
-    std::uniform_real_distribution<> dist{-1000, 1000};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<double> inp(250000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeFloat>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackFLOAT32_D_250K)->Iterations(1000);
-
-static void BM_PackFLOAT32_D_600(benchmark::State& state) {
-    std::uniform_real_distribution<> dist{-1000, 1000};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    std::vector<double> inp(250000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::pack<Finn::DatatypeFloat>(inp.begin(), inp.end());
-}
-// Register the function as a benchmark
-BENCHMARK(BM_PackFLOAT32_D_600)->Iterations(10000);
-
-static void BM_UnpackUINT8_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeUInt<8>>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackUINT8_1M)->Iterations(1000);
-
-static void BM_UnpackUINT16_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeUInt<16>>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackUINT16_1M)->Iterations(1000);
-
-static void BM_UnpackINT10_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeInt<10>>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackINT10_1M)->Iterations(1000);
-
-static void BM_UnpackINT16_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeInt<16>>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackINT16_1M)->Iterations(1000);
-
-static void BM_UnpackUINT64_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeUInt<64>>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackUINT64_1M)->Iterations(1000);
-
-static void BM_UnpackFLOAT_1M(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(1000000);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeFloat>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackFLOAT_1M)->Iterations(1000);
-
-static void BM_UnpackFLOAT_600(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(600);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeFloat>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackFLOAT_600)->Iterations(10000);
-
-static void BM_UnpackINT10_600(benchmark::State& state) {
-    std::uniform_int_distribution<uint8_t> dist{0, 255};
-    auto gen = [&dist]() { return dist(mersenne_engine); };
-    Finn::vector<uint8_t> inp(600);
-    std::generate(inp.begin(), inp.end(), gen);
-    for (auto _ : state)
-        auto ret = Finn::unpack<Finn::DatatypeInt<10>>(inp);
-}
-// Register the function as a benchmark
-BENCHMARK(BM_UnpackINT10_600)->Iterations(10000);
+    /**
+     * @brief Number of elements used for every datatype
+     *
+     */
+    constexpr std::array<std::pair<std::size_t, const char*>, 3> sizes = {{{600, "600"}, {65536, "64K"}, {1000000, "1M"}}};
+
+    /**
+     * @brief Host type used to hold unpacked signed values of bitwidth B
+     *
+     * @tparam B
+     */
+    template<std::size_t B>
+    using SignedHostType = Finn::UnpackingAutoRetType::SignedRetType<Finn::DatatypeInt<B>>;
 
+    /**
+     * @brief Host type used to hold unpacked unsigned values of bitwidth B
+     *
+     * @tparam B
+     */
+    template<std::size_t B>
+    using UnsignedHostType = Finn::UnpackingAutoRetType::UnsignedRetType<Finn::DatatypeUInt<B>>;
 
-BENCHMARK_MAIN();
+    /**
+     * @brief Fixed point type of bitwidth B with about half of the bits as integer bits
+     *
+     * @tparam B
+     */
+    template<std::size_t B>
+    using FixedType = Finn::DatatypeFixed<B, (B + 1) / 2>;
+
+    /**
+     * @brief Create random input values that are valid for the datatype U
+     *
+     * @tparam U Finn datatype
+     * @tparam HostType Type the values are stored in
+     * @param elements
+     * @return Finn::vector<HostType>
+     */
+    template<typename U, typename HostType>
+    Finn::vector<HostType> createInput(std::size_t elements) {
+        Finn::vector<HostType> input(elements);
+        if constexpr (std::is_same_v<U, Finn::DatatypeBipolar>) {
+            std::bernoulli_distribution dist;
+            std::generate(input.begin(), input.end(), [&dist]() { return dist(mersenne_engine) ? HostType{1} : HostType{-1}; });
+        } else if constexpr (std::is_same_v<U, Finn::DatatypeFloat>) {
+            std::uniform_real_distribution<HostType> dist{-1000, 1000};
+            std::generate(input.begin(), input.end(), [&dist]() { return dist(mersenne_engine); });
+        } else {
+            std::uniform_real_distribution<double> dist{U().min(), U().max()};
+            std::generate(input.begin(), input.end(), [&dist]() { return static_cast<HostType>(dist(mersenne_engine)); });
+        }
+        return input;
+    }
+
+    /**
+     * @brief Set the throughput counters. Bytes refer to the unpacked host representation, so that they are comparable to the memcpy baseline.
+     *
+     * @tparam U Finn datatype
+     * @tparam HostType
+     * @param state
+     * @param elements
+     */
+    template<typename U, typename HostType>
+    void setCodecCounters(benchmark::State& state, std::size_t elements) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * elements * sizeof(HostType)));
+        state.counters["bitwidth"] = static_cast<double>(U().bitwidth());
+        state.counters["packed_bytes"] = static_cast<double>(FinnUtils::fastDivCeil(elements * U().bitwidth(), std::size_t{8}));
+    }
+
+    template<typename U, typename HostType>
+    void BM_Pack(benchmark::State& state, std::size_t elements) {
+        // Packing works in place on the input for some datatypes, so every iteration packs a fresh copy of the source
+        const auto source = createInput<U, HostType>(elements);
+        auto input = source;
+        const FinnBenchmark::AllocationScope allocations;
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::copy(source.begin(), source.end(), input.begin());
+            state.ResumeTiming();
+            auto packed = Finn::pack<U>(input.begin(), input.end());
+            benchmark::DoNotOptimize(packed.data());
+            benchmark::ClobberMemory();
+        }
+        allocations.report(state);
+        setCodecCounters<U, HostType>(state, elements);
+    }
+
+    template<typename U, typename /*HostType*/>
+    void BM_Unpack(benchmark::State& state, std::size_t elements) {
+        // Unpack returns its own element type (e.g. float for fixed point types), which need not be the host type the inputs are packed from
+        using OutputType = Finn::UnpackingAutoRetType::AutoRetType<U>;
+        const std::size_t packedBytes = FinnUtils::fastDivCeil(elements * U().bitwidth(), std::size_t{8});
+        const std::size_t padding = packedBytes * 8 - elements * U().bitwidth();
+        Finn::vector<uint8_t> input(packedBytes);
+        std::uniform_int_distribution<uint16_t> dist{0, 255};
+        std::generate(input.begin(), input.end(), [&dist]() { return static_cast<uint8_t>(dist(mersenne_engine)); });
+        const FinnBenchmark::AllocationScope allocations;
+        for (auto _ : state) {
+            auto unpacked = Finn::unpack<U>(input, padding);
+            static_assert(std::is_same_v<typename decltype(unpacked)::value_type, OutputType>);
+            benchmark::DoNotOptimize(unpacked.data());
+            benchmark::ClobberMemory();
+        }
+        allocations.report(state);
+        setCodecCounters<U, OutputType>(state, elements);
+    }
+
+    void BM_Memcpy(benchmark::State& state, std::size_t bytes) {
+        Finn::vector<uint8_t> src(bytes);
+        Finn::vector<uint8_t> dst(bytes);
+        std::uniform_int_distribution<uint16_t> dist{0, 255};
+        std::generate(src.begin(), src.end(), [&dist]() { return static_cast<uint8_t>(dist(mersenne_engine)); });
+        for (auto _ : state) {
+            std::memcpy(dst.data(), src.data(), bytes);
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    }
+
+    void BM_PackMultiDim(benchmark::State& state, std::size_t rows, std::size_t rowElements) {
+        using U = Finn::DatatypeInt<3>;
+        auto input = createInput<U, int8_t>(rows * rowElements);
+        const shapeFolded_t foldedShape{static_cast<unsigned int>(rows), static_cast<unsigned int>(rowElements)};
+        const Finn::DynamicMdSpan reshaped(input.begin(), input.end(), foldedShape);
+        for (auto _ : state) {
+            auto packed = Finn::packMultiDimensionalInputs<U>(input.begin(), input.end(), reshaped, rowElements);
+            benchmark::DoNotOptimize(packed.data());
+            benchmark::ClobberMemory();
+        }
+        setCodecCounters<U, int8_t>(state, rows * rowElements);
+    }
+
+    void BM_UnpackMultiDim(benchmark::State& state, std::size_t rows, std::size_t rowElements) {
+        using U = Finn::DatatypeInt<3>;
+        const std::size_t rowBytes = FinnUtils::fastDivCeil(rowElements * U().bitwidth(), std::size_t{8});
+        Finn::vector<uint8_t> input(rows * rowBytes);
+        std::uniform_int_distribution<uint16_t> dist{0, 255};
+        std::generate(input.begin(), input.end(), [&dist]() { return static_cast<uint8_t>(dist(mersenne_engine)); });
+        const shapePacked_t packedShape{static_cast<unsigned int>(rows), static_cast<unsigned int>(rowBytes)};
+        const shapeFolded_t foldedShape{static_cast<unsigned int>(rows), static_cast<unsigned int>(rowElements)};
+        const Finn::DynamicMdSpan reshaped(input.begin(), input.end(), packedShape);
+        for (auto _ : state) {
+            auto unpacked = Finn::unpackMultiDimensionalOutputs<U>(input.begin(), input.end(), reshaped, foldedShape);
+            benchmark::DoNotOptimize(unpacked.data());
+            benchmark::ClobberMemory();
+        }
+        setCodecCounters<U, int8_t>(state, rows * rowElements);
+    }
+
+    void registerMultiDimBenchmarks() {
+        constexpr std::size_t elements = 1UL << 20U;
+        for (const std::size_t rows : {1UL, 16UL, 1024UL}) {
+            const std::string name = std::to_string(rows) + "x" + std::to_string(elements / rows);
+            benchmark::RegisterBenchmark(("BM_PackMultiDim_" + name).c_str(), BM_PackMultiDim, rows, elements / rows)->Unit(benchmark::kMicrosecond)->UseRealTime();
+            benchmark::RegisterBenchmark(("BM_UnpackMultiDim_" + name).c_str(), BM_UnpackMultiDim, rows, elements / rows)->Unit(benchmark::kMicrosecond)->UseRealTime();
+        }
+    }
+
+    /**
+     * @brief Number of precomputed batches the workload benchmarks cycle through
+     *
+     */
+    constexpr std::size_t workloadBatches = 16;
+
+    void BM_PackWorkload(benchmark::State& state, WORKLOAD workload, std::size_t elements) {
+        using U = Finn::DatatypeInt<2>;
+        Finn::WorkloadGenerator<int8_t> generator(elements, 1, workloadBatches, static_cast<int8_t>(U().min()), static_cast<int8_t>(U().max()), {.type = workload});
+        Finn::vector<int8_t> input(elements);
+        for (auto _ : state) {
+            generator.next(input.begin());
+            auto packed = Finn::pack<U>(input.begin(), input.end());
+            benchmark::DoNotOptimize(packed.data());
+            benchmark::ClobberMemory();
+        }
+        setCodecCounters<U, int8_t>(state, elements);
+    }
+
+    void BM_GenerateMersenne(benchmark::State& state, std::size_t elements) {
+        Finn::vector<int8_t> input(elements);
+        std::uniform_int_distribution<int16_t> dist{-2, 1};
+        for (auto _ : state) {
+            std::generate(input.begin(), input.end(), [&dist]() { return static_cast<int8_t>(dist(mersenne_engine)); });
+            benchmark::DoNotOptimize(input.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements));
+    }
+
+    void BM_GenerateWorkload(benchmark::State& state, std::size_t elements) {
+        for (auto _ : state) {
+            Finn::WorkloadGenerator<int8_t> generator(elements, 1, 1, -2, 1);
+            benchmark::DoNotOptimize(generator.batch(0).data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements));
+    }
+
+    void registerWorkloadBenchmarks() {
+        constexpr std::size_t elements = 65536;
+        for (auto workload : {WORKLOAD::UNIFORM, WORKLOAD::ZIPF, WORKLOAD::CORRELATED}) {
+            benchmark::RegisterBenchmark(("BM_PackWorkload_" + Finn::toString(workload) + "/64K").c_str(), BM_PackWorkload, workload, elements)->Unit(benchmark::kMicrosecond);
+        }
+        benchmark::RegisterBenchmark("BM_Generate_Mersenne/64K", BM_GenerateMersenne, elements)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("BM_Generate_Workload/64K", BM_GenerateWorkload, elements)->Unit(benchmark::kMicrosecond);
+    }
+
+    /**
+     * @brief Register pack and unpack benchmarks of one datatype for all sizes
+     *
+     * @tparam U Finn datatype
+     * @tparam HostType Type that holds the unpacked values
+     * @param typeName Name of the datatype used in the benchmark names
+     */
+    template<typename U, typename HostType>
+    void registerDatatype(const std::string& typeName) {
+        for (const auto& [elements, sizeName] : sizes) {
+            benchmark::RegisterBenchmark(("BM_Pack_" + typeName + "/" + sizeName).c_str(), BM_Pack<U, HostType>, elements)->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("BM_Unpack_" + typeName + "/" + sizeName).c_str(), BM_Unpack<U, HostType>, elements)->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+    /**
+     * @brief Register the benchmarks of all bitwidths in Widths for the signed, unsigned and fixed point datatypes
+     *
+     * @tparam Widths
+     */
+    template<std::size_t... Widths>
+    void registerAllWidths(std::index_sequence<Widths...> /*widths*/) {
+        (registerDatatype<Finn::DatatypeInt<Widths + 1>, SignedHostType<Widths + 1>>("INT" + std::to_string(Widths + 1)), ...);
+        (registerDatatype<Finn::DatatypeUInt<Widths + 1>, UnsignedHostType<Widths + 1>>("UINT" + std::to_string(Widths + 1)), ...);
+        (registerDatatype<FixedType<Widths + 1>, SignedHostType<Widths + 1>>("FIXED" + std::to_string(Widths + 1) + "_" + std::to_string(FixedType<Widths + 1>().intBits())), ...);
+    }
+
+    void registerCodecBenchmarks() {
+        registerAllWidths(std::make_index_sequence<32>{});
+        registerDatatype<Finn::DatatypeBipolar, int8_t>("BIPOLAR");
+        registerDatatype<Finn::DatatypeTernary, int8_t>("TERNARY");
+        registerDatatype<Finn::DatatypeFloat, float>("FLOAT32");
+
+        for (const std::size_t hostBytes : {1, 2, 4}) {
+            for (const auto& [elements, sizeName] : sizes) {
+                benchmark::RegisterBenchmark(("BM_Memcpy_" + std::to_string(hostBytes) + "B/" + sizeName).c_str(), BM_Memcpy, elements * hostBytes)->Unit(benchmark::kMicrosecond);
+            }
+        }
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    registerCodecBenchmarks();
+    registerMultiDimBenchmarks();
+    registerWorkloadBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file DriverOverheadBenchmark.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Overhead of the driver compared to the bare minimum of XRT calls needed for one synchronous inference
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * All benchmarks take the batch size as argument and use the buffer sizes of the configured network. Every inference is split into the same stages:
+ *  store:    copy the packed input into the input map
+ *  run:      sync the input to the device and start the output and input IP
+ *  wait:     poll the control register of the output IP until it is idle
+ *  read:     sync the output back from the device
+ *  retrieve: copy the output from the map into a host vector
+ * BM_RawXrt issues these stages directly with xrt::bo and xrt::ip and is the baseline.
+ * BM_DriverStages runs the same stages through the Accelerator, exactly as BaseDriver::infer does, and reports <stage>_us and overhead_<stage>_us.
+ * BM_DriverInfer times BaseDriver::infer with pre-packed data end to end and reports overhead_total_us, which also covers the checks,
+ * logging and statistics of the BaseDriver.
+ * Overheads are only reported if the baseline for the same batch size ran before in the same process, so filter for all three benchmarks.
+ * By default the benchmark is linked against the xrt mock and measures the pure host side overhead. Configure with -DFINN_BENCHMARK_WITH_XRT=ON
+ * and -DFINN_CUSTOM_UNITTEST_CONFIG=<config> to link it against XRT and measure the overhead on the emulator or the hardware described by the config.
+ * Example: --benchmark_filter='BM_(RawXrt|Driver.*)/batch:1$' --benchmark_out=overhead.json --benchmark_out_format=json
+ */
+
+#include <FINNCppDriver/config/FinnDriverUsedDatatypes.h>
+#include <FINNCppDriver/utils/AllocationHooks.h>
+#include <FINNCppDriver/utils/ConfigurationStructs.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <benchmark/benchmark.h>
+
+#include <FINNCppDriver/core/BaseDriver.hpp>
+#include <FINNCppDriver/core/DeviceBuffer/DeviceBuffer.hpp>
+#include <array>
+#include <boost/log/core/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "AllocationCounters.h"
+#include "experimental/xrt_ip.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+// Provides config and shapes for testing
+#include "../unittests/core/UnittestConfig.h"
+using namespace FinnUnittest;
+
+namespace {
+    const std::filesystem::path xclbinName = unittestConfig.deviceWrappers[0].xclbin;
+
+    /**
+     * @brief Stages of one synchronous inference. See file description.
+     *
+     */
+    enum class STAGE { STORE = 0, RUN = 1, WAIT = 2, READ = 3, RETRIEVE = 4 };
+    constexpr std::size_t stageCount = 5;
+    constexpr std::array<const char*, stageCount> stageNames = {"store", "run", "wait", "read", "retrieve"};
+
+    /**
+     * @brief Accumulates the time spent in every stage
+     *
+     */
+    class StageClock {
+         private:
+        std::array<std::chrono::nanoseconds, stageCount> spent{};
+        std::chrono::high_resolution_clock::time_point last;
+
+         public:
+        /**
+         * @brief Start timing the first stage of an inference
+         *
+         */
+        void start() { last = std::chrono::high_resolution_clock::now(); }
+
+        /**
+         * @brief Finish a stage, the next stage starts right away
+         *
+         * @param stage
+         */
+        void lap(STAGE stage) {
+            const auto now = std::chrono::high_resolution_clock::now();
+            spent[static_cast<std::size_t>(stage)] += now - last;
+            last = now;
+        }
+
+        /**
+         * @brief Mean time of every stage per iteration in microseconds
+         *
+         * @param iterations
+         * @return std::array<double, stageCount>
+         */
+        std::array<double, stageCount> meanMicroseconds(benchmark::IterationCount iterations) const {
+            std::array<double, stageCount> ret{};
+            for (std::size_t i = 0; i < stageCount; ++i) {
+                ret[i] = (iterations == 0) ? 0.0 : static_cast<double>(spent[i].count()) / 1000.0 / static_cast<double>(iterations);
+            }
+            return ret;
+        }
+    };
+
+    /**
+     * @brief Mean stage times of the raw XRT baseline, per batch size
+     *
+     */
+    std::map<int64_t, std::array<double, stageCount>> baselines;
+
+    /**
+     * @brief Driver that exposes the inference on pre-packed data
+     *
+     */
+    class OverheadDriver : public Finn::Driver<true> {
+         public:
+        OverheadDriver(const Finn::Config& pConfig, unsigned int batchSize) : Finn::Driver<true>(pConfig, batchSize) {}
+
+        template<typename IteratorType>
+        Finn::vector<uint8_t> inferPacked(IteratorType first, IteratorType last, unsigned int batchSize) {
+            return infer(first, last, 0, inputDmaName, 0, outputDmaName, batchSize, false);
+        }
+    };
+
+    /**
+     * @brief The buffer objects and IPs needed to run the network with plain XRT calls
+     *
+     */
+    struct RawXrtEnvironment {
+        xrt::device device;
+        xrt::uuid uuid;
+        std::size_t inputBytes = 0;
+        std::size_t outputBytes = 0;
+        std::optional<xrt::bo> inputBo;
+        std::optional<xrt::bo> outputBo;
+        uint8_t* inputMap = nullptr;
+        uint8_t* outputMap = nullptr;
+        xrt::ip inputIp;
+        xrt::ip outputIp;
+
+        explicit RawXrtEnvironment(uint32_t batchSize) : device(0), uuid(device.load_xclbin(xclbinName)) {
+            inputBytes = FinnUtils::shapeToElements(unittestConfig.deviceWrappers[0].idmas[0]->packedShape) * batchSize;
+            outputBytes = FinnUtils::shapeToElements(unittestConfig.deviceWrappers[0].odmas[0]->packedShape) * batchSize;
+            // Memory groups have to be queried before the IPs are opened, just like in DeviceBuffer
+            const auto inputGroup = static_cast<unsigned int>(xrt::kernel(device, uuid, inputDmaName).group_id(0));
+            const auto outputGroup = static_cast<unsigned int>(xrt::kernel(device, uuid, outputDmaName).group_id(0));
+            inputBo.emplace(device, FinnUtils::getActualBufferSize(inputBytes), inputGroup);
+            outputBo.emplace(device, FinnUtils::getActualBufferSize(outputBytes), outputGroup);
+            inputMap = inputBo->map<uint8_t*>();
+            outputMap = outputBo->map<uint8_t*>();
+            inputIp = xrt::ip(device, uuid, inputDmaName);
+            outputIp = xrt::ip(device, uuid, outputDmaName);
+            // Address and repetitions do not change between inferences, so only the start bit is written per inference
+            program(inputIp, *inputBo, batchSize);
+            program(outputIp, *outputBo, batchSize);
+        }
+
+        /**
+         * @brief Program buffer address and repetitions of an IP
+         *
+         */
+        static void program(xrt::ip& ip, const xrt::bo& bo, uint32_t repetitions) {
+            constexpr uint32_t offsetBuf = 0x10;
+            constexpr uint32_t offsetRep = 0x1C;
+            const uint64_t address = bo.address();
+            ip.write_register(offsetBuf, static_cast<uint32_t>(address));
+            ip.write_register(offsetBuf + 4, static_cast<uint32_t>(address >> 32));
+            ip.write_register(offsetRep, repetitions);
+        }
+    };
+
+    void setupOverhead([[maybe_unused]] const benchmark::State& state) {
+        // The driver logs every buffer creation, which would dominate the measurement
+        finnBoost::log::core::get()->set_filter(finnBoost::log::trivial::severity >= finnBoost::log::trivial::warning);
+#ifndef FINN_BENCHMARK_WITH_XRT
+        // The mock only checks that the xclbin exists
+        std::fstream tmpfile(xclbinName, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+#endif
+    }
+
+    void teardownOverhead([[maybe_unused]] const benchmark::State& state) {
+#ifndef FINN_BENCHMARK_WITH_XRT
+        std::filesystem::remove(xclbinName);
+#endif
+    }
+
+    /**
+     * @brief Report the stage times and, if the baseline for the batch size is known, the difference to it
+     *
+     */
+    void reportStages(benchmark::State& state, const StageClock& clock, bool isBaseline) {
+        const auto batchSize = state.range(0);
+        const auto stages = clock.meanMicroseconds(state.iterations());
+        if (isBaseline) {
+            baselines[batchSize] = stages;
+        }
+        const auto baseline = baselines.find(batchSize);
+        for (std::size_t i = 0; i < stageCount; ++i) {
+            state.counters[std::string(stageNames[i]) + "_us"] = stages[i];
+            if (!isBaseline && baseline != baselines.end()) {
+                state.counters["overhead_" + std::string(stageNames[i]) + "_us"] = stages[i] - baseline->second[i];
+            }
+        }
+    }
+}  // namespace
+
+static void BM_RawXrt(benchmark::State& state) {
+    const auto batchSize = static_cast<uint32_t>(state.range(0));
+    RawXrtEnvironment env(batchSize);
+    Finn::vector<uint8_t> data(env.inputBytes);
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+
+    StageClock clock;
+    const FinnBenchmark::AllocationScope allocations;
+    for (auto _ : state) {
+        clock.start();
+        std::memcpy(env.inputMap, data.data(), env.inputBytes);
+        clock.lap(STAGE::STORE);
+        env.inputBo->sync(XCL_BO_SYNC_BO_TO_DEVICE, env.inputBytes, 0);
+        env.outputIp.write_register(CSR_OFFSET, IP_START);
+        env.inputIp.write_register(CSR_OFFSET, IP_START);
+        clock.lap(STAGE::RUN);
+        while ((env.outputIp.read_register(CSR_OFFSET) & IP_IDLE) != IP_IDLE) {
+        }
+        clock.lap(STAGE::WAIT);
+        env.outputBo->sync(XCL_BO_SYNC_BO_FROM_DEVICE, env.outputBytes, 0);
+        clock.lap(STAGE::READ);
+        Finn::vector<uint8_t> result(env.outputMap, env.outputMap + env.outputBytes);
+        benchmark::DoNotOptimize(result);
+        clock.lap(STAGE::RETRIEVE);
+    }
+    allocations.report(state);
+    reportStages(state, clock, true);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * env.inputBytes));
+}
+BENCHMARK(BM_RawXrt)->ArgName("batch")->Arg(1)->Arg(16)->Arg(256)->Setup(setupOverhead)->Teardown(teardownOverhead)->UseRealTime();
+
+static void BM_DriverStages(benchmark::State& state) {
+    const auto batchSize = static_cast<unsigned int>(state.range(0));
+    Finn::Accelerator accelerator(unittestConfig.deviceWrappers, true, batchSize);
+    Finn::vector<uint8_t> data(accelerator.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE, 0, inputDmaName));
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+    auto storeFunc = accelerator.storeFactory(0, inputDmaName);
+
+    StageClock clock;
+    const FinnBenchmark::AllocationScope allocations;
+    for (auto _ : state) {
+        clock.start();
+        storeFunc(data.begin(), data.end());
+        clock.lap(STAGE::STORE);
+        accelerator.run();
+        clock.lap(STAGE::RUN);
+        accelerator.wait();
+        clock.lap(STAGE::WAIT);
+        accelerator.read();
+        clock.lap(STAGE::READ);
+        auto result = accelerator.getOutputData(0, outputDmaName, false);
+        benchmark::DoNotOptimize(result);
+        clock.lap(STAGE::RETRIEVE);
+    }
+    allocations.report(state);
+    reportStages(state, clock, false);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_DriverStages)->ArgName("batch")->Arg(1)->Arg(16)->Arg(256)->Setup(setupOverhead)->Teardown(teardownOverhead)->UseRealTime();
+
+static void BM_DriverInfer(benchmark::State& state) {
+    const auto batchSize = static_cast<unsigned int>(state.range(0));
+    OverheadDriver driver(unittestConfig, batchSize);
+    Finn::vector<uint8_t> data(driver.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE, 0, inputDmaName));
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+
+    const FinnBenchmark::AllocationScope allocations;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto _ : state) {
+        auto result = driver.inferPacked(data.begin(), data.end(), batchSize);
+        benchmark::DoNotOptimize(result);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+    allocations.report(state);
+    const double totalMicroseconds = static_cast<double>(elapsed.count()) / 1000.0 / static_cast<double>(std::max<benchmark::IterationCount>(state.iterations(), 1));
+    state.counters["total_us"] = totalMicroseconds;
+    if (const auto baseline = baselines.find(state.range(0)); baseline != baselines.end()) {
+        double baselineTotal = 0.0;
+        for (const double stage : baseline->second) {
+            baselineTotal += stage;
+        }
+        state.counters["overhead_total_us"] = totalMicroseconds - baselineTotal;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_DriverInfer)->ArgName("batch")->Arg(1)->Arg(16)->Arg(256)->Setup(setupOverhead)->Teardown(teardownOverhead)->UseRealTime();
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+/**
+ * @file SoakBenchmark.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Long running soak benchmark that checks the driver for throughput drift and memory growth
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * Runs synchronous and asynchronous inference against the xrt mock for a configurable duration. Every sampling interval the throughput,
+ * latency percentiles, resident set size and heap usage are sampled and compared to the first sample after the warmup.
+ * A run that drifts or grows beyond the thresholds is reported as an error and the benchmark exits with a non zero exit code.
+ * For soak tests on hardware use the soak mode of the driver (--exec_mode soak).
+ * Additional flags (defaults in brackets):
+ *  --soak_seconds=<s> [60]            Duration of every soak run
+ *  --soak_interval=<s> [5]            Sampling interval
+ *  --soak_max_drift=<fraction> [0.25] Maximum relative throughput drift
+ *  --soak_max_growth=<MiB> [64]       Maximum growth of resident set size and heap
+ */
+
+#include <FINNCppDriver/core/Accelerator.h>
+#include <FINNCppDriver/utils/AllocationHooks.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <benchmark/benchmark.h>
+
+#include <FINNCppDriver/utils/SoakMonitor.hpp>
+#include <algorithm>
+#include <boost/log/core/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Provides config and shapes for testing
+#include "../unittests/core/UnittestConfig.h"
+using namespace FinnUnittest;
+
+namespace {
+    const std::string xclbinName = "finn-accel.xclbin";
+
+    std::chrono::seconds soakDuration(60);
+    std::chrono::seconds soakInterval(5);
+    Finn::SoakThresholds soakThresholds{0.25, 64UL * 1024 * 1024, 64UL * 1024 * 1024, 1};
+    bool soakFailed = false;
+
+    /**
+     * @brief Remove the soak flags from argv, so that google benchmark does not report them as unrecognized
+     *
+     * @param argc
+     * @param argv
+     */
+    void parseSoakFlags(int& argc, char** argv) {
+        int kept = 1;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg(argv[i]);
+            const auto value = [&arg]() { return std::string(arg.substr(arg.find('=') + 1)); };
+            if (arg.starts_with("--soak_seconds=")) {
+                soakDuration = std::chrono::seconds(std::stoul(value()));
+            } else if (arg.starts_with("--soak_interval=")) {
+                soakInterval = std::chrono::seconds(std::stoul(value()));
+            } else if (arg.starts_with("--soak_max_drift=")) {
+                soakThresholds.maxThroughputDrift = std::stod(value());
+            } else if (arg.starts_with("--soak_max_growth=")) {
+                soakThresholds.maxRssGrowth = std::stoul(value()) * 1024 * 1024;
+                soakThresholds.maxHeapGrowth = soakThresholds.maxRssGrowth;
+            } else {
+                argv[kept++] = argv[i];
+            }
+        }
+        argc = kept;
+    }
+
+    /**
+     * @brief Set the counters of a finished soak run
+     *
+     * @param state
+     * @param monitor
+     */
+    void setSoakCounters(benchmark::State& state, const Finn::SoakMonitor& monitor) {
+        const auto& samples = monitor.getSamples();
+        if (samples.empty()) {
+            return;
+        }
+        const auto [minIt, maxIt] = std::minmax_element(samples.begin(), samples.end(), [](const auto& lhs, const auto& rhs) { return lhs.throughput < rhs.throughput; });
+        const auto& baseline = samples[std::min(soakThresholds.warmupSamples, samples.size() - 1)];
+        const auto& last = samples.back();
+        state.counters["samples"] = static_cast<double>(samples.size());
+        state.counters["throughput_min"] = minIt->throughput;
+        state.counters["throughput_max"] = maxIt->throughput;
+        state.counters["latency_p99_us"] = last.p99;
+        state.counters["latency_p999_us"] = last.p999;
+        state.counters["rss_growth_bytes"] = static_cast<double>(last.rss) - static_cast<double>(baseline.rss);
+        state.counters["heap_growth_bytes"] = static_cast<double>(last.heap) - static_cast<double>(baseline.heap);
+        state.counters["allocs_per_inference"] = (last.inferences > 0) ? static_cast<double>(last.allocations.allocations) / static_cast<double>(last.inferences) : 0;
+    }
+
+    void BM_Soak(benchmark::State& state, bool synchronousInference) {
+        finnBoost::log::core::get()->set_filter(finnBoost::log::trivial::severity >= finnBoost::log::trivial::warning);
+        std::fstream tmpfile(xclbinName, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+
+        const auto batchSize = static_cast<unsigned int>(state.range(0));
+        {
+            Finn::Accelerator accelerator(unittestConfig.deviceWrappers, synchronousInference, batchSize);
+            FinnUtils::BufferFiller filler(0, 255);
+            Finn::vector<uint8_t> data(accelerator.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, inputDmaName) * batchSize);
+            filler.fillRandom(data.begin(), data.end());
+            auto storeFunc = accelerator.storeFactory(0, inputDmaName);
+
+            auto step = [&]() -> std::size_t {
+                storeFunc(data.begin(), data.end());
+                if (synchronousInference) {
+                    accelerator.run();
+                    accelerator.wait();
+                    accelerator.read();
+                }
+                auto result = accelerator.getOutputData(0, outputDmaName, false);
+                benchmark::DoNotOptimize(result);
+                return batchSize;
+            };
+
+            Finn::SoakMonitor monitor(soakThresholds);
+            std::string reason;
+            for (auto _ : state) {
+                if (!monitor.run(step, soakDuration, soakInterval, reason)) {
+                    soakFailed = true;
+                    state.SkipWithError(reason.c_str());
+                }
+            }
+            setSoakCounters(state, monitor);
+        }
+        std::filesystem::remove(xclbinName);
+    }
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_Soak, sync, true)->ArgName("batch")->Arg(1)->Arg(256)->Iterations(1)->Unit(benchmark::kSecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Soak, async, false)->ArgName("batch")->Arg(1)->Arg(256)->Iterations(1)->Unit(benchmark::kSecond)->UseRealTime();
+
+int main(int argc, char** argv) {
+    parseSoakFlags(argc, argv);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return soakFailed ? 1 : 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file SubmissionQueueBenchmark.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Compares the mutex based RingBuffer with the lock-free MPMCQueue as submission queue for many producer threads
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * Every producer thread stores one part per iteration, while a single consumer thread drains the queue like the worker of an asynchronous input buffer.
+ * Argument order: queue type (0: RingBuffer, 1: MPMCQueue) / bytes per part. The number of producers is given by the threads: suffix.
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <benchmark/benchmark.h>
+
+#include <FINNCppDriver/utils/MPMCQueue.hpp>
+#include <FINNCppDriver/utils/RingBuffer.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <memory>
+#include <thread>
+
+namespace {
+    /**
+     * @brief Number of parts the queues can hold
+     *
+     */
+    constexpr std::size_t queueParts = 64;
+
+    std::unique_ptr<Finn::RingBuffer<uint8_t, true>> ringBuffer;
+    std::unique_ptr<Finn::MPMCQueue<uint8_t>> mpmcQueue;
+    std::jthread consumer;
+
+    void setupQueue(const benchmark::State& state) {
+        finnBoost::log::core::get()->set_filter(finnBoost::log::trivial::severity >= finnBoost::log::trivial::warning);
+        const auto partSize = static_cast<std::size_t>(state.range(1));
+        if (static_cast<SUBMISSION_QUEUE>(state.range(0)) == SUBMISSION_QUEUE::MPMC) {
+            mpmcQueue = std::make_unique<Finn::MPMCQueue<uint8_t>>(queueParts, partSize);
+            consumer = std::jthread([partSize](std::stop_token stoken) {
+                Finn::vector<uint8_t> part(partSize);
+                while (mpmcQueue->read(part.begin(), stoken)) {
+                    benchmark::DoNotOptimize(part.data());
+                }
+            });
+        } else {
+            ringBuffer = std::make_unique<Finn::RingBuffer<uint8_t, true>>(queueParts, partSize);
+            consumer = std::jthread([partSize](std::stop_token stoken) {
+                Finn::vector<uint8_t> part(partSize);
+                while (ringBuffer->read(part.begin(), stoken)) {
+                    benchmark::DoNotOptimize(part.data());
+                }
+            });
+        }
+    }
+
+    void teardownQueue([[maybe_unused]] const benchmark::State& state) {
+        // The ring buffer consumer only checks the stop token every 2 seconds while the buffer is empty
+        consumer.request_stop();
+        consumer.join();
+        ringBuffer.reset();
+        mpmcQueue.reset();
+    }
+}  // namespace
+
+static void BM_SubmissionQueue(benchmark::State& state) {
+    const auto partSize = static_cast<std::size_t>(state.range(1));
+    const bool useMpmc = static_cast<SUBMISSION_QUEUE>(state.range(0)) == SUBMISSION_QUEUE::MPMC;
+    Finn::vector<uint8_t> part(partSize);
+    FinnUtils::BufferFiller(0, 255).fillRandom(part.begin(), part.end());
+
+    for (auto _ : state) {
+        if (useMpmc) {
+            mpmcQueue->store(part.begin(), part.end());
+        } else {
+            ringBuffer->store(part.begin(), part.end());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * partSize));
+    state.counters["producers"] = benchmark::Counter(static_cast<double>(state.threads()), benchmark::Counter::kAvgThreads);
+}
+BENCHMARK(BM_SubmissionQueue)
+    ->ArgNames({"queue", "part_bytes"})
+    ->ArgsProduct({{static_cast<int64_t>(SUBMISSION_QUEUE::RING_BUFFER), static_cast<int64_t>(SUBMISSION_QUEUE::MPMC)}, {64, 4096}})
+    ->ThreadRange(1, 32)
+    ->Setup(setupQueue)
+    ->Teardown(teardownQueue)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
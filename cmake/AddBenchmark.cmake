@@ -1,4 +1,6 @@
+# Pass WITH_XRT to link the benchmark against XRT and finnc_core instead of the xrt mock
 function(add_benchmark benchmark_name)
+  cmake_parse_arguments(BENCHMARK "WITH_XRT" "" "" ${ARGN})
   get_filename_component(benchmark ${benchmark_name} NAME_WE)
 
   list(APPEND CMAKE_MESSAGE_INDENT "  ") #indent +1
@@ -11,16 +13,32 @@ function(add_benchmark benchmark_name)
   add_dependencies(Benchmarks ${benchmark})
   target_include_directories(${benchmark} PRIVATE ${FINN_SRC_DIR})
 
-  target_link_libraries(${benchmark}
-    PUBLIC
-    finnc_options
-    ${Boost_LIBRARIES}
-    finnc_utils
-    finnc_core_test
-    xrt_mock
-    benchmark::benchmark
-    OpenMP::OpenMP_CXX
-  )
+  if(BENCHMARK_WITH_XRT)
+    target_include_directories(${benchmark} SYSTEM PRIVATE ${XRT_INCLUDE_DIRS})
+    target_link_directories(${benchmark} PRIVATE ${XRT_LIB_CORE_LOCATION} ${XRT_LIB_OCL_LOCATION})
+    target_compile_definitions(${benchmark} PRIVATE FINN_BENCHMARK_WITH_XRT=1)
+    target_link_libraries(${benchmark}
+      PUBLIC
+      finnc_options
+      ${Boost_LIBRARIES}
+      finnc_utils
+      finnc_core
+      xrt_coreutil
+      benchmark::benchmark
+      OpenMP::OpenMP_CXX
+    )
+  else()
+    target_link_libraries(${benchmark}
+      PUBLIC
+      finnc_options
+      ${Boost_LIBRARIES}
+      finnc_utils
+      finnc_core_test
+      xrt_mock
+      benchmark::benchmark
+      OpenMP::OpenMP_CXX
+    )
+  endif()
 
   target_link_directories(${benchmark} PRIVATE ${BOOST_LIBRARYDIR})
 
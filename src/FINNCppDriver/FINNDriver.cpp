@@ -21,6 +21,7 @@
 #include <random>       // for random_device, ...
 #include <stdexcept>    // for invalid_argument
 #include <string>       // for string
+#include <thread>       // for sleep_for
 #include <tuple>        // for tuple
 #include <type_traits>  // for remove_ref...
 #include <utility>      // for move
@@ -31,20 +32,28 @@
 #include <FINNCppDriver/utils/ConfigurationStructs.h>  // for Config
 #include <FINNCppDriver/utils/DoNotOptimize.h>         // for DoNotOptimize
 #include <FINNCppDriver/utils/FinnUtils.h>             // for logAndError
+#include <FINNCppDriver/utils/LiveStats.h>             // for LiveStats
 #include <FINNCppDriver/utils/Logger.h>                // for FINN_LOG, ...
+#include <FINNCppDriver/utils/Tunables.h>              // for Tunables
 #include <FINNCppDriver/utils/Types.h>                 // for shape_t
 
-#include <FINNCppDriver/core/BaseDriver.hpp>      // IWYU pragma: keep
-#include <FINNCppDriver/utils/DataPacking.hpp>    // for AutoReturnType
-#include <FINNCppDriver/utils/DynamicMdSpan.hpp>  // for DynamicMdSpan
-#include <boost/program_options.hpp>              // for variables_map
-#include <ext/alloc_traits.h>                     // for __alloc_tr...
-#include <xtensor/xadapt.hpp>                     // for adapt
-#include <xtensor/xarray.hpp>                     // for xarray_ada...
-#include <xtensor/xiterator.hpp>                  // for operator==
-#include <xtensor/xlayout.hpp>                    // for layout_type
-#include <xtensor/xnpy.hpp>                       // for dump_npy, ...
-#include <xtl/xiterator_base.hpp>                 // for operator!=
+#include <FINNCppDriver/core/BaseDriver.hpp>          // IWYU pragma: keep
+#include <FINNCppDriver/utils/CodecAutotuner.hpp>     // for CodecAutotuner
+#include <FINNCppDriver/utils/ControlServer.hpp>      // for ControlServer
+#include <FINNCppDriver/utils/DataPacking.hpp>        // for AutoReturnType
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>      // for DynamicMdSpan
+#include <FINNCppDriver/utils/SamplingVerifier.hpp>   // for SamplingVerifier
+#include <FINNCppDriver/utils/SoakMonitor.hpp>        // for SoakMonitor
+#include <FINNCppDriver/utils/StatsPage.hpp>          // for StatsPublisher
+#include <FINNCppDriver/utils/WorkloadGenerator.hpp>  // for WorkloadGenerator
+#include <boost/program_options.hpp>                  // for variables_map
+#include <ext/alloc_traits.h>                         // for __alloc_tr...
+#include <xtensor/xadapt.hpp>                         // for adapt
+#include <xtensor/xarray.hpp>                         // for xarray_ada...
+#include <xtensor/xiterator.hpp>                      // for operator==
+#include <xtensor/xlayout.hpp>                        // for layout_type
+#include <xtensor/xnpy.hpp>                           // for dump_npy, ...
+#include <xtl/xiterator_base.hpp>                     // for operator!=
 
 
 // Created by FINN during compilation
@@ -133,17 +142,25 @@ Finn::Driver<SynchronousInference> createDriverFromConfig(const std::filesystem:
 template<typename O>
 using destribution_t = typename std::conditional_t<std::is_same_v<O, float>, std::uniform_real_distribution<O>, std::uniform_int_distribution<O>>;
 
+/**
+ * @brief Upper bound for the memory used by the precomputed inputs of the throughput test
+ *
+ */
+constexpr std::size_t workloadMemoryBudget = 256UL * 1024 * 1024;
+/**
+ * @brief Maximum number of precomputed input batches of the throughput test
+ *
+ */
+constexpr std::size_t workloadMaxBatches = 64;
+
 template<typename T>
-void runThroughputTestImpl(Finn::Driver<true>& baseDriver, std::size_t elementCount, uint batchSize) {
+void runThroughputTestImpl(Finn::Driver<true>& baseDriver, std::size_t elementCount, uint batchSize, const Finn::WorkloadOptions& workload) {
     using dtype = T;
     Finn::vector<dtype> testInputs(elementCount * batchSize);
 
-    std::random_device rndDevice;
-    std::mt19937 mersenneEngine{rndDevice()};  // Generates random integers
-
-    destribution_t<dtype> dist{static_cast<dtype>(InputFinnType().min()), static_cast<dtype>(InputFinnType().max())};
-
-    auto gen = [&dist, &mersenneEngine]() { return dist(mersenneEngine); };
+    // Inputs are generated before the measurement and replayed, packing modifies its input so every run gets a fresh copy
+    const std::size_t workloadBatches = std::clamp(workloadMemoryBudget / std::max<std::size_t>(testInputs.size() * sizeof(dtype), 1), std::size_t{1}, workloadMaxBatches);
+    Finn::WorkloadGenerator<dtype> generator(elementCount, batchSize, workloadBatches, static_cast<dtype>(InputFinnType().min()), static_cast<dtype>(InputFinnType().max()), workload);
 
     constexpr size_t nTestruns = 5000;
     std::chrono::duration<double> sumRuntimeEnd2End{};
@@ -153,8 +170,11 @@ void runThroughputTestImpl(Finn::Driver<true>& baseDriver, std::size_t elementCo
     auto warmup = baseDriver.inferSynchronous(testInputs.begin(), testInputs.end());
     Finn::DoNotOptimize(warmup);
 
+    // The wall time includes the idle gaps of bursty arrivals, so the achieved throughput reflects the arrival pattern
+    const auto loopStart = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < nTestruns; ++i) {
-        std::generate(testInputs.begin(), testInputs.end(), gen);
+        std::this_thread::sleep_for(generator.arrivalDelay(i));
+        generator.next(testInputs.begin());
         const auto start = std::chrono::high_resolution_clock::now();
         auto ret = baseDriver.inferSynchronous(testInputs.begin(), testInputs.end());
         Finn::DoNotOptimize(ret);
@@ -162,13 +182,14 @@ void runThroughputTestImpl(Finn::Driver<true>& baseDriver, std::size_t elementCo
 
         sumRuntimeEnd2End += (end - start);
     }
+    const std::chrono::duration<double> wallTimeEnd2End = std::chrono::high_resolution_clock::now() - loopStart;
 
     std::chrono::duration<double> sumRuntimePacking{};
     std::chrono::duration<double> sumRuntimeUnpacking{};
     std::chrono::duration<double> sumRuntimeReshaping{};
 
     for (size_t i = 0; i < nTestruns; ++i) {
-        std::generate(testInputs.begin(), testInputs.end(), gen);
+        generator.next(testInputs.begin());
         const auto start = std::chrono::high_resolution_clock::now();
         static auto foldedShape = static_cast<Finn::ExtendedBufferDescriptor*>(baseDriver.getConfig().deviceWrappers[0].idmas[0].get())->foldedShape;
         foldedShape[0] = batchSize;
@@ -198,6 +219,7 @@ void runThroughputTestImpl(Finn::Driver<true>& baseDriver, std::size_t elementCo
 
     std::cout << "Avg. end2end latency: " << (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(sumRuntimeEnd2End).count()) / nTestruns / 1000) << "us\n";
     std::cout << "Avg. end2end throughput: " << 1 / (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(sumRuntimeEnd2End).count()) / nTestruns / batchSize / 1000 / 1000 / 1000) << " inferences/s\n";
+    std::cout << "End2end throughput incl. arrival gaps: " << (static_cast<double>(nTestruns * batchSize) / wallTimeEnd2End.count()) << " inferences/s\n";
     std::cout << "Avg. packing latency: " << (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(sumRuntimePacking).count()) / nTestruns) << "ns\n";
     std::cout << "Avg. folding latency: " << (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(sumRuntimeReshaping).count()) / nTestruns) << "ns\n";
     std::cout << "Avg. unpacking latency: " << (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(sumRuntimeUnpacking).count()) / nTestruns) << "ns\n";
@@ -214,8 +236,9 @@ void runThroughputTestImpl(Finn::Driver<true>& baseDriver, std::size_t elementCo
  *
  * @param baseDriver
  * @param logger
+ * @param workload Synthetic input stream used for the test
  */
-void runThroughputTest(Finn::Driver<true>& baseDriver, logger_type& logger) {
+void runThroughputTest(Finn::Driver<true>& baseDriver, logger_type& logger, const Finn::WorkloadOptions& workload) {
     FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Device Information: ";
     logDeviceInformation(logger, baseDriver.getDeviceHandler(0).getDevice(), baseDriver.getConfig().deviceWrappers[0].xclbin);
 
@@ -223,15 +246,181 @@ void runThroughputTest(Finn::Driver<true>& baseDriver, logger_type& logger) {
     uint batchSize = baseDriver.getBatchSize();
     FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Input element count " << std::to_string(elementcount);
     FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Batch size: " << batchSize;
+    FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Workload: " << Finn::toString(workload.type);
 
     constexpr bool isInteger = InputFinnType().isInteger();
     if constexpr (isInteger) {
         using dtype = Finn::UnpackingAutoRetType::IntegralType<InputFinnType>;
-        runThroughputTestImpl<dtype>(baseDriver, elementcount, batchSize);
+        runThroughputTestImpl<dtype>(baseDriver, elementcount, batchSize, workload);
         // benchmark each step in call chain for int
     } else {
-        runThroughputTestImpl<float>(baseDriver, elementcount, batchSize);
+        runThroughputTestImpl<float>(baseDriver, elementcount, batchSize, workload);
+    }
+}
+
+/**
+ * @brief Options of a soak test
+ *
+ */
+struct SoakOptions {
+    /**
+     * @brief Duration of the soak test
+     *
+     */
+    std::chrono::seconds duration;
+    /**
+     * @brief Interval in which samples are taken and checked
+     *
+     */
+    std::chrono::seconds interval;
+    /**
+     * @brief Thresholds the soak test has to stay within
+     *
+     */
+    Finn::SoakThresholds thresholds;
+};
+
+/**
+ * @brief Time the asynchronous soak test waits for the results of a batch before it fails
+ *
+ */
+constexpr std::chrono::seconds asyncResultTimeout{10};
+
+template<typename T, bool SynchronousInference>
+bool runSoakTestImpl(Finn::Driver<SynchronousInference>& baseDriver, std::size_t elementCount, uint batchSize, const SoakOptions& options, std::string& reason) {
+    using dtype = T;
+    Finn::vector<dtype> testInputs(elementCount * batchSize);
+
+    std::random_device rndDevice;
+    std::mt19937 mersenneEngine{rndDevice()};  // Generates random integers
+
+    destribution_t<dtype> dist{static_cast<dtype>(InputFinnType().min()), static_cast<dtype>(InputFinnType().max())};
+    std::generate(testInputs.begin(), testInputs.end(), [&dist, &mersenneEngine]() { return dist(mersenneEngine); });
+    // Picks up changes made through the control socket between two batches
+    auto applyTunables = [&]() {
+        if (baseDriver.applyTunables()) {
+            batchSize = baseDriver.getBatchSize();
+            testInputs.resize(elementCount * batchSize);
+            std::generate(testInputs.begin(), testInputs.end(), [&dist, &mersenneEngine]() { return dist(mersenneEngine); });
+        }
+    };
+
+    Finn::SoakMonitor monitor(options.thresholds);
+    if constexpr (SynchronousInference) {
+        auto step = [&]() -> std::size_t {
+            applyTunables();
+            auto ret = baseDriver.inferSynchronous(testInputs.begin(), testInputs.end());
+            Finn::DoNotOptimize(ret);
+            return batchSize;
+        };
+        return monitor.run(step, options.duration, options.interval, reason);
+    } else {
+        // Inputs are packed per row, because BaseDriver::input packs the flat input without the padding of the rows
+        auto foldedShape = static_cast<Finn::ExtendedBufferDescriptor*>(baseDriver.getConfig().deviceWrappers[0].idmas[0].get())->foldedShape;
+        foldedShape[0] = batchSize;
+        const std::string inputKernelName = baseDriver.getConfig().deviceWrappers[0].idmas[0]->kernelName;
+        const std::string outputKernelName = baseDriver.getConfig().deviceWrappers[0].odmas[0]->kernelName;
+        const std::size_t outputSampleBytes = baseDriver.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, outputKernelName);
+        // Results are counted per sample, results that arrive early are credited to the next step
+        std::size_t submitted = 0;
+        std::size_t completed = 0;
+        auto step = [&]() -> std::size_t {
+            applyTunables();
+            foldedShape[0] = batchSize;
+            Finn::vector<dtype> input(testInputs);
+            const Finn::DynamicMdSpan reshapedInput(input.begin(), input.end(), foldedShape);
+            auto packed = Finn::packMultiDimensionalInputs<InputFinnType>(input.begin(), input.end(), reshapedInput, foldedShape.back(), baseDriver.getPackTuning());
+            // The buffers are used directly, so the step reports to the live statistics itself
+            FinnUtils::LiveStats::StageTimer inferTimer(DRIVER_STAGE::NONE);
+            baseDriver.getInputBuffer(0, inputKernelName)->store(packed);
+            submitted += batchSize;
+            // Wait for the results of the batch, so that the step measures finished inferences and not only their submission
+            std::size_t retrievedBytes = 0;
+            const auto deadline = std::chrono::steady_clock::now() + asyncResultTimeout;
+            while (completed < submitted) {
+                auto ret = baseDriver.getDeviceHandler(0).retrieveResults(outputKernelName, true);
+                if (ret.empty()) {
+                    if (std::chrono::steady_clock::now() > deadline) {
+                        FinnUtils::logAndError<std::runtime_error>("No results of the asynchronous soak test arrived within " + std::to_string(asyncResultTimeout.count()) + "s!");
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                retrievedBytes += ret.size();
+                completed += ret.size() / outputSampleBytes;
+                Finn::DoNotOptimize(ret);
+            }
+            inferTimer.stop();
+            FinnUtils::LiveStats::recordInference(packed.size(), retrievedBytes, batchSize);
+            return batchSize;
+        };
+        return monitor.run(step, options.duration, options.interval, reason);
+    }
+}
+
+/**
+ * @brief Run a soak test. Inference is run for the given duration while throughput, latency and memory usage are sampled periodically.
+ * Fails if the throughput drifts or the memory usage grows beyond the thresholds.
+ *
+ * @tparam SynchronousInference
+ * @param baseDriver
+ * @param logger
+ * @param options
+ */
+template<bool SynchronousInference>
+void runSoakTest(Finn::Driver<SynchronousInference>& baseDriver, logger_type& logger, const SoakOptions& options) {
+    size_t elementcount = FinnUtils::shapeToElements((std::static_pointer_cast<Finn::ExtendedBufferDescriptor>(baseDriver.getConfig().deviceWrappers[0].idmas[0]))->normalShape);
+    uint batchSize = baseDriver.getBatchSize();
+    FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Soak test: " << (SynchronousInference ? "synchronous" : "asynchronous") << " inference for " << options.duration.count() << "s, sampling every "
+                                     << options.interval.count() << "s";
+
+    std::string reason;
+    bool passed = false;
+    constexpr bool isInteger = InputFinnType().isInteger();
+    if constexpr (isInteger) {
+        using dtype = Finn::UnpackingAutoRetType::IntegralType<InputFinnType>;
+        passed = runSoakTestImpl<dtype>(baseDriver, elementcount, batchSize, options, reason);
+    } else {
+        passed = runSoakTestImpl<float>(baseDriver, elementcount, batchSize, options, reason);
+    }
+
+    if (!passed) {
+        FinnUtils::logAndError<std::runtime_error>("Soak test failed: " + reason);
+    }
+    FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Soak test passed";
+}
+
+/**
+ * @brief Attach a sampling verifier with the known-answer identity reference to the driver, if requested by the user.
+ * Only meaningful for identity (loopback) bitstreams, whose packed output equals their packed input.
+ *
+ * @tparam SynchronousInference
+ * @param baseDriver
+ * @param varMap Parsed command line options
+ */
+template<bool SynchronousInference>
+void attachVerifier(Finn::Driver<SynchronousInference>& baseDriver, const finnBoost::program_options::variables_map& varMap) {
+    const auto sampleEvery = varMap["verify_every"].as<unsigned int>();
+    if (sampleEvery == 0) {
+        return;
+    }
+    baseDriver.setVerifier(std::make_shared<Finn::SamplingVerifier>(Finn::SamplingVerifier::identityReference(), Finn::VerifierOptions{.sampleEvery = sampleEvery, .cpuBudget = varMap["verify_cpu_budget"].as<double>()}));
+}
+
+/**
+ * @brief Tune the codecs of the driver for this host, if requested by the user. Choices are cached in the profile file and reused on later starts.
+ *
+ * @tparam SynchronousInference
+ * @param baseDriver
+ * @param varMap Parsed command line options
+ */
+template<bool SynchronousInference>
+void autotuneCodecs(Finn::Driver<SynchronousInference>& baseDriver, const finnBoost::program_options::variables_map& varMap) {
+    if (!varMap["autotune"].as<bool>()) {
+        return;
     }
+    Finn::CodecAutotuner autotuner(varMap["autotune_profile"].as<std::string>(), std::chrono::milliseconds(varMap["autotune_budget"].as<unsigned int>()));
+    baseDriver.autotuneCodecs(autotuner);
 }
 
 template<typename T>
@@ -391,13 +580,26 @@ void runWithInputFile(Finn::Driver<true>& baseDriver, logger_type& logger, const
  * @param mode User input string for selected mode
  */
 void validateDriverMode(const std::string& mode) {
-    if (mode != "execute" && mode != "throughput") {
+    if (mode != "execute" && mode != "throughput" && mode != "soak") {
         throw finnBoost::program_options::error_with_option_name("'" + mode + "' is not a valid driver mode!", "exec_mode");
     }
 
     FINN_LOG(Logger::getLogger(), loglevel::info) << finnMainLogPrefix() << "Driver Mode: " << mode;
 }
 
+/**
+ * @brief Validates the user input for the workload of the throughput test
+ *
+ * @param workload User input string for the selected workload
+ */
+void validateWorkload(const std::string& workload) {
+    try {
+        Finn::workloadFromString(workload);
+    } catch (const std::invalid_argument&) {
+        throw finnBoost::program_options::error_with_option_name("'" + workload + "' is not a valid workload!", "workload");
+    }
+}
+
 /**
  * @brief Validates the user input for the batch size
  *
@@ -409,6 +611,28 @@ void validateBatchSize(int batch) {
     }
 }
 
+/**
+ * @brief Validates the user input for the CPU budget of the sampling verifier
+ *
+ * @param budget User input fraction of one core
+ */
+void validateVerifierBudget(double budget) {
+    if (!(budget > 0.0 && budget <= 1.0)) {
+        throw finnBoost::program_options::error_with_option_name("CPU budget must be in (0, 1], but is '" + std::to_string(budget) + "'", "verify_cpu_budget");
+    }
+}
+
+/**
+ * @brief Validates the user input for the log level
+ *
+ * @param level User input name of the log level
+ */
+void validateLogLevel(const std::string& level) {
+    if (!Finn::ControlServer::parseLogLevel(level)) {
+        throw finnBoost::program_options::error_with_option_name("'" + level + "' is not a valid log level!", "log_level");
+    }
+}
+
 /**
  * @brief Validates the user input for the config path. Also checks if file exists
  *
@@ -457,11 +681,24 @@ int main(int argc, char* argv[]) {
         po::options_description desc{"Options"};
         //clang-format off
         desc.add_options()("help,h", "Display help")("exec_mode,e", po::value<std::string>()->default_value("throughput")->notifier(&validateDriverMode),
-                                                     R"(Please select functional verification ("execute") or throughput test ("throughput")")("configpath,c", po::value<std::string>()->required()->notifier(&validateConfigPath),
+                                                     R"(Please select functional verification ("execute"), throughput test ("throughput") or soak test ("soak")")("configpath,c", po::value<std::string>()->required()->notifier(&validateConfigPath),
                                                                                                                                               "Required: Path to the config.json file emitted by the FINN compiler")(
             "input,i", po::value<std::vector<std::string>>()->multitoken()->composing()->notifier(&validateInputPath), "Path to one or more input files (npy format). Only required if mode is set to \"file\"")(
             "output,o", po::value<std::vector<std::string>>()->multitoken()->composing(), "Path to one or more output files (npy format). Only required if mode is set to \"file\"")(
-            "batchsize,b", po::value<int>()->default_value(1)->notifier(&validateBatchSize), "Number of samples for inference");
+            "batchsize,b", po::value<int>()->default_value(1)->notifier(&validateBatchSize), "Number of samples for inference")("duration", po::value<unsigned int>()->default_value(600), "Duration of the soak test in seconds")(
+            "sample_interval", po::value<unsigned int>()->default_value(10), "Sampling interval of the soak test in seconds")("max_throughput_drift", po::value<double>()->default_value(0.1),
+                                                                                                                              "Maximum relative throughput drift allowed by the soak test")(
+            "max_memory_growth", po::value<unsigned int>()->default_value(64), "Maximum growth of resident set size and heap allowed by the soak test in MiB")("async_inference", po::bool_switch(),
+                                                                                                                                                                  "Run the soak test with asynchronous inference")(
+            "workload", po::value<std::string>()->default_value("uniform")->notifier(&validateWorkload),
+            R"(Input stream of the throughput test: uniform random ("uniform"), duplicate heavy ("zipf"), small frame to frame deltas ("correlated") or bursty arrivals ("bursty"))")(
+            "verify_every", po::value<unsigned int>()->default_value(0), "Verify one in N inferences of the throughput and synchronous soak test against the identity reference (0 disables verification)")(
+            "verify_cpu_budget", po::value<double>()->default_value(0.05)->notifier(&validateVerifierBudget), "Fraction of one core the background verification may use")(
+            "stats_page", po::bool_switch(), "Publish live statistics to /dev/shm for monitoring with finn-top")("autotune", po::bool_switch(), "Tune the packing and unpacking of inputs and outputs for this host at startup")(
+            "autotune_profile", po::value<std::string>()->default_value("finn-codec-profile.json"), "Profile file that caches the autotuning results per CPU model")(
+            "autotune_budget", po::value<unsigned int>()->default_value(250), "Time budget of the autotuning per codec operation in milliseconds")(
+            "control_socket", po::bool_switch(), "Accept changes of runtime tunables (batch size, codec sharding, wait policy, log level, stats) of the soak test on /tmp/finn-control.<pid>.sock")(
+            "log_level", po::value<std::string>()->default_value("trace")->notifier(&validateLogLevel), "Minimum severity of logged messages (trace, debug, info, warning, error, fatal)");
         //clang-format on
         po::variables_map varMap;
         po::store(po::parse_command_line(argc, argv, desc), varMap);
@@ -474,9 +711,24 @@ int main(int argc, char* argv[]) {
         }
 
         po::notify(varMap);
+        // Installed through the tunables, so that the control socket reports the level in effect
+        FinnUtils::Tunables::setLogLevel(*Finn::ControlServer::parseLogLevel(varMap["log_level"].as<std::string>()));
 
         FINN_LOG(logger, loglevel::info) << finnMainLogPrefix() << "Parsed command line params";
 
+        std::unique_ptr<Finn::StatsPublisher> statsPublisher;
+        if (varMap["stats_page"].as<bool>()) {
+            statsPublisher = std::make_unique<Finn::StatsPublisher>(varMap["exec_mode"].as<std::string>() + ":" + std::filesystem::path(varMap["configpath"].as<std::string>()).filename().string());
+        }
+        std::unique_ptr<Finn::ControlServer> controlServer;
+        if (varMap["control_socket"].as<bool>()) {
+            // Only the soak test applies the driver tunables between two batches
+            if (varMap["exec_mode"].as<std::string>() != "soak") {
+                FinnUtils::logAndError<std::invalid_argument>("The control socket (--control_socket) is only supported by the soak test!");
+            }
+            controlServer = std::make_unique<Finn::ControlServer>();
+        }
+
         // Switch on modes
         if (varMap["exec_mode"].as<std::string>() == "execute") {
             if (varMap.count("input") == 0) {
@@ -489,10 +741,31 @@ int main(int argc, char* argv[]) {
                 FinnUtils::logAndError<std::invalid_argument>("Same amount of input and output files required!");
             }
             auto driver = createDriverFromConfig<true>(varMap["configpath"].as<std::string>(), static_cast<uint>(varMap["batchsize"].as<int>()));
+            autotuneCodecs(driver, varMap);
             runWithInputFile(driver, logger, varMap["input"].as<std::vector<std::string>>(), varMap["output"].as<std::vector<std::string>>());
         } else if (varMap["exec_mode"].as<std::string>() == "throughput") {
             auto driver = createDriverFromConfig<true>(varMap["configpath"].as<std::string>(), static_cast<uint>(varMap["batchsize"].as<int>()));
-            runThroughputTest(driver, logger);
+            autotuneCodecs(driver, varMap);
+            attachVerifier(driver, varMap);
+            runThroughputTest(driver, logger, Finn::WorkloadOptions{.type = Finn::workloadFromString(varMap["workload"].as<std::string>())});
+        } else if (varMap["exec_mode"].as<std::string>() == "soak") {
+            const std::size_t maxGrowth = std::size_t{varMap["max_memory_growth"].as<unsigned int>()} * 1024 * 1024;
+            const SoakOptions options{std::chrono::seconds(varMap["duration"].as<unsigned int>()), std::chrono::seconds(std::max(1U, varMap["sample_interval"].as<unsigned int>())),
+                                      Finn::SoakThresholds{varMap["max_throughput_drift"].as<double>(), maxGrowth, maxGrowth, 1}};
+            if (varMap["async_inference"].as<bool>()) {
+                // Asynchronous inference bypasses BaseDriver::infer, where the verifier takes its samples
+                if (varMap["verify_every"].as<unsigned int>() != 0) {
+                    FinnUtils::logAndError<std::invalid_argument>("Sampling verification (--verify_every) is not supported for the asynchronous soak test!");
+                }
+                auto driver = createDriverFromConfig<false>(varMap["configpath"].as<std::string>(), static_cast<uint>(varMap["batchsize"].as<int>()));
+                autotuneCodecs(driver, varMap);
+                runSoakTest(driver, logger, options);
+            } else {
+                auto driver = createDriverFromConfig<true>(varMap["configpath"].as<std::string>(), static_cast<uint>(varMap["batchsize"].as<int>()));
+                autotuneCodecs(driver, varMap);
+                attachVerifier(driver, varMap);
+                runSoakTest(driver, logger, options);
+            }
         } else {
             FinnUtils::logAndError<std::invalid_argument>("Unknown driver mode: " + varMap["exec_mode"].as<std::string>());
         }
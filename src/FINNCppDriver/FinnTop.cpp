@@ -0,0 +1,186 @@
+/**
+ * @file FinnTop.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief finn-top: live monitor for all driver processes that publish a stats page (--stats_page)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/LiveStats.h>
+
+#include <FINNCppDriver/utils/StatsPage.hpp>
+#include <algorithm>
+#include <array>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+    using FinnUtils::LiveStats;
+
+    /**
+     * @brief Names of the latency slots, indexed by DRIVER_STAGE
+     *
+     */
+    constexpr std::array<const char*, LiveStats::latencySlots> stageNames = {"infer", "pack", "store", "execute", "retrieve", "unpack"};
+
+    /**
+     * @brief Format a latency in ns with a fitting unit
+     *
+     * @param ns
+     * @return std::string
+     */
+    std::string formatLatency(uint64_t ns) {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(1);
+        if (ns == 0) {
+            stream << "-";
+        } else if (ns < 1'000) {
+            stream << ns << "ns";
+        } else if (ns < 1'000'000) {
+            stream << static_cast<double>(ns) / 1e3 << "us";
+        } else {
+            stream << static_cast<double>(ns) / 1e6 << "ms";
+        }
+        return stream.str();
+    }
+
+    /**
+     * @brief Print the live view of one driver process
+     *
+     * @param current Most recent read of the page
+     * @param previous Read of the page one interval earlier. Without one, totals since the start of the driver are shown.
+     */
+    void printDriver(const Finn::StatsPageData& current, const std::optional<Finn::StatsPageData>& previous) {
+        const auto& now = current.stats;
+        const LiveStats::Snapshot before = previous ? previous->stats : LiveStats::Snapshot{};
+        const double seconds = previous ? static_cast<double>(current.publishTimeNs - previous->publishTimeNs) / 1e9 : 0.0;
+        auto rate = [seconds](uint64_t later, uint64_t earlier) { return (seconds > 0) ? static_cast<double>(later - earlier) / seconds : 0.0; };
+
+        std::cout << "PID " << current.pid << "  " << current.name << "\n";
+        std::cout << std::fixed << std::setprecision(1);
+        if (seconds > 0) {
+            std::cout << "  inferences/s " << std::setw(10) << rate(now.inferences, before.inferences) << "   samples/s " << std::setw(10) << rate(now.batchElements, before.batchElements) << "   in MB/s " << std::setw(8)
+                      << rate(now.bytesIn, before.bytesIn) / 1e6 << "   out MB/s " << std::setw(8) << rate(now.bytesOut, before.bytesOut) / 1e6 << "   polls/s " << std::setw(10) << rate(now.waitPolls, before.waitPolls) << "\n";
+        } else {
+            std::cout << "  inferences " << now.inferences << "   samples " << now.batchElements << "   in MB " << static_cast<double>(now.bytesIn) / 1e6 << "   out MB " << static_cast<double>(now.bytesOut) / 1e6 << "   polls "
+                      << now.waitPolls << "\n";
+        }
+        if (now.ringCapacity != 0) {
+            std::cout << "  ring " << now.ringUsed << "/" << now.ringCapacity << " (" << 100.0 * static_cast<double>(now.ringUsed) / static_cast<double>(now.ringCapacity) << "%)\n";
+        }
+        if (now.hedges != 0) {
+            std::cout << "  hedges " << now.hedges << " (won " << now.hedgeWins << ")\n";
+        }
+        if (now.tunablesGeneration != 0) {
+            std::cout << "  tunables gen " << now.tunablesGeneration << "\n";
+        }
+
+        std::cout << "  " << std::left << std::setw(10) << "stage" << std::right << std::setw(10) << "p50" << std::setw(10) << "p99" << "\n";
+        for (std::size_t slot = 0; slot < LiveStats::latencySlots; ++slot) {
+            // Percentiles of the last interval only
+            LiveStats::Histogram histogram = now.latency[slot];
+            for (std::size_t b = 0; b < LiveStats::histogramBuckets; ++b) {
+                histogram[b] -= before.latency[slot][b];
+            }
+            const auto p50 = LiveStats::percentile(histogram, 0.5);
+            if (p50 == 0) {
+                continue;
+            }
+            std::cout << "  " << std::left << std::setw(10) << stageNames[slot] << std::right << std::setw(10) << formatLatency(p50) << std::setw(10) << formatLatency(LiveStats::percentile(histogram, 0.99)) << "\n";
+        }
+
+        if (seconds > 0) {
+            for (std::size_t device = 0; device < LiveStats::maxDevices; ++device) {
+                if (now.deviceBusyNs[device] == 0) {
+                    continue;
+                }
+                std::cout << "  device " << device << " busy " << std::setw(5) << 100.0 * rate(now.deviceBusyNs[device], before.deviceBusyNs[device]) / 1e9 << "%\n";
+            }
+        }
+        std::cout << "\n";
+    }
+
+    /**
+     * @brief Read the pages of all running driver processes
+     *
+     * @return std::map<std::string, Finn::StatsPageData> Page name to page content
+     */
+    std::map<std::string, Finn::StatsPageData> readAll() {
+        std::map<std::string, Finn::StatsPageData> ret;
+        for (const auto& pageName : Finn::StatsPages::list()) {
+            try {
+                const Finn::StatsPageReader reader(pageName);
+                if (auto data = reader.read(); data && Finn::StatsPages::isAlive(data->pid)) {
+                    ret.emplace(pageName, *data);
+                }
+            } catch (const std::runtime_error&) {
+                // The driver exited while the page was opened
+            }
+        }
+        return ret;
+    }
+}  // namespace
+
+namespace po = finnBoost::program_options;
+
+/**
+ * @brief Main entrypoint of finn-top
+ *
+ * @param argc Number of command line parameters
+ * @param argv Array of command line parameters
+ * @return int Exit status code
+ */
+int main(int argc, char* argv[]) {
+    try {
+        po::options_description desc{"Options"};
+        desc.add_options()("help,h", "Display help")("interval,n", po::value<unsigned int>()->default_value(1000), "Refresh interval in milliseconds")("once", po::bool_switch(),
+                                                                                                                                                   "Print the rates of one interval and exit");
+        po::variables_map varMap;
+        po::store(po::parse_command_line(argc, argv, desc), varMap);
+        if (varMap.count("help") != 0) {
+            std::cout << desc << "\n";
+            return 1;
+        }
+        po::notify(varMap);
+        const auto interval = std::chrono::milliseconds(std::max(1U, varMap["interval"].as<unsigned int>()));
+        const bool once = varMap["once"].as<bool>();
+
+        auto previous = readAll();
+        while (true) {
+            std::this_thread::sleep_for(interval);
+            auto current = readAll();
+            if (!once) {
+                std::cout << "\033[H\033[2J";
+            }
+            std::cout << "finn-top - " << current.size() << " driver process(es)\n\n";
+            for (const auto& [pageName, data] : current) {
+                const auto match = previous.find(pageName);
+                printDriver(data, (match != previous.end() && match->second.pid == data.pid) ? std::optional(match->second) : std::nullopt);
+            }
+            std::cout << std::flush;
+            if (once) {
+                return 0;
+            }
+            previous = std::move(current);
+        }
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -13,14 +13,21 @@
 #ifndef BASEDRIVER_HPP
 #define BASEDRIVER_HPP
 
+#include <FINNCppDriver/utils/AllocationCounter.h>
 #include <FINNCppDriver/utils/ConfigurationStructs.h>
 #include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/LiveStats.h>
 #include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Tracepoints.h>
+#include <FINNCppDriver/utils/Tunables.h>
 #include <FINNCppDriver/utils/Types.h>
 
+#include <FINNCppDriver/utils/CodecAutotuner.hpp>
 #include <FINNCppDriver/utils/DataPacking.hpp>
 #include <FINNCppDriver/utils/DynamicMdSpan.hpp>
 #include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <FINNCppDriver/utils/PackedView.hpp>
+#include <FINNCppDriver/utils/SamplingVerifier.hpp>
 #include <FINNCppDriver/utils/join.hpp>
 #include <bitset>
 #include <cinttypes>  // for uint8_t
@@ -57,6 +64,14 @@ namespace Finn {
         std::string defaultOutputKernelName;
         uint batchElements = 1;
         bool forceAchieval = false;
+        std::shared_ptr<SamplingVerifier> verifier;
+        shape_t inputFoldedShape;
+        shape_t outputPackedShape;
+        shape_t outputFoldedShape;
+        std::size_t inferenceSequence = 0;
+        CodecTuning packTuning;
+        CodecTuning unpackTuning;
+        uint64_t appliedTunables = 0;
 
         /**
          * @brief A logger prefix to determine the source of a log write
@@ -65,6 +80,25 @@ namespace Finn {
          */
         static std::string loggerPrefix() { return "[BaseDriver] "; }
 
+        /**
+         * @brief Pass the input and output of a sampled inference to the verifier
+         *
+         * @tparam IteratorType
+         * @param first Iterator to first element in input sequence
+         * @param last Iterator to last element in input sequence
+         * @param result Packed output of the inference
+         */
+        template<typename IteratorType>
+        void captureSample(IteratorType first, IteratorType last, const Finn::vector<uint8_t>& result) {
+            const std::span<const uint8_t> output(result.data(), result.size());
+            if constexpr (std::contiguous_iterator<IteratorType> && std::is_same_v<std::iter_value_t<IteratorType>, uint8_t>) {
+                verifier->capture(std::span<const uint8_t>(std::to_address(first), static_cast<std::size_t>(std::distance(first, last))), output);
+            } else {
+                const Finn::vector<uint8_t> input(first, last);
+                verifier->capture(std::span<const uint8_t>(input.data(), input.size()), output);
+            }
+        }
+
          public:
         /**
          * @brief Defines the automatic return type for external use
@@ -84,6 +118,11 @@ namespace Finn {
             defaultOutputDeviceIndex = configuration.deviceWrappers[0].xrtDeviceIndex;
             defaultOutputKernelName = configuration.deviceWrappers[0].odmas[0]->kernelName;
             batchElements = batchSize;
+            // Shapes used for packing are cached per driver, so that several drivers with the same datatypes can coexist in one process
+            inputFoldedShape = static_cast<Finn::ExtendedBufferDescriptor*>(configuration.deviceWrappers[0].idmas[0].get())->foldedShape;
+            outputPackedShape = configuration.deviceWrappers[0].odmas[0]->packedShape;
+            outputFoldedShape = static_cast<Finn::ExtendedBufferDescriptor*>(configuration.deviceWrappers[0].odmas[0].get())->foldedShape;
+            inputFoldedShape[0] = outputPackedShape[0] = outputFoldedShape[0] = batchElements;
 #ifdef UNITTEST
             logDriver();
 #endif
@@ -202,6 +241,7 @@ namespace Finn {
          */
         void setBatchSize(uint elements) {
             batchElements = elements;
+            inputFoldedShape[0] = outputPackedShape[0] = outputFoldedShape[0] = batchElements;
             accelerator.setBatchSize(batchElements);
         }
 
@@ -253,6 +293,91 @@ namespace Finn {
          */
         size_t size(SIZE_SPECIFIER ss, uint deviceIndex, const std::string& bufferName) { return accelerator.size(ss, deviceIndex, bufferName); }
 
+        /**
+         * @brief Attach a sampling verifier that checks a sample of the raw inferences against a reference. Pass nullptr to disable verification.
+         *
+         * @param pVerifier
+         */
+        void setVerifier(std::shared_ptr<SamplingVerifier> pVerifier) { verifier = std::move(pVerifier); }
+
+        /**
+         * @brief Get the attached sampling verifier
+         *
+         * @return std::shared_ptr<SamplingVerifier> nullptr if no verifier is attached
+         */
+        std::shared_ptr<SamplingVerifier> getVerifier() const { return verifier; }
+
+        /**
+         * @brief Set the sharding parameters used for packing inputs and unpacking outputs
+         *
+         * @param pPackTuning
+         * @param pUnpackTuning
+         */
+        void setCodecTuning(const CodecTuning& pPackTuning, const CodecTuning& pUnpackTuning) {
+            packTuning = pPackTuning;
+            unpackTuning = pUnpackTuning;
+        }
+
+        /**
+         * @brief Get the sharding parameters used for packing inputs
+         *
+         * @return const CodecTuning&
+         */
+        const CodecTuning& getPackTuning() const { return packTuning; }
+
+        /**
+         * @brief Get the sharding parameters used for unpacking outputs
+         *
+         * @return const CodecTuning&
+         */
+        const CodecTuning& getUnpackTuning() const { return unpackTuning; }
+
+        /**
+         * @brief Tune the codecs for the folded shapes of the current batch size on this host, or load the tuning from the profile of the autotuner
+         *
+         * @param autotuner
+         */
+        void autotuneCodecs(CodecAutotuner& autotuner) {
+            const std::size_t inputRows = FinnUtils::shapeToElements(inputFoldedShape) / inputFoldedShape.back();
+            const std::size_t outputRows = FinnUtils::shapeToElements(outputFoldedShape) / outputFoldedShape.back();
+            setCodecTuning(autotuner.tunePack<F>(inputRows, inputFoldedShape.back()), autotuner.tuneUnpack<S>(outputRows, outputFoldedShape.back()));
+        }
+
+        /**
+         * @brief Apply runtime tunables (see FinnUtils::Tunables) that changed since the last call. Must be called between two batches, never concurrently to an
+         * inference. The tunables are process wide, every driver of the process that calls this function picks them up. Asynchronous drivers ignore batch size
+         * changes, because their buffers would have to be recreated while the buffer workers run.
+         *
+         * @return true The batch size changed, inputs have to be sized for the new batch size
+         * @return false The batch size is unchanged
+         */
+        bool applyTunables() {
+            const uint64_t generation = FinnUtils::Tunables::generation();
+            if (generation == appliedTunables) {
+                return false;
+            }
+            appliedTunables = generation;
+            bool batchSizeChanged = false;
+            if (const auto requested = FinnUtils::Tunables::batchSize(); requested != 0 && requested != batchElements) {
+                if constexpr (SynchronousInference) {
+                    setBatchSize(requested);
+                    batchSizeChanged = true;
+                } else {
+                    FINN_LOG(logger, loglevel::warning) << loggerPrefix() << "Ignoring the batch size " << requested << ", the buffers of an asynchronous driver can not be recreated while they are running";
+                }
+            }
+            if (const auto threads = FinnUtils::Tunables::codecThreads(); threads != 0) {
+                packTuning.maxThreads = unpackTuning.maxThreads = threads;
+            }
+            if (const auto elements = FinnUtils::Tunables::codecMinElements(); elements != 0) {
+                packTuning.minElementsPerThread = unpackTuning.minElementsPerThread = elements;
+            }
+            FinnUtils::LiveStats::recordTunablesApplied(generation);
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Applied tunables generation " << generation << ": batch size " << batchElements << ", codec threads " << packTuning.maxThreads
+                                             << ", codec min elements " << packTuning.minElementsPerThread;
+            return batchSizeChanged;
+        }
+
 
         /**
          * @brief Store input into the driver for asynchronous inference
@@ -267,7 +392,12 @@ namespace Finn {
         template<typename IteratorType, typename = std::enable_if<!SynchronousInference>>
         void input(IteratorType first, IteratorType last, uint inputDeviceIndex, const std::string& inputBufferKernelName, uint batchSize) {
             FINN_LOG_DEBUG(logger, loglevel::info) << loggerPrefix() << "Store data for asynchronous inference.";
-            auto packed = Finn::pack<F>(first, last);
+            auto packed = [&]() {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::PACK);
+                const FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::PACK);
+                return Finn::pack<F>(first, last);
+            }();
+            const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::STORE);
             auto storeFunc = accelerator.storeFactory(inputDeviceIndex, inputBufferKernelName);
 
             if (std::abs(std::distance(packed.begin(), packed.end())) != size(SIZE_SPECIFIER::FEATUREMAP_SIZE, inputDeviceIndex, inputBufferKernelName) * batchSize) {
@@ -276,7 +406,11 @@ namespace Finn {
                                                            std::to_string(size(SIZE_SPECIFIER::FEATUREMAP_SIZE, inputDeviceIndex, inputBufferKernelName) * batchSize) + ")");
             }
 
+            FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::STORE);
             storeFunc(packed.begin(), packed.end());
+            timer.stop();
+            // The device consumes asynchronous inputs independently of the results, so inferences are counted when they are submitted
+            FinnUtils::LiveStats::recordInference(packed.size(), 0, batchSize);
         }
 
         /**
@@ -304,8 +438,15 @@ namespace Finn {
         template<typename V = Finn::UnpackingAutoRetType::AutoRetType<S>, typename = std::enable_if<!SynchronousInference>>
         [[nodiscard]] Finn::vector<V> getResults(uint outputDeviceIndex, const std::string& outputBufferKernelName, bool forceArchival) {
             // TODO(linusjun): maybe this method should block until data is available?
-            auto result = accelerator.getOutputData(outputDeviceIndex, outputBufferKernelName, forceArchival);
-            return unpack<S, V>(result);
+            auto result = [&]() {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::RETRIEVE);
+                const FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::RETRIEVE);
+                return accelerator.getOutputData(outputDeviceIndex, outputBufferKernelName, forceArchival);
+            }();
+            FinnUtils::LiveStats::recordOutput(result.size());
+            const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::UNPACK);
+            const FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::UNPACK);
+            return unpack<S, false, V>(result);
         }
 
         /**
@@ -317,9 +458,7 @@ namespace Finn {
          */
         template<typename V = Finn::UnpackingAutoRetType::AutoRetType<S>, typename = std::enable_if<!SynchronousInference>>
         [[nodiscard]] Finn::vector<V> getResults() {
-            // TODO(linusjun): maybe this method should block until data is available?
-            auto result = accelerator.getOutputData(defaultOutputDeviceIndex, defaultOutputKernelName, forceAchieval);
-            return unpack<S, V>(result);
+            return getResults<V>(defaultOutputDeviceIndex, defaultOutputKernelName, forceAchieval);
         }
 
         /**
@@ -340,21 +479,15 @@ namespace Finn {
         template<typename IteratorType, typename V = Finn::UnpackingAutoRetType::AutoRetType<S>, typename = std::enable_if<SynchronousInference>>
         [[nodiscard]] Finn::vector<V> inferSynchronous(IteratorType first, IteratorType last, uint inputDeviceIndex, const std::string& inputBufferKernelName, uint outputDeviceIndex, const std::string& outputBufferKernelName,
                                                        bool forceArchival) {
-            using IterValueType = typename std::iterator_traits<IteratorType>::value_type;
-            static auto foldedShape = static_cast<Finn::ExtendedBufferDescriptor*>(configuration.deviceWrappers[inputDeviceIndex].idmas[0].get())->foldedShape;
-            foldedShape[0] = batchElements;
-            const Finn::DynamicMdSpan reshapedInput(first, last, foldedShape);
-
-            auto packed = Finn::packMultiDimensionalInputs<F, IteratorType>(first, last, reshapedInput, foldedShape.back());
-
-            auto result = infer(packed.begin(), packed.end(), inputDeviceIndex, inputBufferKernelName, outputDeviceIndex, outputBufferKernelName, batchElements, forceArchival);
+            auto result = packAndInfer(first, last, inputDeviceIndex, inputBufferKernelName, outputDeviceIndex, outputBufferKernelName, forceArchival);
 
-            static auto packedOutput = configuration.deviceWrappers[inputDeviceIndex].odmas[0]->packedShape;
-            packedOutput[0] = batchElements;
-            static auto foldedOutput = static_cast<Finn::ExtendedBufferDescriptor*>(configuration.deviceWrappers[inputDeviceIndex].odmas[0].get())->foldedShape;
-            foldedOutput[0] = batchElements;
-            const Finn::DynamicMdSpan reshapedOutput(result.begin(), result.end(), packedOutput);
-            auto unpacked = Finn::unpackMultiDimensionalOutputs<S, Finn::vector<uint8_t>::iterator, false, V>(result.begin(), result.end(), reshapedOutput, foldedOutput);
+            const Finn::DynamicMdSpan reshapedOutput(result.begin(), result.end(), outputPackedShape);
+            FINN_TRACE(unpack_start, outputDeviceIndex, outputBufferKernelName.c_str(), result.size(), batchElements, inferenceSequence);
+            const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::UNPACK);
+            FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::UNPACK);
+            auto unpacked = Finn::unpackMultiDimensionalOutputs<S, Finn::vector<uint8_t>::iterator, false, V>(result.begin(), result.end(), reshapedOutput, outputFoldedShape, unpackTuning);
+            timer.stop();
+            FINN_TRACE(unpack_done, outputDeviceIndex, outputBufferKernelName.c_str(), result.size(), batchElements, inferenceSequence);
 
             return unpacked;
         }
@@ -407,8 +540,87 @@ namespace Finn {
             return inferSynchronous(data, defaultInputDeviceIndex, defaultInputKernelName, defaultOutputDeviceIndex, defaultOutputKernelName, batchElements, forceAchieval);
         }
 
+        /**
+         * @brief Implements the synchronous inference operation, but keeps the outputs in their packed form instead of expanding every element into a full byte.
+         * Only available for integer output datatypes with up to 8 bits (e.g. DatatypeBinary, DatatypeBipolar, 4 bit types).
+         *
+         * @tparam IteratorType
+         * @tparam typename
+         * @param first Iterator to first element of input
+         * @param last  Iterator to end of input
+         * @param inputDeviceIndex index of input FPGA
+         * @param inputBufferKernelName name of input kernel
+         * @param outputDeviceIndex index of output FPGA
+         * @param outputBufferKernelName name of output kernel
+         * @param forceArchival
+         * @return PackedVector<S>
+         */
+        template<typename IteratorType, typename = std::enable_if<SynchronousInference>>
+        [[nodiscard]] PackedVector<S> inferSynchronousPacked(IteratorType first, IteratorType last, uint inputDeviceIndex, const std::string& inputBufferKernelName, uint outputDeviceIndex, const std::string& outputBufferKernelName,
+                                                             bool forceArchival)
+            requires IsCompactDatatype<S>
+        {
+            auto result = packAndInfer(first, last, inputDeviceIndex, inputBufferKernelName, outputDeviceIndex, outputBufferKernelName, forceArchival);
+            return PackedVector<S>(std::move(result), outputFoldedShape.back());
+        }
+
+        /**
+         * @brief Implements the synchronous inference operation, but keeps the outputs in their packed form
+         *
+         * @tparam IteratorType
+         * @tparam typename
+         * @param first
+         * @param last
+         * @return PackedVector<S>
+         */
+        template<typename IteratorType, typename = std::enable_if<SynchronousInference>>
+        [[nodiscard]] PackedVector<S> inferSynchronousPacked(IteratorType first, IteratorType last)
+            requires IsCompactDatatype<S>
+        {
+            return inferSynchronousPacked(first, last, defaultInputDeviceIndex, defaultInputKernelName, defaultOutputDeviceIndex, defaultOutputKernelName, forceAchieval);
+        }
+
 
          protected:
+        /**
+         * @brief Packs the unpacked input data and runs the inference. Returns the packed output data.
+         *
+         * @tparam IteratorType
+         * @param first Iterator to first element of input
+         * @param last  Iterator to end of input
+         * @param inputDeviceIndex
+         * @param inputBufferKernelName
+         * @param outputDeviceIndex
+         * @param outputBufferKernelName
+         * @param forceArchival
+         * @return Finn::vector<uint8_t>
+         */
+        template<typename IteratorType>
+        [[nodiscard]] Finn::vector<uint8_t> packAndInfer(IteratorType first, IteratorType last, uint inputDeviceIndex, const std::string& inputBufferKernelName, uint outputDeviceIndex, const std::string& outputBufferKernelName,
+                                                         bool forceArchival) {
+            const Finn::DynamicMdSpan reshapedInput(first, last, inputFoldedShape);
+            auto& inputBuffer = getDeviceHandler(inputDeviceIndex).getInputBuffer(inputBufferKernelName);
+            const std::span<uint8_t> inputMap = inputBuffer->getMapView();
+
+            // Packing belongs to the inference that is started next. The input is packed directly into the map of the input buffer, which replaces the store.
+            FINN_TRACE(pack_start, inputDeviceIndex, inputBufferKernelName.c_str(), static_cast<std::size_t>(std::distance(first, last)), batchElements, inferenceSequence + 1);
+            const std::size_t packedBytes = [&]() {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::PACK);
+                const FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::PACK);
+                return Finn::packMultiDimensionalInputs<F, IteratorType>(first, last, reshapedInput, inputFoldedShape.back(), inputMap, inputBuffer->getMapType(), packTuning);
+            }();
+            FINN_TRACE(pack_done, inputDeviceIndex, inputBufferKernelName.c_str(), static_cast<std::size_t>(std::distance(first, last)), batchElements, inferenceSequence + 1);
+
+            if (packedBytes != inputMap.size()) {
+                FinnUtils::logAndError<std::runtime_error>(loggerPrefix() + " Input length (" + std::to_string(packedBytes) + ") does not match up with batches*inputsize_per_batch (" + std::to_string(inputMap.size()) + ")");
+            }
+            [[maybe_unused]] const std::size_t sequence = ++inferenceSequence;
+            FINN_TRACE(infer_start, inputDeviceIndex, inputBufferKernelName.c_str(), packedBytes, batchElements, sequence);
+            FinnUtils::LiveStats::StageTimer inferTimer(DRIVER_STAGE::NONE);
+            FINN_TRACE(store_done, inputDeviceIndex, inputBufferKernelName.c_str(), packedBytes, batchElements, sequence);
+            return runStored(inputMap.begin(), inputMap.end(), inputDeviceIndex, inputBufferKernelName, outputDeviceIndex, outputBufferKernelName, batchElements, forceArchival, inferTimer, sequence);
+        }
+
         /**
          *
          * @brief Do an inference with the given data. This assumes already flattened data in uint8_t's. Specify inputs and outputs.
@@ -440,19 +652,72 @@ namespace Finn {
             auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
             std::cout << "preamble infer took " << ns << " ns\n";
 
-            bool stored = storeFunc(first, last);
+            const std::size_t sequence = ++inferenceSequence;
+            [[maybe_unused]] const auto bytes = static_cast<std::size_t>(std::abs(std::distance(first, last)));
+            FINN_TRACE(infer_start, inputDeviceIndex, inputBufferKernelName.c_str(), bytes, batchSize, sequence);
+            FinnUtils::LiveStats::StageTimer inferTimer(DRIVER_STAGE::NONE);
+
+            bool stored = [&]() {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::STORE);
+                const FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::STORE);
+                return storeFunc(first, last);
+            }();
+            FINN_TRACE(store_done, inputDeviceIndex, inputBufferKernelName.c_str(), bytes, batchSize, sequence);
+            return runStored(first, last, inputDeviceIndex, inputBufferKernelName, outputDeviceIndex, outputBufferKernelName, batchSize, forceArchival, inferTimer, sequence);
+        }
 
-            accelerator.run();
+        /**
+         * @brief Run the inference of the input that is already stored in the input buffer and read back the results
+         *
+         * @tparam IteratorType
+         * @param first Iterator to first element of the stored input
+         * @param last Iterator to end of the stored input
+         * @param inputDeviceIndex
+         * @param inputBufferKernelName
+         * @param outputDeviceIndex
+         * @param outputBufferKernelName
+         * @param batchSize
+         * @param forceArchival If true, the data gets written to LTS either way, ensuring that there is data to be read!
+         * @param inferTimer Timer of the whole inference, stopped once the results are read
+         * @param sequence Sequence number of the inference
+         * @return Finn::vector<uint8_t>
+         */
+        template<typename IteratorType>
+        [[nodiscard]] Finn::vector<uint8_t> runStored(IteratorType first, IteratorType last, [[maybe_unused]] uint inputDeviceIndex, [[maybe_unused]] const std::string& inputBufferKernelName, uint outputDeviceIndex, const std::string& outputBufferKernelName, uint batchSize,
+                                                      bool forceArchival, FinnUtils::LiveStats::StageTimer& inferTimer, [[maybe_unused]] std::size_t sequence) {
+            const auto bytes = static_cast<std::size_t>(std::abs(std::distance(first, last)));
+            // The kernels run from run() until wait() returned, this is the busy time of the device
+            FinnUtils::LiveStats::StageTimer executeTimer(DRIVER_STAGE::EXECUTE, outputDeviceIndex);
+            {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::EXECUTE);
+                accelerator.run();
+            }
 
 #ifdef UNITTEST
             Finn::vector<uint8_t> data(first, last);
             FINN_LOG(logger, loglevel::info) << "Readback from device buffer confirming data was written to board successfully: " << isSyncedDataEquivalent(inputDeviceIndex, inputBufferKernelName, data);
 #endif
-            accelerator.wait();
+            {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::EXECUTE);
+                accelerator.wait();
+            }
+            executeTimer.stop();
+            FINN_TRACE(execute_done, outputDeviceIndex, outputBufferKernelName.c_str(), bytes, batchSize, sequence);
 
             FINN_LOG_DEBUG(logger, loglevel::info) << "Reading out buffers";
-            accelerator.read();
-            return accelerator.getOutputData(outputDeviceIndex, outputBufferKernelName, forceArchival);
+            Finn::vector<uint8_t> result = [&]() {
+                const FinnUtils::AllocationCounter::StageGuard stage(DRIVER_STAGE::RETRIEVE);
+                const FinnUtils::LiveStats::StageTimer timer(DRIVER_STAGE::RETRIEVE);
+                accelerator.read();
+                return accelerator.getOutputData(outputDeviceIndex, outputBufferKernelName, forceArchival);
+            }();
+            FINN_TRACE(infer_done, outputDeviceIndex, outputBufferKernelName.c_str(), result.size(), batchSize, sequence);
+            inferTimer.stop();
+            FinnUtils::LiveStats::recordInference(bytes, result.size(), batchSize);
+            if (verifier && verifier->sample()) {
+                captureSample(first, last, result);
+            }
+            return result;
         }
 
         /**
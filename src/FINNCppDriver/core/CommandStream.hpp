@@ -0,0 +1,305 @@
+/**
+ * @file CommandStream.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Ordered command streams with events for explicit control over the overlap of transfers, kernels and host code
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef COMMANDSTREAM_HPP
+#define COMMANDSTREAM_HPP
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/core/DeviceBuffer/DeviceBuffer.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Finn {
+    class CommandStream;
+
+    /**
+     * @brief Completion marker of a command enqueued on a CommandStream. Events are cheap to copy, all copies refer to the same command.
+     * A default constructed event is already complete.
+     *
+     */
+    class Event {
+         private:
+        struct State {
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool done = false;
+            std::exception_ptr error;
+        };
+        std::shared_ptr<State> state;
+
+        friend class CommandStream;
+
+        static Event create() {
+            Event event;
+            event.state = std::make_shared<State>();
+            return event;
+        }
+
+        void complete(std::exception_ptr error) const {
+            {
+                const std::lock_guard lock(state->mutex);
+                state->done = true;
+                state->error = std::move(error);
+            }
+            state->condition.notify_all();
+        }
+
+        /**
+         * @brief Wait for completion without rethrowing errors
+         *
+         * @return std::exception_ptr Error of the command, nullptr on success
+         */
+        std::exception_ptr waitForError() const {
+            if (!state) {
+                return nullptr;
+            }
+            std::unique_lock lock(state->mutex);
+            state->condition.wait(lock, [this]() { return state->done; });
+            return state->error;
+        }
+
+         public:
+        /**
+         * @brief Check if the command completed, successfully or not, without blocking
+         *
+         * @return true
+         * @return false
+         */
+        bool query() const {
+            if (!state) {
+                return true;
+            }
+            const std::lock_guard lock(state->mutex);
+            return state->done;
+        }
+
+        /**
+         * @brief Block until the command completed. Rethrows the error if the command or one of its dependencies failed.
+         *
+         */
+        void wait() const {
+            if (auto error = waitForError()) {
+                std::rethrow_exception(error);
+            }
+        }
+    };
+
+    /**
+     * @brief An ordered queue of device and host commands, executed by its own worker thread.
+     *
+     * Commands of one stream run one after the other; a command that runs a kernel completes when the kernel is idle again. Commands of different
+     * streams run concurrently and can be ordered with events, also across devices. Since input kernels only finish when their data is consumed,
+     * output kernels should be run on a different stream than the input kernels feeding them.
+     *
+     * If a command fails, its event carries the error. Commands depending on a failed event are skipped and inherit the error, while the
+     * remaining commands of the stream still run.
+     *
+     * Spans passed to enqueueWrite and enqueueRead have to stay valid until the returned event completed.
+     *
+     */
+    class CommandStream {
+         private:
+        struct Command {
+            std::function<void()> work;
+            std::vector<Event> dependencies;
+            Event completion;
+        };
+
+        std::string name;
+        std::mutex queueMutex;
+        std::condition_variable_any queueCondition;
+        std::deque<Command> commands;
+        Event last;
+        logger_type& logger = Logger::getLogger();
+        std::jthread worker;
+
+        /**
+         * @brief A logger prefix to determine the source of a log write
+         *
+         * @return std::string
+         */
+        std::string loggerPrefix() const { return "[CommandStream - " + name + "] "; }
+
+        void run(std::stop_token stoken) {
+            while (true) {
+                Command command;
+                {
+                    std::unique_lock lock(queueMutex);
+                    if (!queueCondition.wait(lock, stoken, [this]() { return !commands.empty(); })) {
+                        return;
+                    }
+                    command = std::move(commands.front());
+                    commands.pop_front();
+                }
+                std::exception_ptr error;
+                for (const auto& dependency : command.dependencies) {
+                    if (auto dependencyError = dependency.waitForError(); dependencyError && !error) {
+                        error = dependencyError;
+                    }
+                }
+                if (!error) {
+                    try {
+                        command.work();
+                    } catch (...) {
+                        error = std::current_exception();
+                        FINN_LOG(logger, loglevel::error) << loggerPrefix() << "Command failed";
+                    }
+                }
+                command.completion.complete(error);
+            }
+        }
+
+        Event enqueue(std::function<void()> work, std::vector<Event> dependencies) {
+            Event completion = Event::create();
+            {
+                const std::lock_guard lock(queueMutex);
+                commands.emplace_back(Command{std::move(work), std::move(dependencies), completion});
+                last = completion;
+            }
+            queueCondition.notify_one();
+            return completion;
+        }
+
+         public:
+        /**
+         * @brief Construct a new Command Stream object and start its worker thread
+         *
+         * @param pName Name used in log messages
+         */
+        explicit CommandStream(std::string pName = "Stream") : name(std::move(pName)) {
+            worker = std::jthread([this](std::stop_token stoken) { run(stoken); });
+        }
+
+        CommandStream(CommandStream&& other) = delete;
+        CommandStream(const CommandStream& other) = delete;
+        CommandStream& operator=(CommandStream&& other) = delete;
+        CommandStream& operator=(const CommandStream& other) = delete;
+
+        /**
+         * @brief Destroy the Command Stream object. Waits until all enqueued commands completed.
+         *
+         */
+        ~CommandStream() {
+            last.waitForError();
+            worker.request_stop();
+        }
+
+        /**
+         * @brief Copy data into the host side map of an input buffer. The transfer to the device happens when the buffer is run.
+         *
+         * @param buffer
+         * @param data Packed input data, has to stay valid until the command completed
+         * @param dependencies Events that have to complete before the command starts
+         * @return Event
+         */
+        Event enqueueWrite(std::shared_ptr<DeviceInputBuffer<uint8_t>> buffer, std::span<const uint8_t> data, std::vector<Event> dependencies = {}) {
+            return enqueue(
+                [buffer = std::move(buffer), data]() {
+                    if (!buffer->store(data)) {
+                        FinnUtils::logAndError<std::runtime_error>("Could not store data in buffer " + buffer->getName() + "!");
+                    }
+                },
+                std::move(dependencies));
+        }
+
+        /**
+         * @brief Run the kernel of a buffer. Completes when the kernel is idle again.
+         *
+         * @param buffer Input or output buffer
+         * @param dependencies Events that have to complete before the command starts
+         * @return Event
+         */
+        Event enqueueRun(std::shared_ptr<DeviceBuffer<uint8_t>> buffer, std::vector<Event> dependencies = {}) {
+            return enqueue(
+                [buffer = std::move(buffer)]() {
+                    if (!buffer->run() || !buffer->wait()) {
+                        FinnUtils::logAndError<std::runtime_error>("Kernel of buffer " + buffer->getName() + " failed!");
+                    }
+                },
+                std::move(dependencies));
+        }
+
+        /**
+         * @brief Transfer the data of an output buffer from the device and copy it to the destination
+         *
+         * @param buffer
+         * @param destination Has to hold the total data size of the buffer and stay valid until the command completed
+         * @param dependencies Events that have to complete before the command starts
+         * @return Event
+         */
+        Event enqueueRead(std::shared_ptr<DeviceOutputBuffer<uint8_t>> buffer, std::span<uint8_t> destination, std::vector<Event> dependencies = {}) {
+            if (destination.size() < buffer->size(SIZE_SPECIFIER::TOTAL_DATA_SIZE)) {
+                FinnUtils::logAndError<std::invalid_argument>("Destination of " + std::to_string(destination.size()) + " bytes is too small for buffer " + buffer->getName() + "!");
+            }
+            return enqueue(
+                [buffer = std::move(buffer), destination]() {
+                    if (!buffer->read()) {
+                        FinnUtils::logAndError<std::runtime_error>("Could not read buffer " + buffer->getName() + "!");
+                    }
+                    const auto data = buffer->getData();
+                    std::copy(data.begin(), data.end(), destination.begin());
+                },
+                std::move(dependencies));
+        }
+
+        /**
+         * @brief Run a host function in stream order, e.g. to process data between two partitions
+         *
+         * @param function
+         * @param dependencies Events that have to complete before the function starts
+         * @return Event
+         */
+        Event enqueueHostFn(std::function<void()> function, std::vector<Event> dependencies = {}) { return enqueue(std::move(function), std::move(dependencies)); }
+
+        /**
+         * @brief Make all further commands of this stream wait for an event, usually of another stream
+         *
+         * @param event
+         * @return Event
+         */
+        Event enqueueWait(const Event& event) { return enqueue([]() {}, {event}); }
+
+        /**
+         * @brief Get the event of the last enqueued command
+         *
+         * @return Event
+         */
+        Event record() {
+            const std::lock_guard lock(queueMutex);
+            return last;
+        }
+
+        /**
+         * @brief Block until all enqueued commands completed. Rethrows the error of the last command, if it failed.
+         *
+         */
+        void synchronize() { record().wait(); }
+    };
+}  // namespace Finn
+
+#endif  // COMMANDSTREAM_HPP
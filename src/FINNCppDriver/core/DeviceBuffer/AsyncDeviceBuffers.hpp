@@ -16,7 +16,10 @@
 #include <FINNCppDriver/utils/FinnUtils.h>
 
 #include <FINNCppDriver/core/DeviceBuffer/DeviceBuffer.hpp>
+#include <FINNCppDriver/utils/MPMCQueue.hpp>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <thread>
 
 #include "ert.h"
@@ -33,21 +36,25 @@ namespace Finn {
         class AsyncBufferWrapper {
              protected:
             /**
-             * @brief Internal Ringbuffer used by all asynchronous buffers
+             * @brief Internal Ringbuffer used by all asynchronous buffers. Empty if the buffer uses another queue.
              *
              */
-            RingBuffer<T, true> ringBuffer;
+            std::optional<RingBuffer<T, true>> ringBuffer;
 
             /**
              * @brief Construct a new Async Buffer Wrapper object
              *
              * @param ringBufferSizeFactor Number of batch elements that should be able to be stored
              * @param elementsPerPart Number of values per batch element
+             * @param withRingBuffer Allocate the ring buffer. Buffers that bring their own queue pass false.
              */
-            AsyncBufferWrapper(unsigned int ringBufferSizeFactor, std::size_t elementsPerPart) : ringBuffer(RingBuffer<T, true>(ringBufferSizeFactor, elementsPerPart)) {
+            AsyncBufferWrapper(unsigned int ringBufferSizeFactor, std::size_t elementsPerPart, bool withRingBuffer = true) {
                 if (ringBufferSizeFactor == 0) {
                     FinnUtils::logAndError<std::runtime_error>("DeviceBuffer of size 0 cannot be constructed!");
                 }
+                if (withRingBuffer) {
+                    ringBuffer.emplace(ringBufferSizeFactor, elementsPerPart);
+                }
                 FINN_LOG(Logger::getLogger(), loglevel::info) << "[AsyncDeviceBuffer] Max buffer size:" << ringBufferSizeFactor << "*" << elementsPerPart << "\n";
             }
 
@@ -84,7 +91,7 @@ namespace Finn {
             AsyncBufferWrapper& operator=(const AsyncBufferWrapper& buf) = delete;
 #ifdef UNITTEST
              public:
-            RingBuffer<T, true>& testGetRingBuffer() { return this->ringBuffer; }
+            RingBuffer<T, true>& testGetRingBuffer() { return *this->ringBuffer; }
 #endif
         };
     }  // namespace detail
@@ -95,9 +102,19 @@ namespace Finn {
      * @tparam T Datatype of the data transfered. Most likely always uint8_t
      */
     template<typename T>
-    class AsyncDeviceInputBuffer : public DeviceInputBuffer<T>, public detail::AsyncBufferWrapper<T> {
+    class AsyncDeviceInputBuffer final : public DeviceInputBuffer<T>, public detail::AsyncBufferWrapper<T> {
          private:
         friend class DeviceInputBuffer<T>;
+        /**
+         * @brief Cached staging buffer used to fill write-combined maps
+         *
+         */
+        Finn::vector<T> mapStaging;
+        /**
+         * @brief Lock-free submission queue. Replaces the ring buffer as submission path if SUBMISSION_QUEUE::MPMC is selected, otherwise nullptr
+         *
+         */
+        std::unique_ptr<MPMCQueue<T>> submissionQueue;
         std::jthread workerThread;
 
         /**
@@ -105,7 +122,7 @@ namespace Finn {
          *
          */
         void runInternal(std::stop_token stoken) {
-            const std::size_t elementCount = this->ringBuffer.size(SIZE_SPECIFIER::FEATUREMAP_SIZE);
+            const std::size_t elementCount = size(SIZE_SPECIFIER::FEATUREMAP_SIZE);
             while (!stoken.stop_requested()) {
                 if (!this->loadMap(stoken)) {  // blocks
                     break;
@@ -125,10 +142,13 @@ namespace Finn {
          * @param pAssociatedKernel XRT kernel
          * @param pShapePacked packed shape of input
          * @param ringBufferSizeFactor size of ringbuffer in input elements (batch elements)
+         * @param queueType Queue used to collect the submitted inputs. SUBMISSION_QUEUE::MPMC scales better with many producer threads
          */
-        AsyncDeviceInputBuffer(const std::string& pCUName, xrt::device& device, xrt::uuid& pDevUUID, const shapePacked_t& pShapePacked, unsigned int ringBufferSizeFactor)
+        AsyncDeviceInputBuffer(const std::string& pCUName, xrt::device& device, xrt::uuid& pDevUUID, const shapePacked_t& pShapePacked, unsigned int ringBufferSizeFactor,
+                               SUBMISSION_QUEUE queueType = SUBMISSION_QUEUE::RING_BUFFER)
             : DeviceInputBuffer<T>(pCUName, device, pDevUUID, pShapePacked),
-              detail::AsyncBufferWrapper<T>(ringBufferSizeFactor, FinnUtils::shapeToElements(pShapePacked)),
+              detail::AsyncBufferWrapper<T>(ringBufferSizeFactor, FinnUtils::shapeToElements(pShapePacked), queueType == SUBMISSION_QUEUE::RING_BUFFER),
+              submissionQueue((queueType == SUBMISSION_QUEUE::MPMC) ? std::make_unique<MPMCQueue<T>>(ringBufferSizeFactor, FinnUtils::shapeToElements(pShapePacked)) : nullptr),
               workerThread(std::jthread(std::bind_front(&AsyncDeviceInputBuffer::runInternal, this))){};
 
         /**
@@ -172,16 +192,22 @@ namespace Finn {
          * @param ss
          * @return size_t
          */
-        size_t size(SIZE_SPECIFIER ss) override { return this->ringBuffer.size(ss); }
+        size_t size(SIZE_SPECIFIER ss) override { return submissionQueue ? submissionQueue->size(ss) : this->ringBuffer->size(ss); }
 
         /**
-         * @brief Store the given data in the ring buffer
+         * @brief Store the given data in the submission queue
          *
          * @param data
          * @return true Store was successful
          * @return false Store failed
          */
-        bool store(std::span<const T> data) override { return this->ringBuffer.store(data.begin(), data.end()); }
+        bool store(std::span<const T> data) override {
+            const bool stored = submissionQueue ? submissionQueue->store(data.begin(), data.end()) : this->ringBuffer->store(data.begin(), data.end());
+            if (FinnUtils::LiveStats::isEnabled()) {
+                FinnUtils::LiveStats::setRingOccupancy(submissionQueue ? submissionQueue->size() : this->ringBuffer->size(), size(SIZE_SPECIFIER::BATCHSIZE));
+            }
+            return stored;
+        }
 
          protected:
         /**
@@ -193,7 +219,18 @@ namespace Finn {
          */
         bool loadMap(std::stop_token stoken) {
             FINN_LOG(this->logger, loglevel::info) << "Data transfer of input data to FPGA!\n";
-            return this->ringBuffer.read(this->map, stoken);
+            const MAP_TYPE currentMapType = this->mapType;
+            const auto readPart = [this, &stoken](auto outputIt) { return submissionQueue ? submissionQueue->read(outputIt, stoken) : this->ringBuffer->read(outputIt, stoken); };
+            if (currentMapType == MAP_TYPE::CACHED) {
+                return readPart(this->map);
+            }
+            // Write-combined maps are filled with streaming stores from a cached staging buffer
+            mapStaging.resize(size(SIZE_SPECIFIER::FEATUREMAP_SIZE));
+            if (!readPart(mapStaging.begin())) {
+                return false;
+            }
+            FinnUtils::copyToMap(currentMapType, this->map, mapStaging.data(), mapStaging.size() * sizeof(T));
+            return true;
         }
 
         /**
@@ -212,14 +249,19 @@ namespace Finn {
      * @tparam T Datatype of the data transfered. Most likely always uint8_t
      */
     template<typename T>
-    class AsyncDeviceOutputBuffer : public DeviceOutputBuffer<T>, public detail::AsyncBufferWrapper<T> {
+    class AsyncDeviceOutputBuffer final : public DeviceOutputBuffer<T>, public detail::AsyncBufferWrapper<T> {
         std::mutex ltsMutex;
+        /**
+         * @brief Cached staging buffer used to read write-combined or uncached maps
+         *
+         */
+        Finn::vector<T> mapStaging;
         std::jthread workerThread;
 
          private:
         void readInternal(std::stop_token stoken) {
             FINN_LOG_DEBUG(this->logger, loglevel::info) << this->loggerPrefix() << "Starting to read from the device";
-            const std::size_t elementCount = this->ringBuffer.size(SIZE_SPECIFIER::FEATUREMAP_SIZE);
+            const std::size_t elementCount = this->ringBuffer->size(SIZE_SPECIFIER::FEATUREMAP_SIZE);
             while (!stoken.stop_requested()) {
                 // auto outExecuteResult = execute();
                 // std::cout << outExecuteResult << "\n";
@@ -232,7 +274,7 @@ namespace Finn {
                 // }
                 this->sync(elementCount);
                 saveMap();
-                if (this->ringBuffer.full()) {  // TODO(linusjun): Allow registering of callback for this event?
+                if (this->ringBuffer->full()) {  // TODO(linusjun): Allow registering of callback for this event?
                     archiveValidBufferParts();
                 }
             }
@@ -296,7 +338,7 @@ namespace Finn {
          * @param ss
          * @return size_t
          */
-        size_t size(SIZE_SPECIFIER ss) override { return this->ringBuffer.size(ss); }
+        size_t size(SIZE_SPECIFIER ss) override { return this->ringBuffer->size(ss); }
 
         /**
          * @brief Put every valid read part of the ring buffer into the archive. This invalides them so that they are not put into the archive again.
@@ -306,8 +348,8 @@ namespace Finn {
          */
         void archiveValidBufferParts() {
             std::lock_guard guard(ltsMutex);
-            this->longTermStorage.reserve(this->longTermStorage.size() + this->ringBuffer.size());
-            this->ringBuffer.readAllValidParts(std::back_inserter(this->longTermStorage));
+            this->longTermStorage.reserve(this->longTermStorage.size() + this->ringBuffer->size());
+            this->ringBuffer->readAllValidParts(std::back_inserter(this->longTermStorage));
         }
 
         /**
@@ -327,7 +369,7 @@ namespace Finn {
          *
          * @param expectedEntries
          */
-        void allocateLongTermStorage([[maybe_unused]] unsigned int expectedEntries) { this->longTermStorage.reserve(expectedEntries * this->ringBuffer.size(SIZE_SPECIFIER::FEATUREMAP_SIZE)); }
+        void allocateLongTermStorage([[maybe_unused]] unsigned int expectedEntries) { this->longTermStorage.reserve(expectedEntries * this->ringBuffer->size(SIZE_SPECIFIER::FEATUREMAP_SIZE)); }
 
         /**
          * @brief Not supported by the AsyncDeviceOutputBuffer.
@@ -351,7 +393,15 @@ namespace Finn {
          */
         void saveMap() {
             FINN_LOG(this->logger, loglevel::info) << "Data transfer of output from FPGA!\n";
-            this->ringBuffer.template store<T*>(this->map, this->ringBuffer.size(SIZE_SPECIFIER::FEATUREMAP_SIZE));
+            const MAP_TYPE currentMapType = this->mapType;
+            if (currentMapType == MAP_TYPE::CACHED) {
+                this->ringBuffer->template store<T*>(this->map, this->ringBuffer->size(SIZE_SPECIFIER::FEATUREMAP_SIZE));
+                return;
+            }
+            // Read write-combined or uncached maps once with streaming loads instead of element wise
+            mapStaging.resize(this->ringBuffer->size(SIZE_SPECIFIER::FEATUREMAP_SIZE));
+            FinnUtils::copyFromMap(currentMapType, mapStaging.data(), this->map, mapStaging.size() * sizeof(T));
+            this->ringBuffer->store(mapStaging.begin(), mapStaging.end());
         }
 
         /**
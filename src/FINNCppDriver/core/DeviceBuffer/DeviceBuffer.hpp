@@ -13,10 +13,15 @@
 #ifndef DEVICEBUFFER
 #define DEVICEBUFFER
 
+#include <FINNCppDriver/utils/LiveStats.h>
 #include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Tracepoints.h>
+#include <FINNCppDriver/utils/Tunables.h>
 #include <FINNCppDriver/utils/Types.h>
 
 #include <FINNCppDriver/utils/RingBuffer.hpp>
+#include <FINNCppDriver/utils/StreamingCopy.hpp>
+#include <atomic>
 #include <boost/type_index.hpp>
 #include <chrono>
 #include <future>
@@ -74,6 +79,11 @@ namespace Finn {
          *
          */
         T* map;
+        /**
+         * @brief Caching behaviour of the map. Selects the copy routines used to access it. Atomic, because asynchronous buffers read it from their worker thread
+         *
+         */
+        std::atomic<MAP_TYPE> mapType = MAP_TYPE::CACHED;
         /**
          * @brief 64 bit adress of the buffer located on the FPGA card
          *
@@ -86,11 +96,20 @@ namespace Finn {
         logger_type& logger;
 
         void busyWait() {
+            FINN_TRACE(kernel_wait_start, name.c_str());
             // Wait until the IP is DONE
             uint32_t axi_ctrl = 0;
+            std::size_t polls = 0;
+            const bool yield = FinnUtils::Tunables::waitPolicy() == WAIT_POLICY::YIELD;
             while ((axi_ctrl & IP_IDLE) != IP_IDLE) {
+                if (yield && polls != 0) {
+                    std::this_thread::yield();
+                }
                 axi_ctrl = assocIPCore.read_register(CSR_OFFSET);
+                ++polls;
             }
+            FINN_TRACE(kernel_wait_done, name.c_str(), polls);
+            FinnUtils::LiveStats::recordPolls(polls);
         }
 
          private:
@@ -126,6 +145,7 @@ namespace Finn {
             FINN_LOG(logger, loglevel::info) << "[DeviceBuffer] "
                                              << "Initializing DeviceBuffer " << name << " (SHAPE PACKED: " << FinnUtils::shapeToString(pShapePacked) << " inputs of the given shape, MAP SIZE: " << mapSize << ")\n";
             std::fill(map, map + mapSize, 0);
+            mapType = mapTypeFromFlags(internalBo.get_flags(), MAP_TYPE::CACHED);
         }
 
         /**
@@ -139,6 +159,7 @@ namespace Finn {
               internalBo(std::move(buf.internalBo)),
               assocIPCore(std::move(buf.assocIPCore)),
               map(std::move(buf.map)),
+              mapType(buf.mapType.load()),
               bufAdr(internalBo.address()),
               logger(Logger::getLogger()) {}
 
@@ -193,6 +214,54 @@ namespace Finn {
          */
         virtual shape_t& getPackedShape() { return shapePacked; }
 
+        /**
+         * @brief Mapping type of a buffer object with the given flags. Peer to peer buffers are mapped through the PCIe BAR and thus write-combined, cacheable and host only
+         * buffers live in cached host memory. The caching of all other buffers depends on the platform, for them the configured mapping type is used.
+         *
+         * @param flags Flags of the buffer object
+         * @param configured Mapping type from the configuration
+         * @return MAP_TYPE
+         */
+        static MAP_TYPE mapTypeFromFlags(xrt::bo::flags flags, MAP_TYPE configured) {
+            switch (flags) {
+                case xrt::bo::flags::p2p:
+                    return MAP_TYPE::WRITE_COMBINED;
+                case xrt::bo::flags::cacheable:
+                case xrt::bo::flags::host_only:
+                    return MAP_TYPE::CACHED;
+                default:
+                    return configured;
+            }
+        }
+
+        /**
+         * @brief Set the mapping type of the buffer map. Write-combined and uncached maps are accessed with streaming loads and stores.
+         * The flags of the buffer object take precedence over the given type, see mapTypeFromFlags.
+         *
+         * @param pMapType
+         */
+        void setMapType(MAP_TYPE pMapType) {
+            const MAP_TYPE detected = mapTypeFromFlags(internalBo.get_flags(), pMapType);
+            if (detected != pMapType) {
+                FINN_LOG(logger, loglevel::warning) << "[DeviceBuffer] Buffer " << name << " is configured with mapping type " << static_cast<int>(pMapType) << ", but the flags of its buffer object require mapping type "
+                                                    << static_cast<int>(detected);
+            }
+            mapType = detected;
+        }
+
+        /**
+         * @brief Get the mapping type of the buffer map
+         *
+         * @return MAP_TYPE
+         */
+        MAP_TYPE getMapType() const { return mapType; }
+
+        /**
+         * @brief Make the next run rewrite the buffer address and repetition registers of the kernel. Needed if another buffer ran the same kernel in between.
+         *
+         */
+        void invalidateRegisterCache() { oldRepetitions = 0; }
+
         /**
          * @brief Run the associated kernel
          *
@@ -225,6 +294,7 @@ namespace Finn {
             // writes the buffer adress
             constexpr uint32_t offset_buf = 0x10;
             constexpr uint32_t offset_rep = 0x1C;
+            FINN_TRACE(kernel_start, name.c_str(), repetitions);
 
             // If repetition number is the same as for the last call, then nothing has to be written before starting the Kernel
             if (repetitions == oldRepetitions) {
@@ -258,6 +328,20 @@ namespace Finn {
      */
     template<typename T>
     class AsyncDeviceInputBuffer;
+    /**
+     * @brief @ref SyncDeviceOutputBuffer
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class SyncDeviceOutputBuffer;
+    /**
+     * @brief @ref AsyncDeviceOutputBuffer
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class AsyncDeviceOutputBuffer;
 
     /**
      * @brief Abstract base class that defines interfaces that need to be fulfilled by the DeviceInputBuffers
@@ -294,6 +378,15 @@ namespace Finn {
          */
         virtual bool store(std::span<const T> data) = 0;
 
+        /**
+         * @brief Writable view of the input in the buffer map. Data written to it is transferred by the next run without a call to store, use getMapType to select the copy routines.
+         * Only synchronous buffers hand out their map, asynchronous buffers return an empty span.
+         * @attention This function is NOT THREAD SAFE!
+         *
+         * @return std::span<T>
+         */
+        virtual std::span<T> getMapView() { return {}; }
+
          protected:
         /**
          * @brief Sync data from the map to the device.
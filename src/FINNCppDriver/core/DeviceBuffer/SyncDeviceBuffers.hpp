@@ -20,7 +20,7 @@
 
 namespace Finn {
     template<typename T>
-    class SyncDeviceInputBuffer : public DeviceInputBuffer<T> {
+    class SyncDeviceInputBuffer final : public DeviceInputBuffer<T> {
          public:
         /**
          * @brief Construct a new Sync Device Input Buffer object
@@ -110,10 +110,17 @@ namespace Finn {
          * @return false
          */
         bool store(std::span<const T> data) override {
-            std::copy(data.begin(), data.end(), this->map);
+            FinnUtils::copyToMap(this->mapType, this->map, data.data(), data.size_bytes());
             return true;
         }
 
+        /**
+         * @brief Writable view of the input in the buffer map, e.g. to pack inputs directly into it
+         *
+         * @return std::span<T>
+         */
+        std::span<T> getMapView() override { return {this->map, FinnUtils::shapeToElements(this->shapePacked)}; }
+
         /**
          * @brief Execute the input kernel with the input stored in the input map. Returns false if no valid data was found
          *
@@ -134,7 +141,7 @@ namespace Finn {
      * @tparam T
      */
     template<typename T>
-    class SyncDeviceOutputBuffer : public DeviceOutputBuffer<T> {
+    class SyncDeviceOutputBuffer final : public DeviceOutputBuffer<T> {
          private:
         std::size_t elementCount;
 
@@ -216,10 +223,25 @@ namespace Finn {
          * @return Finn::vector<T>
          */
         Finn::vector<T> getData() override {
-            Finn::vector<T> tmp(this->map, this->map + elementCount);
+            Finn::vector<T> tmp(elementCount);
+            FinnUtils::copyFromMap(this->mapType, tmp.data(), this->map, elementCount * sizeof(T));
             return tmp;
         }
 
+        /**
+         * @brief Copy the data contained in the FPGA Buffer map into a caller provided buffer, e.g. preallocated scratch memory
+         *
+         * @param destination Has to hold the total data size of the buffer
+         * @return std::size_t Number of copied elements
+         */
+        std::size_t getData(std::span<T> destination) {
+            if (destination.size() < elementCount) {
+                FinnUtils::logAndError<std::length_error>("Destination of " + std::to_string(destination.size()) + " elements is too small for buffer " + this->name + "!");
+            }
+            FinnUtils::copyFromMap(this->mapType, destination.data(), this->map, elementCount * sizeof(T));
+            return elementCount;
+        }
+
         /**
          * @brief Execute the output kernel.
          *
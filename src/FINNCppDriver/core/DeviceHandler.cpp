@@ -96,22 +96,36 @@ namespace Finn {
     void DeviceHandler::initializeBufferObjects(const DeviceWrapper& devWrap, unsigned int hostBufferSize, bool pSynchronousInference) {
         FINN_LOG(Logger::getLogger(), loglevel::info) << loggerPrefix() << "(" << xrtDeviceIndex << ") "
                                                       << "Initializing buffer objects\n";
+        syncInputBuffers.clear();
+        syncOutputBuffers.clear();
+        asyncInputBuffers.clear();
+        asyncOutputBuffers.clear();
+        inputBufferNames.clear();
         for (auto&& ebdptr : devWrap.idmas) {
             if (pSynchronousInference) {
-                inputBufferMap.emplace(std::make_pair(ebdptr->kernelName, std::make_shared<Finn::SyncDeviceInputBuffer<uint8_t>>(ebdptr->kernelName, device, uuid, ebdptr->packedShape, hostBufferSize)));
+                auto ptr = std::make_shared<Finn::SyncDeviceInputBuffer<uint8_t>>(ebdptr->kernelName, device, uuid, ebdptr->packedShape, hostBufferSize);
+                syncInputBuffers.emplace_back(ptr.get());
+                inputBufferMap.emplace(std::make_pair(ebdptr->kernelName, ptr));
             } else {
-                inputBufferMap.emplace(std::make_pair(ebdptr->kernelName, std::make_shared<Finn::AsyncDeviceInputBuffer<uint8_t>>(ebdptr->kernelName, device, uuid, ebdptr->packedShape, hostBufferSize)));
+                auto ptr = std::make_shared<Finn::AsyncDeviceInputBuffer<uint8_t>>(ebdptr->kernelName, device, uuid, ebdptr->packedShape, hostBufferSize, ebdptr->submissionQueue);
+                asyncInputBuffers.emplace_back(ptr.get());
+                inputBufferMap.emplace(std::make_pair(ebdptr->kernelName, ptr));
             }
+            inputBufferNames.emplace_back(ebdptr->kernelName);
+            inputBufferMap.at(ebdptr->kernelName)->setMapType(ebdptr->mapType);
         }
         for (auto&& ebdptr : devWrap.odmas) {
             if (pSynchronousInference) {
                 auto ptr = std::make_shared<Finn::SyncDeviceOutputBuffer<uint8_t>>(ebdptr->kernelName, device, uuid, ebdptr->packedShape, hostBufferSize);
+                syncOutputBuffers.emplace_back(ptr.get());
                 outputBufferMap.emplace(std::make_pair(ebdptr->kernelName, ptr));
             } else {
                 auto ptr = std::make_shared<Finn::AsyncDeviceOutputBuffer<uint8_t>>(ebdptr->kernelName, device, uuid, ebdptr->packedShape, hostBufferSize);
                 ptr->allocateLongTermStorage(hostBufferSize * 5);
+                asyncOutputBuffers.emplace_back(ptr.get());
                 outputBufferMap.emplace(std::make_pair(ebdptr->kernelName, ptr));
             }
+            outputBufferMap.at(ebdptr->kernelName)->setMapType(ebdptr->mapType);
         }
         FINN_LOG(Logger::getLogger(), loglevel::info) << loggerPrefix() << "Finished initializing buffer objects on device " << xrtDeviceIndex;
 
@@ -154,16 +168,37 @@ namespace Finn {
 
     [[maybe_unused]] unsigned int DeviceHandler::getDeviceIndex() const { return xrtDeviceIndex; }
 
+    std::size_t DeviceHandler::inputBufferIndex(const std::string& inputBufferKernelName) const {
+        const auto it = std::find(inputBufferNames.begin(), inputBufferNames.end(), inputBufferKernelName);
+        if (it == inputBufferNames.end()) {
+            FinnUtils::logAndError<std::runtime_error>("Tried accessing kernel/buffer with name " + inputBufferKernelName + " but this kernel / buffer does not exist!");
+        }
+        return static_cast<std::size_t>(std::distance(inputBufferNames.begin(), it));
+    }
+
+    bool DeviceHandler::storeAt(std::size_t inputIndex, std::span<const uint8_t> data) {
+        if (synchronousInference) {
+            return syncInputBuffers[inputIndex]->store(data);
+        }
+        return asyncInputBuffers[inputIndex]->store(data);
+    }
+
     bool DeviceHandler::run() {
         // Start the output kernels before the input to overlap the execution in a better way
         bool ret = true;
-        // cppcheck-suppress unusedVariable
-        for (auto&& [key, value] : outputBufferMap) {
-            ret &= value->run();
-        }
-        // cppcheck-suppress unusedVariable
-        for (auto&& [key, value] : inputBufferMap) {
-            ret &= value->run();
+        if (synchronousInference) {
+            for (auto* buffer : syncOutputBuffers) {
+                ret &= buffer->run();
+            }
+            for (auto* buffer : syncInputBuffers) {
+                ret &= buffer->run();
+            }
+        } else {
+            // Asynchronous buffers are driven by their worker threads and do not support explicit runs
+            for (auto* buffer : asyncOutputBuffers) {
+                ret &= buffer->run();
+            }
+            ret &= asyncInputBuffers.empty();
         }
         return ret;
     }
@@ -171,9 +206,14 @@ namespace Finn {
     bool DeviceHandler::wait() {
         // We only need to wait for the outputs, because inputs have to finish before outputs
         bool ret = true;
-        // cppcheck-suppress unusedVariable
-        for (auto&& [key, value] : outputBufferMap) {
-            ret &= value->wait();
+        if (synchronousInference) {
+            for (auto* buffer : syncOutputBuffers) {
+                ret &= buffer->wait();
+            }
+        } else {
+            for (auto* buffer : asyncOutputBuffers) {
+                ret &= buffer->wait();
+            }
         }
         return ret;
     }
@@ -181,9 +221,14 @@ namespace Finn {
     bool DeviceHandler::read() {
         // Sync data back from the FPGA
         bool ret = true;
-        // cppcheck-suppress unusedVariable
-        for (auto&& [key, value] : outputBufferMap) {
-            ret &= value->read();
+        if (synchronousInference) {
+            for (auto* buffer : syncOutputBuffers) {
+                ret &= buffer->read();
+            }
+        } else {
+            for (auto* buffer : asyncOutputBuffers) {
+                ret &= buffer->read();
+            }
         }
         return ret;
     }
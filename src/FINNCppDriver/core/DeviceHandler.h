@@ -91,6 +91,22 @@ namespace Finn {
          */
         std::unordered_map<std::string, std::shared_ptr<DeviceOutputBuffer<uint8_t>>> outputBufferMap;
 
+        /**
+         * @brief Flat arrays of the buffers in configuration order, used on the hot path. Only the arrays of the selected inference mode are filled.
+         * The buffer classes are final, so calls through these pointers are resolved statically. The maps above own the buffers.
+         *
+         */
+        std::vector<SyncDeviceInputBuffer<uint8_t>*> syncInputBuffers;
+        std::vector<SyncDeviceOutputBuffer<uint8_t>*> syncOutputBuffers;
+        std::vector<AsyncDeviceInputBuffer<uint8_t>*> asyncInputBuffers;
+        std::vector<AsyncDeviceOutputBuffer<uint8_t>*> asyncOutputBuffers;
+
+        /**
+         * @brief Names of the input buffers, in the order of the flat arrays
+         *
+         */
+        std::vector<std::string> inputBufferNames;
+
 
          public:
         /**
@@ -288,20 +304,38 @@ namespace Finn {
          */
         static std::string loggerPrefix();
 
+        /**
+         * @brief Get the position of an input buffer in the flat buffer arrays
+         *
+         * @param inputBufferKernelName
+         * @return std::size_t
+         */
+        std::size_t inputBufferIndex(const std::string& inputBufferKernelName) const;
+
+        /**
+         * @brief Store the provided data into the input buffer at the given position of the flat buffer arrays
+         *
+         * @param inputIndex
+         * @param data
+         * @return true
+         * @return false
+         */
+        bool storeAt(std::size_t inputIndex, std::span<const uint8_t> data);
+
         /**
          * @brief Store the provided data into the DeviceBuffer
          *
          * @tparam IteratorType
          * @param first
          * @param last
-         * @param inputBufferKernelName Name of the kernel to be used when transfering data to FPGA
+         * @param inputIndex Position of the input buffer in the flat buffer arrays
          * @return true
          * @return false
          */
         template<typename IteratorType>
-        bool storeUnchecked(IteratorType first, IteratorType last, const std::string& inputBufferKernelName) {
+        bool storeUnchecked(IteratorType first, IteratorType last, std::size_t inputIndex) {
             static_assert(std::is_same<typename std::iterator_traits<IteratorType>::value_type, uint8_t>::value);
-            return inputBufferMap.at(inputBufferKernelName)->store(std::span<const uint8_t>(first, last));
+            return storeAt(inputIndex, std::span<const uint8_t>(first, last));
         }
 
 
@@ -317,19 +351,19 @@ namespace Finn {
     };
 
     /**
-     * @brief Functor for faster store operations
+     * @brief Functor for faster store operations. The buffer is looked up once on construction.
      *
      */
     class UncheckedStore {
         DeviceHandler& dev;
-        std::string inputBufferName;
+        std::size_t inputIndex;
 
          public:
         /**
          * @brief Dummy constructor, this one should never be used
          *
          */
-        UncheckedStore(DeviceHandler& pDev, const std::string& pInputBufferName) : dev(pDev), inputBufferName(pInputBufferName) {}
+        UncheckedStore(DeviceHandler& pDev, const std::string& pInputBufferName) : dev(pDev), inputIndex(pDev.inputBufferIndex(pInputBufferName)) {}
 
         /**
          * @brief Stores the data vector into a device buffer
@@ -338,7 +372,7 @@ namespace Finn {
          * @return true success
          * @return false failure
          */
-        bool operator()(const Finn::vector<uint8_t>& data) { return dev.storeUnchecked(data.begin(), data.end(), inputBufferName); }
+        bool operator()(const Finn::vector<uint8_t>& data) { return dev.storeUnchecked(data.begin(), data.end(), inputIndex); }
 
         /**
          * @brief Stores the data vector into a device buffer
@@ -351,7 +385,7 @@ namespace Finn {
          */
         template<typename IteratorType>
         bool operator()(IteratorType first, IteratorType last) {
-            return dev.storeUnchecked(first, last, inputBufferName);
+            return dev.storeUnchecked(first, last, inputIndex);
         }
     };
 
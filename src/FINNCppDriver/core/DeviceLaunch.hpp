@@ -0,0 +1,191 @@
+/**
+ * @file DeviceLaunch.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Private input and output buffer objects of one executor worker together with the pack, launch and unpack steps that run on them
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef DEVICELAUNCH_HPP
+#define DEVICELAUNCH_HPP
+
+#include <FINNCppDriver/utils/ConfigurationStructs.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/core/DeviceBuffer/SyncDeviceBuffers.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_uuid.h"
+
+namespace Finn {
+    /**
+     * @brief Launches of one model on buffer objects that are private to one worker, e.g. a shard of the ShardedExecutor or a device of the HedgedExecutor.
+     * Uses the first input and output kernel of a device. Inputs are packed directly into the map of the input buffer and outputs are read into scratch memory that is reused by every launch, so packing and unpacking into a destination do not allocate.
+     * Not thread safe, every worker owns its own DeviceLaunch.
+     *
+     * @tparam F FINN input datatype
+     * @tparam S FINN output datatype
+     */
+    template<IsDatatype F, IsDatatype S>
+    class DeviceLaunch {
+         public:
+        /**
+         * @brief Element type of unpacked inputs
+         *
+         */
+        using InputType = UnpackingAutoRetType::AutoRetType<F>;
+        /**
+         * @brief Element type of unpacked outputs
+         *
+         */
+        using OutputType = UnpackingAutoRetType::AutoRetType<S>;
+
+         private:
+        shape_t inputFoldedShape;
+        shape_t outputFoldedShape;
+        std::size_t inputElements;
+        std::size_t outputElements;
+        SyncDeviceInputBuffer<uint8_t> input;
+        SyncDeviceOutputBuffer<uint8_t> output;
+        Finn::vector<uint8_t> unpackScratch;
+
+        static std::string loggerPrefix() { return "[DeviceLaunch] "; }
+
+         public:
+        /**
+         * @brief Create the buffer objects for the first input and output kernel of a device
+         *
+         * @param device XRT device
+         * @param uuid UUID of the loaded xclbin
+         * @param devWrap Description of the device
+         * @param batchSize Batch size of every launch
+         */
+        DeviceLaunch(xrt::device& device, xrt::uuid& uuid, const DeviceWrapper& devWrap, unsigned int batchSize)
+            : inputFoldedShape(static_cast<Finn::ExtendedBufferDescriptor*>(devWrap.idmas[0].get())->foldedShape),
+              outputFoldedShape(static_cast<Finn::ExtendedBufferDescriptor*>(devWrap.odmas[0].get())->foldedShape),
+              inputElements(0),
+              outputElements(0),
+              input(devWrap.idmas[0]->kernelName, device, uuid, devWrap.idmas[0]->packedShape, batchSize),
+              output(devWrap.odmas[0]->kernelName, device, uuid, devWrap.odmas[0]->packedShape, batchSize) {
+            inputFoldedShape[0] = outputFoldedShape[0] = batchSize;
+            inputElements = FinnUtils::shapeToElements(inputFoldedShape);
+            outputElements = FinnUtils::shapeToElements(outputFoldedShape);
+            input.setMapType(devWrap.idmas[0]->mapType);
+            output.setMapType(devWrap.odmas[0]->mapType);
+            unpackScratch.resize(output.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE));
+        }
+
+        DeviceLaunch(DeviceLaunch&& other) = delete;
+        DeviceLaunch(const DeviceLaunch& other) = delete;
+        DeviceLaunch& operator=(DeviceLaunch&& other) = delete;
+        DeviceLaunch& operator=(const DeviceLaunch& other) = delete;
+        ~DeviceLaunch() = default;
+
+        /**
+         * @brief Pack one batch straight into the map of the input buffer. Does not allocate.
+         *
+         * @param data Unpacked input of one batch
+         * @return std::size_t Number of packed bytes
+         */
+        std::size_t pack(std::span<const InputType> data) {
+            if (data.size() != inputElements) {
+                FinnUtils::logAndError<std::invalid_argument>(loggerPrefix() + "Input of " + std::to_string(data.size()) + " elements does not match the expected " + std::to_string(inputElements) + " elements!");
+            }
+            return Finn::packMultiDimensionalInputs<F, InputType>(data, inputFoldedShape.back(), input.getMapView(), input.getMapType());
+        }
+
+        /**
+         * @brief Run the kernels on the packed input and wait until the output is written
+         *
+         * @return true
+         * @return false The launch failed
+         */
+        bool run() {
+            // Start the output kernel first, as the DeviceHandler does
+            return output.run() && input.run() && output.wait();
+        }
+
+        /**
+         * @brief Make the next run rewrite the kernel registers. Needed if other buffers ran the same kernels in between.
+         *
+         */
+        void invalidateRegisterCache() {
+            input.invalidateRegisterCache();
+            output.invalidateRegisterCache();
+        }
+
+        /**
+         * @brief Read the output of the last run and unpack it into a destination. Does not allocate.
+         *
+         * @param destination Destination of outputSize() elements
+         */
+        void unpack(std::span<OutputType> destination) {
+            if (destination.size() != outputElements) {
+                FinnUtils::logAndError<std::invalid_argument>(loggerPrefix() + "Output destination of " + std::to_string(destination.size()) + " elements does not match the expected " + std::to_string(outputElements) + " elements!");
+            }
+            output.read();
+            output.getData(unpackScratch);
+            Finn::unpackMultiDimensionalOutputs<S, OutputType>(unpackScratch, outputFoldedShape, destination);
+        }
+
+        /**
+         * @brief Read the output of the last run and unpack it
+         *
+         * @return Finn::vector<OutputType>
+         */
+        Finn::vector<OutputType> unpack() {
+            Finn::vector<OutputType> ret(outputElements);
+            unpack(ret);
+            return ret;
+        }
+
+        /**
+         * @brief Number of unpacked input elements of one batch
+         *
+         * @return std::size_t
+         */
+        std::size_t inputSize() const { return inputElements; }
+
+        /**
+         * @brief Number of unpacked output elements of one batch
+         *
+         * @return std::size_t
+         */
+        std::size_t outputSize() const { return outputElements; }
+
+        /**
+         * @brief Number of packed output bytes of one batch
+         *
+         * @return std::size_t
+         */
+        std::size_t outputBytes() const { return unpackScratch.size(); }
+
+        /**
+         * @brief Get the input buffer
+         *
+         * @return SyncDeviceInputBuffer<uint8_t>&
+         */
+        SyncDeviceInputBuffer<uint8_t>& getInputBuffer() { return input; }
+
+        /**
+         * @brief Get the output buffer
+         *
+         * @return SyncDeviceOutputBuffer<uint8_t>&
+         */
+        SyncDeviceOutputBuffer<uint8_t>& getOutputBuffer() { return output; }
+    };
+}  // namespace Finn
+
+#endif  // DEVICELAUNCH_HPP
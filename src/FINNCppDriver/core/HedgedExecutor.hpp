@@ -0,0 +1,609 @@
+/**
+ * @file HedgedExecutor.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Execution over several devices that relaunches slow requests on an idle device to cut the tail latency
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef HEDGEDEXECUTOR_HPP
+#define HEDGEDEXECUTOR_HPP
+
+#include <FINNCppDriver/utils/ConfigurationStructs.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/core/DeviceBuffer/SyncDeviceBuffers.hpp>
+#include <FINNCppDriver/core/DeviceHandler.h>
+#include <FINNCppDriver/core/DeviceLaunch.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_uuid.h"
+
+namespace Finn {
+    /**
+     * @brief Configuration of a HedgedExecutor
+     *
+     */
+    struct HedgeOptions {
+        /**
+         * @brief Relaunch slow latency critical requests. If false, the executor only distributes requests over the devices.
+         *
+         */
+        bool enabled = true;
+        /**
+         * @brief A request is relaunched once it ran longer than this percentile of the recent launch latencies
+         *
+         */
+        double percentile = 0.95;
+        /**
+         * @brief Maximum extra device work, as the fraction of duplicate launches to latency critical requests
+         *
+         */
+        double budget = 0.05;
+        /**
+         * @brief Number of recent launch latencies the percentile is computed from
+         *
+         */
+        std::size_t window = 1024;
+        /**
+         * @brief Launches measured before the first relaunch
+         *
+         */
+        std::size_t minSamples = 64;
+        /**
+         * @brief Lower bound of the hedge delay, so that scheduling noise of fast kernels does not spend the budget
+         *
+         */
+        std::chrono::microseconds minDelay{0};
+        /**
+         * @brief Batch size of every launch
+         *
+         */
+        unsigned int batchSize = 1;
+    };
+
+    /**
+     * @brief Counters of a HedgedExecutor
+     *
+     */
+    struct HedgeStatistics {
+        /**
+         * @brief Submitted requests
+         *
+         */
+        std::size_t requests = 0;
+        /**
+         * @brief Submitted requests that were allowed to be relaunched
+         *
+         */
+        std::size_t critical = 0;
+        /**
+         * @brief Duplicate launches on a second device
+         *
+         */
+        std::size_t hedges = 0;
+        /**
+         * @brief Requests answered by their duplicate launch
+         *
+         */
+        std::size_t hedgeWins = 0;
+        /**
+         * @brief Slow requests that were not relaunched, because the budget was spent
+         *
+         */
+        std::size_t budgetDenied = 0;
+        /**
+         * @brief Queued launches that were skipped, because the request was answered before they started
+         *
+         */
+        std::size_t cancelled = 0;
+        /**
+         * @brief Finished launches whose result was discarded, because the request was already answered
+         *
+         */
+        std::size_t discarded = 0;
+        /**
+         * @brief Current hedge delay in ns, 0 while the latencies are still learned
+         *
+         */
+        uint64_t hedgeDelayNs = 0;
+    };
+
+    /**
+     * @brief Runs one model on all devices of a configuration and hedges latency critical requests.
+     *
+     * Every device owns its buffer objects, scratch memory, request queue and worker thread. Requests go to the least loaded device. Once a latency
+     * critical request has been running on its device for longer than a learned percentile of the recent launch latencies, a hedger thread launches
+     * a duplicate on an idle device. The first successful result answers the request and the other one is discarded; a duplicate that is still
+     * queued when the request is answered is skipped. Duplicates are limited by a budget relative to the number of latency critical requests.
+     * All devices have to be programmed with the same bitstream. The executor is meant for applications that embed the driver, the finn binary does
+     * not use it.
+     *
+     * @tparam F FINN input datatype
+     * @tparam S FINN output datatype
+     */
+    template<IsDatatype F, IsDatatype S>
+    class HedgedExecutor {
+         public:
+        /**
+         * @brief Element type of unpacked inputs
+         *
+         */
+        using InputType = UnpackingAutoRetType::AutoRetType<F>;
+        /**
+         * @brief Element type of unpacked outputs
+         *
+         */
+        using OutputType = UnpackingAutoRetType::AutoRetType<S>;
+
+         private:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief A request and the state of its launches. Shared between the launches, members after the input are protected by the mutex.
+         *
+         */
+        struct Request {
+            Finn::vector<InputType> input;
+            bool critical = true;
+            std::size_t primary = 0;
+            std::mutex mutex;
+            std::promise<Finn::vector<OutputType>> result;
+            bool done = false;
+            unsigned int outstanding = 1;
+            Clock::time_point started;
+        };
+
+        struct Launch {
+            std::shared_ptr<Request> request;
+            bool hedge = false;
+        };
+
+        /**
+         * @brief Result of one launch and the bytes it moved, which are only recorded for the launch that answers the request
+         *
+         */
+        struct Served {
+            Finn::vector<OutputType> result;
+            std::size_t inputBytes = 0;
+            std::size_t outputBytes = 0;
+        };
+
+        /**
+         * @brief Everything a device owns. Aligned to cache lines, so that devices do not share any written cache line.
+         *
+         */
+        struct alignas(64) Device {
+            std::size_t index = 0;
+            unsigned int xrtDeviceIndex = 0;
+            xrt::device device;
+            xrt::uuid uuid;
+            std::unique_ptr<DeviceLaunch<F, S>> launch;
+
+            std::mutex queueMutex;
+            std::condition_variable_any queueCondition;
+            std::deque<Launch> queue;
+
+            std::atomic<std::size_t> load{0};
+            std::atomic<std::size_t> launches{0};
+#ifdef UNITTEST
+            std::atomic<int64_t> testDelayUs{0};
+#endif
+            std::jthread worker;
+        };
+
+        HedgeOptions options;
+        std::vector<std::unique_ptr<Device>> deviceList;
+        std::atomic<std::size_t> cursor{0};
+
+        std::mutex latencyMutex;
+        std::vector<uint64_t> latencyWindow;
+        std::size_t latencySamples = 0;
+        std::atomic<uint64_t> hedgeDelayNs{0};
+
+        std::mutex inflightMutex;
+        std::condition_variable_any inflightCondition;
+        std::list<std::shared_ptr<Request>> inflight;
+        std::size_t inflightVersion = 0;
+        std::jthread hedger;
+
+        std::atomic<std::size_t> requests{0};
+        std::atomic<std::size_t> critical{0};
+        std::atomic<std::size_t> hedges{0};
+        std::atomic<std::size_t> hedgeWins{0};
+        std::atomic<std::size_t> budgetDenied{0};
+        std::atomic<std::size_t> cancelled{0};
+        std::atomic<std::size_t> discarded{0};
+        logger_type& logger = Logger::getLogger();
+
+        static std::string loggerPrefix() { return "[HedgedExecutor] "; }
+
+        /**
+         * @brief The hedge delay is refreshed every refreshInterval launches
+         *
+         */
+        static constexpr std::size_t refreshInterval = 16;
+
+        void recordLatency(uint64_t ns) {
+            const std::lock_guard lock(latencyMutex);
+            latencyWindow[latencySamples % latencyWindow.size()] = ns;
+            ++latencySamples;
+            if (latencySamples < options.minSamples || (latencySamples != options.minSamples && latencySamples % refreshInterval != 0)) {
+                return;
+            }
+            std::vector<uint64_t> sorted(latencyWindow.begin(), latencyWindow.begin() + static_cast<std::ptrdiff_t>(std::min(latencySamples, latencyWindow.size())));
+            const auto rank = sorted.begin() + static_cast<std::ptrdiff_t>(options.percentile * static_cast<double>(sorted.size() - 1));
+            std::nth_element(sorted.begin(), rank, sorted.end());
+            const auto minDelayNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(options.minDelay).count());
+            hedgeDelayNs.store(std::max({*rank, minDelayNs, uint64_t{1}}), std::memory_order_relaxed);
+        }
+
+        Served process(Device& device, Finn::vector<InputType>& input) {
+            FinnUtils::LiveStats::StageTimer packTimer(DRIVER_STAGE::PACK);
+            const std::size_t packedBytes = device.launch->pack(input);
+            packTimer.stop();
+
+            {
+                const FinnUtils::LiveStats::StageTimer executeTimer(DRIVER_STAGE::EXECUTE, device.xrtDeviceIndex);
+                if (!device.launch->run()) {
+                    FinnUtils::logAndError<std::runtime_error>(loggerPrefix() + "Launch on device " + std::to_string(device.xrtDeviceIndex) + " failed!");
+                }
+#ifdef UNITTEST
+                std::this_thread::sleep_for(std::chrono::microseconds(device.testDelayUs.load(std::memory_order_relaxed)));
+#endif
+            }
+
+            const FinnUtils::LiveStats::StageTimer unpackTimer(DRIVER_STAGE::UNPACK);
+            return Served{device.launch->unpack(), packedBytes, device.launch->outputBytes()};
+        }
+
+        /**
+         * @brief Answer the request with the result of a launch, unless another launch answered it already. A failed launch only answers the request
+         * if no other launch is outstanding.
+         *
+         */
+        void finish(Request& request, bool hedge, std::optional<Served> served, const std::exception_ptr& error) {
+            const std::lock_guard lock(request.mutex);
+            --request.outstanding;
+            if (request.done) {
+                discarded.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (!error) {
+                request.done = true;
+                // Counted before the result is visible to the caller. A hedged request is one inference, however many launches it took.
+                FinnUtils::LiveStats::recordInference(served->inputBytes, served->outputBytes, options.batchSize);
+                if (hedge) {
+                    hedgeWins.fetch_add(1, std::memory_order_relaxed);
+                    FinnUtils::LiveStats::recordHedgeWin();
+                }
+                request.result.set_value(std::move(served->result));
+            } else if (request.outstanding == 0) {
+                request.done = true;
+                request.result.set_exception(error);
+            }
+        }
+
+        void serve(Device& device, const Launch& launch) {
+            Request& request = *launch.request;
+            {
+                const std::lock_guard lock(request.mutex);
+                if (request.done) {
+                    --request.outstanding;
+                    cancelled.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                if (!launch.hedge) {
+                    request.started = Clock::now();
+                }
+            }
+            // Only the launch on the primary device is watched, a request is hedged at most once
+            if (!launch.hedge && request.critical && options.enabled && hedgeDelayNs.load(std::memory_order_relaxed) != 0) {
+                {
+                    const std::lock_guard lock(inflightMutex);
+                    inflight.emplace_back(launch.request);
+                    ++inflightVersion;
+                }
+                inflightCondition.notify_one();
+            }
+
+            device.launches.fetch_add(1, std::memory_order_relaxed);
+            const auto start = Clock::now();
+            try {
+                auto served = process(device, request.input);
+                recordLatency(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+                finish(request, launch.hedge, std::move(served), nullptr);
+            } catch (...) {
+                finish(request, launch.hedge, std::nullopt, std::current_exception());
+            }
+        }
+
+        void run(Device& device, std::stop_token stoken) {
+            while (true) {
+                Launch launch;
+                {
+                    std::unique_lock lock(device.queueMutex);
+                    // The predicate holds as long as launches are queued, so the stop request is checked separately to not drain the queue on destruction
+                    if (!device.queueCondition.wait(lock, stoken, [&device]() { return !device.queue.empty(); }) || stoken.stop_requested()) {
+                        break;
+                    }
+                    launch = std::move(device.queue.front());
+                    device.queue.pop_front();
+                }
+                serve(device, launch);
+                device.load.fetch_sub(1, std::memory_order_relaxed);
+            }
+            // Launches that were not served anymore
+            const std::lock_guard lock(device.queueMutex);
+            for (auto& launch : device.queue) {
+                finish(*launch.request, launch.hedge, std::nullopt, std::make_exception_ptr(std::runtime_error("HedgedExecutor was destroyed before the request was served")));
+            }
+            device.queue.clear();
+        }
+
+        void enqueue(Device& device, Launch launch) {
+            device.load.fetch_add(1, std::memory_order_relaxed);
+            {
+                const std::lock_guard lock(device.queueMutex);
+                device.queue.emplace_back(std::move(launch));
+            }
+            device.queueCondition.notify_one();
+        }
+
+        Device* idleDevice(std::size_t except) {
+            const std::size_t offset = cursor.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < deviceList.size(); ++i) {
+                Device& device = *deviceList[(offset + i) % deviceList.size()];
+                if (device.index != except && device.load.load(std::memory_order_relaxed) == 0) {
+                    return &device;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Try to relaunch a request that missed its deadline
+         *
+         * @return true The request does not need to be watched anymore
+         * @return false No device is idle, retry later
+         */
+        bool hedge(const std::shared_ptr<Request>& request) {
+            const auto allowed = options.budget * static_cast<double>(critical.load(std::memory_order_relaxed));
+            if (static_cast<double>(hedges.load(std::memory_order_relaxed) + 1) > allowed) {
+                budgetDenied.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            Device* target = idleDevice(request->primary);
+            if (target == nullptr) {
+                return false;
+            }
+            {
+                const std::lock_guard lock(request->mutex);
+                if (request->done) {
+                    return true;
+                }
+                ++request->outstanding;
+            }
+            hedges.fetch_add(1, std::memory_order_relaxed);
+            FinnUtils::LiveStats::recordHedge();
+            enqueue(*target, Launch{request, true});
+            return true;
+        }
+
+        void watch(std::stop_token stoken) {
+            std::unique_lock lock(inflightMutex);
+            while (!stoken.stop_requested()) {
+                const std::chrono::nanoseconds delay(hedgeDelayNs.load(std::memory_order_relaxed));
+                // Without an idle device, the deadline is checked again after a fraction of the delay
+                const auto retry = std::max<Clock::duration>(delay / 4, std::chrono::microseconds(10));
+                const auto now = Clock::now();
+                auto next = Clock::time_point::max();
+                for (auto it = inflight.begin(); it != inflight.end();) {
+                    Clock::time_point deadline;
+                    {
+                        const std::lock_guard requestLock((*it)->mutex);
+                        if ((*it)->done) {
+                            it = inflight.erase(it);
+                            continue;
+                        }
+                        deadline = (*it)->started + delay;
+                    }
+                    if (now < deadline) {
+                        next = std::min(next, deadline);
+                        ++it;
+                    } else if (hedge(*it)) {
+                        it = inflight.erase(it);
+                    } else {
+                        next = std::min(next, now + retry);
+                        ++it;
+                    }
+                }
+                const std::size_t version = inflightVersion;
+                auto changed = [this, version]() { return inflightVersion != version; };
+                if (next == Clock::time_point::max()) {
+                    inflightCondition.wait(lock, stoken, changed);
+                } else {
+                    inflightCondition.wait_until(lock, stoken, next, changed);
+                }
+            }
+        }
+
+         public:
+        /**
+         * @brief Set up all devices of the configuration and start their workers
+         *
+         * @param config Configuration of the accelerator. The first input and output kernel of every device are used.
+         * @param pOptions
+         */
+        HedgedExecutor(const Config& config, HedgeOptions pOptions) : options(std::move(pOptions)) {
+            if (config.deviceWrappers.empty()) {
+                FinnUtils::logAndError<std::invalid_argument>("Configuration does not contain a device!");
+            }
+            if (options.batchSize == 0 || options.window == 0) {
+                FinnUtils::logAndError<std::invalid_argument>("HedgedExecutor needs a batch size and a latency window of at least one!");
+            }
+            if (options.percentile < 0.0 || options.percentile > 1.0 || options.budget < 0.0) {
+                FinnUtils::logAndError<std::invalid_argument>("Hedge percentile has to be in [0, 1] and the hedge budget must not be negative!");
+            }
+            const DeviceWrapper& first = config.deviceWrappers[0];
+            latencyWindow.resize(options.window);
+
+            deviceList.reserve(config.deviceWrappers.size());
+            for (const auto& devWrap : config.deviceWrappers) {
+                DeviceHandler::checkDeviceWrapper(devWrap);
+                if (devWrap.idmas[0]->packedShape != first.idmas[0]->packedShape || devWrap.odmas[0]->packedShape != first.odmas[0]->packedShape) {
+                    FinnUtils::logAndError<std::invalid_argument>("Device " + std::to_string(devWrap.xrtDeviceIndex) + " runs a different model than device " + std::to_string(first.xrtDeviceIndex) + "!");
+                }
+                auto device = std::make_unique<Device>();
+                device->index = deviceList.size();
+                device->xrtDeviceIndex = devWrap.xrtDeviceIndex;
+                device->device = xrt::device(devWrap.xrtDeviceIndex);
+                device->uuid = device->device.load_xclbin(devWrap.xclbin);
+                device->launch = std::make_unique<DeviceLaunch<F, S>>(device->device, device->uuid, devWrap, options.batchSize);
+                deviceList.emplace_back(std::move(device));
+            }
+            // Workers are started last, so that no worker observes a partially constructed executor
+            for (auto& device : deviceList) {
+                device->worker = std::jthread([this, &device = *device](std::stop_token stoken) { run(device, stoken); });
+            }
+            hedger = std::jthread([this](std::stop_token stoken) { watch(stoken); });
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Started on " << deviceList.size() << " devices, hedging " << (options.enabled ? "enabled" : "disabled");
+        }
+
+        HedgedExecutor(HedgedExecutor&& other) = delete;
+        HedgedExecutor(const HedgedExecutor& other) = delete;
+        HedgedExecutor& operator=(HedgedExecutor&& other) = delete;
+        HedgedExecutor& operator=(const HedgedExecutor& other) = delete;
+
+        /**
+         * @brief Stop the hedger and all workers. Requests that are not answered yet fail with std::runtime_error.
+         *
+         */
+        ~HedgedExecutor() {
+            // The hedger enqueues launches, so it is stopped before the workers
+            hedger.request_stop();
+            if (hedger.joinable()) {
+                hedger.join();
+            }
+            for (auto& device : deviceList) {
+                device->worker.request_stop();
+            }
+            for (auto& device : deviceList) {
+                if (device->worker.joinable()) {
+                    device->worker.join();
+                }
+            }
+        }
+
+        /**
+         * @brief Queue a request on a specific device
+         *
+         * @param deviceIndex Index of the device in the configuration
+         * @param input Unpacked input of one batch
+         * @param latencyCritical Whether the request may be relaunched on another device if it is slow
+         * @return std::future<Finn::vector<OutputType>> Unpacked output. Holds std::invalid_argument if the input has the wrong size.
+         */
+        std::future<Finn::vector<OutputType>> submit(std::size_t deviceIndex, Finn::vector<InputType> input, bool latencyCritical = true) {
+            if (deviceIndex >= deviceList.size()) {
+                FinnUtils::logAndError<std::out_of_range>("Device " + std::to_string(deviceIndex) + " does not exist!");
+            }
+            auto request = std::make_shared<Request>();
+            request->input = std::move(input);
+            request->critical = latencyCritical;
+            request->primary = deviceIndex;
+            auto future = request->result.get_future();
+            requests.fetch_add(1, std::memory_order_relaxed);
+            if (latencyCritical) {
+                critical.fetch_add(1, std::memory_order_relaxed);
+            }
+            enqueue(*deviceList[deviceIndex], Launch{std::move(request), false});
+            return future;
+        }
+
+        /**
+         * @brief Queue a request on the least loaded device. Ties are broken round robin.
+         *
+         * @param input Unpacked input of one batch
+         * @param latencyCritical Whether the request may be relaunched on another device if it is slow
+         * @return std::future<Finn::vector<OutputType>>
+         */
+        std::future<Finn::vector<OutputType>> submit(Finn::vector<InputType> input, bool latencyCritical = true) {
+            const std::size_t offset = cursor.fetch_add(1, std::memory_order_relaxed);
+            std::size_t best = offset % deviceList.size();
+            for (std::size_t i = 1; i < deviceList.size(); ++i) {
+                const std::size_t candidate = (offset + i) % deviceList.size();
+                if (deviceList[candidate]->load.load(std::memory_order_relaxed) < deviceList[best]->load.load(std::memory_order_relaxed)) {
+                    best = candidate;
+                }
+            }
+            return submit(best, std::move(input), latencyCritical);
+        }
+
+        /**
+         * @brief Number of devices
+         *
+         * @return std::size_t
+         */
+        std::size_t devices() const { return deviceList.size(); }
+
+        /**
+         * @brief Number of unpacked input elements of one request
+         *
+         * @return std::size_t
+         */
+        std::size_t inputSize() const { return deviceList.front()->launch->inputSize(); }
+
+        /**
+         * @brief Number of launches a device started, including duplicates
+         *
+         * @param deviceIndex
+         * @return std::size_t
+         */
+        std::size_t getLaunches(std::size_t deviceIndex) const { return deviceList.at(deviceIndex)->launches.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the hedging counters
+         *
+         * @return HedgeStatistics
+         */
+        HedgeStatistics getStatistics() const {
+            return HedgeStatistics{requests.load(std::memory_order_relaxed),     critical.load(std::memory_order_relaxed),  hedges.load(std::memory_order_relaxed),
+                                   hedgeWins.load(std::memory_order_relaxed),    budgetDenied.load(std::memory_order_relaxed), cancelled.load(std::memory_order_relaxed),
+                                   discarded.load(std::memory_order_relaxed),    hedgeDelayNs.load(std::memory_order_relaxed)};
+        }
+
+#ifdef UNITTEST
+        void testSetDelay(std::size_t deviceIndex, std::chrono::microseconds delay) { deviceList.at(deviceIndex)->testDelayUs.store(delay.count(), std::memory_order_relaxed); }
+        SyncDeviceOutputBuffer<uint8_t>& testGetOutputBuffer(std::size_t deviceIndex) { return deviceList.at(deviceIndex)->launch->getOutputBuffer(); }
+#endif
+    };
+}  // namespace Finn
+
+#endif  // HEDGEDEXECUTOR_HPP
@@ -0,0 +1,363 @@
+/**
+ * @file ModelRegistry.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Hosts several FINN models in one process and routes requests by model name to the replicas carrying the model
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef MODELREGISTRY_HPP
+#define MODELREGISTRY_HPP
+
+#include <FINNCppDriver/utils/ConfigurationStructs.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/core/BaseDriver.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace Finn {
+    /**
+     * @brief Counters of one hosted model
+     *
+     */
+    struct ModelStatistics {
+        /**
+         * @brief Requests served by the model
+         *
+         */
+        std::size_t requests = 0;
+        /**
+         * @brief Requests currently running or waiting for a replica
+         *
+         */
+        std::size_t inFlight = 0;
+        /**
+         * @brief Requests served by every replica, in registration order
+         *
+         */
+        std::vector<std::size_t> replicaRequests;
+    };
+
+    /**
+     * @brief Hosts several models, each with its own config and FINN datatypes, in one process.
+     *
+     * Every registered config becomes a replica of the model it was registered for. Requests are routed by model name and balanced between
+     * the replicas of a model: the replica with the fewest requests in flight is used, ties are broken round robin. A replica serves one
+     * request at a time, requests to different replicas run concurrently. The OpenMP thread pool used for packing and the logger are shared
+     * by all models.
+     *
+     */
+    class ModelRegistry {
+         private:
+        /**
+         * @brief Type erased replica of a model
+         *
+         */
+        class Replica {
+             public:
+            std::mutex mutex;
+            std::atomic<std::size_t> inFlight{0};
+            std::atomic<std::size_t> requests{0};
+
+            Replica() = default;
+            Replica(Replica&&) = delete;
+            Replica(const Replica&) = delete;
+            Replica& operator=(Replica&&) = delete;
+            Replica& operator=(const Replica&) = delete;
+            virtual ~Replica() = default;
+
+            virtual Finn::vector<uint8_t> inferRaw(std::span<const uint8_t> packed) = 0;
+            virtual std::size_t size(SIZE_SPECIFIER ss, bool input) = 0;
+        };
+
+        /**
+         * @brief Replica driven by a synchronous BaseDriver with the datatypes of the model
+         *
+         * @tparam F FINN input datatype
+         * @tparam S FINN output datatype
+         */
+        template<IsDatatype F, IsDatatype S>
+        class HostedDriver : public Replica, public BaseDriver<true, F, S> {
+            using Base = BaseDriver<true, F, S>;
+            uint inputDevice;
+            std::string inputKernel;
+            uint outputDevice;
+            std::string outputKernel;
+
+             public:
+            HostedDriver(const Config& pConfig, uint batchSize)
+                : Base(pConfig, batchSize),
+                  inputDevice(pConfig.deviceWrappers[0].xrtDeviceIndex),
+                  inputKernel(pConfig.deviceWrappers[0].idmas[0]->kernelName),
+                  outputDevice(pConfig.deviceWrappers[0].xrtDeviceIndex),
+                  outputKernel(pConfig.deviceWrappers[0].odmas[0]->kernelName) {}
+
+            Finn::vector<uint8_t> inferRaw(std::span<const uint8_t> packed) override {
+                return Base::infer(packed.begin(), packed.end(), inputDevice, inputKernel, outputDevice, outputKernel, Base::getBatchSize(), true);
+            }
+
+            std::size_t size(SIZE_SPECIFIER ss, bool input) override { return input ? Base::size(ss, inputDevice, inputKernel) : Base::size(ss, outputDevice, outputKernel); }
+        };
+
+        /**
+         * @brief All replicas of one model
+         *
+         */
+        struct Model {
+            std::type_index inputType;
+            std::type_index outputType;
+            std::vector<std::shared_ptr<Replica>> replicas;
+            std::atomic<std::size_t> cursor{0};
+
+            Model(std::type_index pInputType, std::type_index pOutputType) : inputType(pInputType), outputType(pOutputType) {}
+        };
+
+        /**
+         * @brief Reserves a replica for one request
+         *
+         */
+        class Lease {
+            Replica& replica;
+            std::unique_lock<std::mutex> lock;
+
+             public:
+            explicit Lease(Replica& pReplica) : replica(pReplica) {
+                replica.inFlight.fetch_add(1, std::memory_order_relaxed);
+                lock = std::unique_lock(replica.mutex);
+            }
+            Lease(Lease&&) = delete;
+            Lease(const Lease&) = delete;
+            Lease& operator=(Lease&&) = delete;
+            Lease& operator=(const Lease&) = delete;
+            ~Lease() {
+                replica.requests.fetch_add(1, std::memory_order_relaxed);
+                replica.inFlight.fetch_sub(1, std::memory_order_relaxed);
+            }
+            Replica& operator*() { return replica; }
+            Replica* operator->() { return &replica; }
+        };
+
+        mutable std::shared_mutex modelsMutex;
+        std::unordered_map<std::string, std::shared_ptr<Model>> models;
+        logger_type& logger = Logger::getLogger();
+
+        /**
+         * @brief A logger prefix to determine the source of a log write
+         *
+         * @return std::string
+         */
+        static std::string loggerPrefix() { return "[ModelRegistry] "; }
+
+        std::shared_ptr<Model> findModel(const std::string& name) const {
+            const std::shared_lock lock(modelsMutex);
+            auto it = models.find(name);
+            if (it == models.end()) {
+                FinnUtils::logAndError<std::invalid_argument>("Unknown model " + name + "!");
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Select the replica with the fewest requests in flight. Scanning starts at a rotating cursor, so that idle replicas are used round robin.
+         *
+         */
+        static Replica& selectReplica(Model& model) {
+            const std::size_t count = model.replicas.size();
+            const std::size_t start = model.cursor.fetch_add(1, std::memory_order_relaxed);
+            Replica* best = model.replicas[start % count].get();
+            for (std::size_t i = 1; i < count && best->inFlight.load(std::memory_order_relaxed) != 0; ++i) {
+                Replica* candidate = model.replicas[(start + i) % count].get();
+                if (candidate->inFlight.load(std::memory_order_relaxed) < best->inFlight.load(std::memory_order_relaxed)) {
+                    best = candidate;
+                }
+            }
+            return *best;
+        }
+
+         public:
+        ModelRegistry() = default;
+        ModelRegistry(ModelRegistry&&) = delete;
+        ModelRegistry(const ModelRegistry&) = delete;
+        ModelRegistry& operator=(ModelRegistry&&) = delete;
+        ModelRegistry& operator=(const ModelRegistry&) = delete;
+        ~ModelRegistry() = default;
+
+        /**
+         * @brief Add a replica of a model. The first registration of a name creates the model, further registrations add load balanced replicas.
+         * All replicas of a model have to use the same datatypes.
+         *
+         * @tparam F FINN input datatype of the model
+         * @tparam S FINN output datatype of the model
+         * @param name Name used to route requests to the model
+         * @param config Config of the devices carrying this replica
+         * @param batchSize
+         * @return std::size_t Index of the new replica
+         */
+        template<IsDatatype F, IsDatatype S>
+        std::size_t registerModel(const std::string& name, const Config& config, uint batchSize) {
+            auto replica = std::make_shared<HostedDriver<F, S>>(config, batchSize);
+            const std::unique_lock lock(modelsMutex);
+            auto& model = models[name];
+            if (!model) {
+                model = std::make_shared<Model>(typeid(F), typeid(S));
+            } else if (model->inputType != typeid(F) || model->outputType != typeid(S)) {
+                FinnUtils::logAndError<std::invalid_argument>("Replicas of model " + name + " have to use the same datatypes!");
+            }
+            // Running requests hold a reference to the current model, so the replica list is copied and published as a new model
+            auto updated = std::make_shared<Model>(model->inputType, model->outputType);
+            updated->replicas = model->replicas;
+            updated->replicas.emplace_back(std::move(replica));
+            model = updated;
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Registered replica " << model->replicas.size() - 1 << " of model " << name << " on device " << config.deviceWrappers[0].xrtDeviceIndex;
+            return model->replicas.size() - 1;
+        }
+
+        /**
+         * @brief Remove a model and all its replicas. Requests that are already running finish on the removed replicas.
+         *
+         * @param name
+         * @return true The model was removed
+         * @return false No model with this name was registered
+         */
+        bool unregisterModel(const std::string& name) {
+            const std::unique_lock lock(modelsMutex);
+            return models.erase(name) != 0;
+        }
+
+        /**
+         * @brief Check if a model is registered
+         *
+         * @param name
+         * @return true
+         * @return false
+         */
+        bool contains(const std::string& name) const {
+            const std::shared_lock lock(modelsMutex);
+            return models.contains(name);
+        }
+
+        /**
+         * @brief Get the names of all registered models
+         *
+         * @return std::vector<std::string>
+         */
+        std::vector<std::string> modelNames() const {
+            const std::shared_lock lock(modelsMutex);
+            std::vector<std::string> names;
+            names.reserve(models.size());
+            for (const auto& [name, model] : models) {
+                names.emplace_back(name);
+            }
+            return names;
+        }
+
+        /**
+         * @brief Get the number of replicas of a model
+         *
+         * @param name
+         * @return std::size_t
+         */
+        std::size_t replicas(const std::string& name) const { return findModel(name)->replicas.size(); }
+
+        /**
+         * @brief Return the size (type specified by SIZE_SPECIFIER) of the input or output buffer of a model
+         *
+         * @param name
+         * @param ss
+         * @param input Size of the input buffer if true, else of the output buffer
+         * @return std::size_t
+         */
+        std::size_t size(const std::string& name, SIZE_SPECIFIER ss, bool input = true) const { return findModel(name)->replicas.front()->size(ss, input); }
+
+        /**
+         * @brief Run an inference on already packed data
+         *
+         * @param name Model to run
+         * @param packed Packed input data for one batch
+         * @return Finn::vector<uint8_t> Packed output data
+         */
+        [[nodiscard]] Finn::vector<uint8_t> inferRaw(const std::string& name, std::span<const uint8_t> packed) {
+            auto model = findModel(name);
+            Lease replica(selectReplica(*model));
+            return replica->inferRaw(packed);
+        }
+
+        /**
+         * @brief Run an inference on unpacked data. The datatypes have to match the ones the model was registered with.
+         *
+         * @tparam F FINN input datatype of the model
+         * @tparam S FINN output datatype of the model
+         * @tparam IteratorType
+         * @tparam V Type of the unpacked output
+         * @param name Model to run
+         * @param first Iterator to first element of input
+         * @param last  Iterator to end of input
+         * @return Finn::vector<V>
+         */
+        template<IsDatatype F, IsDatatype S, typename IteratorType, typename V = Finn::UnpackingAutoRetType::AutoRetType<S>>
+        [[nodiscard]] Finn::vector<V> infer(const std::string& name, IteratorType first, IteratorType last) {
+            auto model = findModel(name);
+            if (model->inputType != typeid(F) || model->outputType != typeid(S)) {
+                FinnUtils::logAndError<std::invalid_argument>("Datatypes do not match the datatypes of model " + name + "!");
+            }
+            Lease replica(selectReplica(*model));
+            return static_cast<HostedDriver<F, S>&>(*replica).template inferSynchronous<IteratorType, V>(first, last);
+        }
+
+        /**
+         * @brief Get a snapshot of the counters of a model
+         *
+         * @param name
+         * @return ModelStatistics
+         */
+        ModelStatistics getStatistics(const std::string& name) const {
+            auto model = findModel(name);
+            ModelStatistics stats;
+            for (const auto& replica : model->replicas) {
+                const std::size_t requests = replica->requests.load(std::memory_order_relaxed);
+                stats.requests += requests;
+                stats.inFlight += replica->inFlight.load(std::memory_order_relaxed);
+                stats.replicaRequests.emplace_back(requests);
+            }
+            return stats;
+        }
+
+        /**
+         * @brief Log the counters of all models
+         *
+         */
+        void logStatistics() const {
+            for (const auto& name : modelNames()) {
+                const auto stats = getStatistics(name);
+                std::stringstream sstream;
+                sstream << loggerPrefix() << name << ": " << stats.requests << " requests, " << stats.inFlight << " in flight, per replica:";
+                for (auto requests : stats.replicaRequests) {
+                    sstream << " " << requests;
+                }
+                FINN_LOG(logger, loglevel::info) << sstream.str();
+            }
+        }
+    };
+}  // namespace Finn
+
+#endif  // MODELREGISTRY_HPP
@@ -0,0 +1,383 @@
+/**
+ * @file ShardedExecutor.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Thread per core execution over one device. Every pinned shard owns its buffer objects and codec scratch memory and only shares a launch arbiter
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef SHARDEDEXECUTOR_HPP
+#define SHARDEDEXECUTOR_HPP
+
+#include <FINNCppDriver/utils/ConfigurationStructs.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <FINNCppDriver/core/DeviceBuffer/SyncDeviceBuffers.hpp>
+#include <FINNCppDriver/core/DeviceHandler.h>
+#include <FINNCppDriver/core/DeviceLaunch.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_uuid.h"
+
+namespace Finn {
+    /**
+     * @brief Configuration of a ShardedExecutor
+     *
+     */
+    struct ShardOptions {
+        /**
+         * @brief Number of shards, each served by its own worker thread
+         *
+         */
+        std::size_t shards = 2;
+        /**
+         * @brief Core the worker of shard i is pinned to is cores[i % cores.size()]. Workers are not pinned if empty.
+         *
+         */
+        std::vector<int> cores;
+        /**
+         * @brief Batch size of every launch
+         *
+         */
+        unsigned int batchSize = 1;
+    };
+
+    /**
+     * @brief Counters of one shard
+     *
+     */
+    struct ShardStatistics {
+        /**
+         * @brief Requests served by the shard, including failed ones
+         *
+         */
+        std::size_t requests = 0;
+        /**
+         * @brief Requests that completed with an error
+         *
+         */
+        std::size_t failures = 0;
+        /**
+         * @brief Time the shard waited for the launch arbiter in ns
+         *
+         */
+        std::size_t arbiterWaitNs = 0;
+        /**
+         * @brief Core the worker runs on, -1 if it is not pinned
+         *
+         */
+        int core = -1;
+    };
+
+    /**
+     * @brief Shard per core execution of one model over one device.
+     *
+     * Instead of one driver shared behind locks, every shard owns a private input and output buffer object of the device, private scratch memory
+     * for unpacking and a worker thread that can be pinned to a core. Inputs are packed straight into the map of the input buffer and outputs are unpacked
+     * into the output vector of the request, so a shard does not allocate for requests that recycle an output vector.
+     * The worker runs the whole pack, launch and unpack loop of its requests. The only state shared between shards is the launch arbiter of the device, which serializes the kernel runs, since the kernels
+     * process one buffer at a time. Packing, transfers and unpacking of different shards overlap freely.
+     *
+     * Requests are queued per shard; submit() without a shard index distributes them round robin.
+     *
+     * @tparam F FINN input datatype
+     * @tparam S FINN output datatype
+     */
+    template<IsDatatype F, IsDatatype S>
+    class ShardedExecutor {
+         public:
+        /**
+         * @brief Element type of unpacked inputs
+         *
+         */
+        using InputType = UnpackingAutoRetType::AutoRetType<F>;
+        /**
+         * @brief Element type of unpacked outputs
+         *
+         */
+        using OutputType = UnpackingAutoRetType::AutoRetType<S>;
+
+         private:
+        struct Request {
+            Finn::vector<InputType> input;
+            Finn::vector<OutputType> output;
+            std::promise<Finn::vector<OutputType>> result;
+        };
+
+        /**
+         * @brief Launch arbiter of the device. Remembers which shard programmed the kernel registers last.
+         *
+         */
+        struct LaunchArbiter {
+            std::mutex mutex;
+            std::size_t lastShard = SIZE_MAX;
+        };
+
+        /**
+         * @brief Everything a shard owns. Aligned to cache lines, so that shards do not share any written cache line.
+         *
+         */
+        struct alignas(64) Shard {
+            std::size_t index = 0;
+            int core = -1;
+            std::unique_ptr<DeviceLaunch<F, S>> launch;
+
+            std::mutex queueMutex;
+            std::condition_variable_any queueCondition;
+            std::deque<Request> queue;
+
+            std::atomic<std::size_t> requests{0};
+            std::atomic<std::size_t> failures{0};
+            std::atomic<std::size_t> arbiterWaitNs{0};
+            std::jthread worker;
+        };
+
+        ShardOptions options;
+        xrt::device device;
+        xrt::uuid uuid;
+        unsigned int deviceIndex;
+        LaunchArbiter arbiter;
+        std::vector<std::unique_ptr<Shard>> shardList;
+        std::atomic<std::size_t> cursor{0};
+        logger_type& logger = Logger::getLogger();
+
+        static std::string loggerPrefix() { return "[ShardedExecutor] "; }
+
+        /**
+         * @brief Pin a thread to a core
+         *
+         * @param thread
+         * @param core
+         * @return true
+         * @return false Pinning is not permitted, e.g. because the core is not part of the cpuset of the process
+         */
+        static bool pinThread(std::jthread& thread, int core) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(core, &set);
+            return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+        }
+
+        /**
+         * @brief Pack, launch and unpack one request. Does not allocate if the output already has the capacity of one batch.
+         *
+         * @param shard
+         * @param input Unpacked input of one batch
+         * @param output Destination of the unpacked output, resized to one batch
+         */
+        void process(Shard& shard, std::span<const InputType> input, Finn::vector<OutputType>& output) {
+            FinnUtils::LiveStats::StageTimer packTimer(DRIVER_STAGE::PACK);
+            const std::size_t packedBytes = shard.launch->pack(input);
+            packTimer.stop();
+
+            {
+                const auto waitStart = std::chrono::steady_clock::now();
+                const std::lock_guard lock(arbiter.mutex);
+                shard.arbiterWaitNs.fetch_add(static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStart).count()), std::memory_order_relaxed);
+                // The kernels still hold the buffer addresses of the last shard that launched
+                if (arbiter.lastShard != shard.index) {
+                    shard.launch->invalidateRegisterCache();
+                    arbiter.lastShard = shard.index;
+                }
+                const FinnUtils::LiveStats::StageTimer executeTimer(DRIVER_STAGE::EXECUTE, deviceIndex);
+                if (!shard.launch->run()) {
+                    FinnUtils::logAndError<std::runtime_error>(loggerPrefix() + "Launch of shard " + std::to_string(shard.index) + " failed!");
+                }
+            }
+
+            const FinnUtils::LiveStats::StageTimer unpackTimer(DRIVER_STAGE::UNPACK);
+            output.resize(shard.launch->outputSize());
+            shard.launch->unpack(output);
+            FinnUtils::LiveStats::recordInference(packedBytes, shard.launch->outputBytes(), options.batchSize);
+        }
+
+        void run(Shard& shard, std::stop_token stoken) {
+            while (true) {
+                Request request;
+                {
+                    std::unique_lock lock(shard.queueMutex);
+                    if (!shard.queueCondition.wait(lock, stoken, [&shard]() { return !shard.queue.empty(); })) {
+                        break;
+                    }
+                    request = std::move(shard.queue.front());
+                    shard.queue.pop_front();
+                }
+                shard.requests.fetch_add(1, std::memory_order_relaxed);
+                try {
+                    process(shard, request.input, request.output);
+                    request.result.set_value(std::move(request.output));
+                } catch (...) {
+                    shard.failures.fetch_add(1, std::memory_order_relaxed);
+                    request.result.set_exception(std::current_exception());
+                }
+            }
+            // Requests that were not served anymore
+            const std::lock_guard lock(shard.queueMutex);
+            for (auto& request : shard.queue) {
+                request.result.set_exception(std::make_exception_ptr(std::runtime_error("ShardedExecutor was destroyed before the request was served")));
+            }
+            shard.queue.clear();
+        }
+
+         public:
+        /**
+         * @brief Create the shards on the first device of the configuration and start their workers
+         *
+         * @param config Configuration of the accelerator. The first input and output kernel of the first device are used.
+         * @param pOptions
+         */
+        ShardedExecutor(const Config& config, ShardOptions pOptions) : options(std::move(pOptions)) {
+            if (config.deviceWrappers.empty()) {
+                FinnUtils::logAndError<std::invalid_argument>("Configuration does not contain a device!");
+            }
+            if (options.shards == 0 || options.batchSize == 0) {
+                FinnUtils::logAndError<std::invalid_argument>("ShardedExecutor needs at least one shard and a batch size of at least one!");
+            }
+            const DeviceWrapper& devWrap = config.deviceWrappers[0];
+            DeviceHandler::checkDeviceWrapper(devWrap);
+            deviceIndex = devWrap.xrtDeviceIndex;
+            device = xrt::device(deviceIndex);
+            uuid = device.load_xclbin(devWrap.xclbin);
+
+
+            shardList.reserve(options.shards);
+            for (std::size_t i = 0; i < options.shards; ++i) {
+                auto shard = std::make_unique<Shard>();
+                shard->index = i;
+                shard->core = options.cores.empty() ? -1 : options.cores[i % options.cores.size()];
+                shard->launch = std::make_unique<DeviceLaunch<F, S>>(device, uuid, devWrap, options.batchSize);
+                shardList.emplace_back(std::move(shard));
+            }
+            // Workers are started last, so that no worker observes a partially constructed executor
+            for (auto& shard : shardList) {
+                shard->worker = std::jthread([this, &shard = *shard](std::stop_token stoken) { run(shard, stoken); });
+                if (shard->core >= 0 && !pinThread(shard->worker, shard->core)) {
+                    FINN_LOG(logger, loglevel::warning) << loggerPrefix() << "Could not pin shard " << shard->index << " to core " << shard->core << ", it runs unpinned";
+                    shard->core = -1;
+                }
+            }
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Started " << options.shards << " shards on device " << deviceIndex;
+        }
+
+        ShardedExecutor(ShardedExecutor&& other) = delete;
+        ShardedExecutor(const ShardedExecutor& other) = delete;
+        ShardedExecutor& operator=(ShardedExecutor&& other) = delete;
+        ShardedExecutor& operator=(const ShardedExecutor& other) = delete;
+
+        /**
+         * @brief Stop all workers. Requests still queued fail with std::runtime_error.
+         *
+         */
+        ~ShardedExecutor() {
+            for (auto& shard : shardList) {
+                shard->worker.request_stop();
+            }
+            for (auto& shard : shardList) {
+                if (shard->worker.joinable()) {
+                    shard->worker.join();
+                }
+            }
+        }
+
+        /**
+         * @brief Queue a request on a specific shard, e.g. the shard pinned to the core of the caller
+         *
+         * @param shardIndex
+         * @param input Unpacked input of one batch
+         * @return std::future<Finn::vector<OutputType>> Unpacked output. Holds std::invalid_argument if the input has the wrong size.
+         */
+        std::future<Finn::vector<OutputType>> submit(std::size_t shardIndex, Finn::vector<InputType> input) { return submit(shardIndex, std::move(input), {}); }
+
+        /**
+         * @brief Queue a request on a specific shard and unpack its output into a recycled vector, e.g. the output of an earlier request.
+         * The shard does not allocate for the request if the vector has the capacity of one batch. The shared state of the future still allocates.
+         *
+         * @param shardIndex
+         * @param input Unpacked input of one batch
+         * @param output Vector the output is unpacked into
+         * @return std::future<Finn::vector<OutputType>> The vector holding the unpacked output. Holds std::invalid_argument if the input has the wrong size.
+         */
+        std::future<Finn::vector<OutputType>> submit(std::size_t shardIndex, Finn::vector<InputType> input, Finn::vector<OutputType> output) {
+            if (shardIndex >= shardList.size()) {
+                FinnUtils::logAndError<std::out_of_range>("Shard " + std::to_string(shardIndex) + " does not exist!");
+            }
+            Shard& shard = *shardList[shardIndex];
+            Request request{std::move(input), std::move(output), {}};
+            auto future = request.result.get_future();
+            {
+                const std::lock_guard lock(shard.queueMutex);
+                shard.queue.emplace_back(std::move(request));
+            }
+            shard.queueCondition.notify_one();
+            return future;
+        }
+
+        /**
+         * @brief Queue a request on the next shard in round robin order
+         *
+         * @param input Unpacked input of one batch
+         * @return std::future<Finn::vector<OutputType>>
+         */
+        std::future<Finn::vector<OutputType>> submit(Finn::vector<InputType> input) { return submit(cursor.fetch_add(1, std::memory_order_relaxed) % shardList.size(), std::move(input)); }
+
+        /**
+         * @brief Number of shards
+         *
+         * @return std::size_t
+         */
+        std::size_t shards() const { return shardList.size(); }
+
+        /**
+         * @brief Number of unpacked input elements of one request
+         *
+         * @return std::size_t
+         */
+        std::size_t inputSize() const { return shardList.front()->launch->inputSize(); }
+
+        /**
+         * @brief Get the counters of a shard
+         *
+         * @param shardIndex
+         * @return ShardStatistics
+         */
+        ShardStatistics getStatistics(std::size_t shardIndex) const {
+            const Shard& shard = *shardList.at(shardIndex);
+            return ShardStatistics{shard.requests.load(std::memory_order_relaxed), shard.failures.load(std::memory_order_relaxed), shard.arbiterWaitNs.load(std::memory_order_relaxed), shard.core};
+        }
+
+#ifdef UNITTEST
+        void testProcess(std::size_t shardIndex, std::span<const InputType> input, Finn::vector<OutputType>& output) { process(*shardList.at(shardIndex), input, output); }
+        SyncDeviceInputBuffer<uint8_t>& testGetInputBuffer(std::size_t shardIndex) { return shardList.at(shardIndex)->launch->getInputBuffer(); }
+        SyncDeviceOutputBuffer<uint8_t>& testGetOutputBuffer(std::size_t shardIndex) { return shardList.at(shardIndex)->launch->getOutputBuffer(); }
+#endif
+    };
+}  // namespace Finn
+
+#endif  // SHARDEDEXECUTOR_HPP
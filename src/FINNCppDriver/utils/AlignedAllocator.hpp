@@ -15,6 +15,8 @@
 #ifndef ALIGNEDALLOCATOR_HPP
 #define ALIGNEDALLOCATOR_HPP
 
+#include <FINNCppDriver/utils/AllocationCounter.h>
+
 #include <iostream>
 #include <limits>
 
@@ -175,6 +177,7 @@ class AlignedAllocator {
         size_t allocBytes = ((bytes / TALIGN) + ((bytes % TALIGN != 0) ? 1 : 0)) * TALIGN;  // Only a multiple of TALIGN can be allocated.
 
         if ((ptr = static_cast<T*>(aligned_alloc(TALIGN, allocBytes)))) {
+            FinnUtils::AllocationCounter::record(ALLOCATION_SOURCE::ALIGNED_ALLOCATOR, allocBytes);
             return ptr;
         }
 
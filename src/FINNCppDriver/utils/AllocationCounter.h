@@ -0,0 +1,243 @@
+/**
+ * @file AllocationCounter.h
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Counts heap allocations per thread and per driver stage, so that tests and benchmarks can check the allocation behaviour of the hot path
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * Allocations through AlignedAllocator (and therefore Finn::vector) are always recorded while counting is enabled.
+ * Allocations through the global operator new are only recorded by executables that include AllocationHooks.h in exactly one translation unit.
+ */
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Stage of the driver that an allocation is attributed to
+ *
+ */
+enum class DRIVER_STAGE { NONE = 0, PACK = 1, STORE = 2, EXECUTE = 3, RETRIEVE = 4, UNPACK = 5 };
+
+/**
+ * @brief Origin of a counted allocation
+ *
+ */
+enum class ALLOCATION_SOURCE { ALIGNED_ALLOCATOR = 0, GLOBAL_NEW = 1 };
+
+namespace FinnUtils {
+    /**
+     * @brief Number and size of allocations
+     *
+     */
+    struct AllocationStatistics {
+        /**
+         * @brief Number of allocations
+         *
+         */
+        std::size_t allocations = 0;
+        /**
+         * @brief Number of allocated bytes
+         *
+         */
+        std::size_t bytes = 0;
+
+        /**
+         * @brief Add statistics
+         *
+         * @param other
+         * @return AllocationStatistics&
+         */
+        AllocationStatistics& operator+=(const AllocationStatistics& other) {
+            allocations += other.allocations;
+            bytes += other.bytes;
+            return *this;
+        }
+
+        /**
+         * @brief Difference of two statistics, e.g. of the counter after and before an operation
+         *
+         * @param other
+         * @return AllocationStatistics
+         */
+        AllocationStatistics operator-(const AllocationStatistics& other) const { return {allocations - other.allocations, bytes - other.bytes}; }
+    };
+
+    /**
+     * @brief Counts allocations per thread and per driver stage. Counting is disabled by default; while disabled, recording an allocation costs one relaxed atomic load.
+     * The stage of the calling thread is set with a StageGuard. Allocations of threads that did not set a stage (e.g. OpenMP workers) are attributed to DRIVER_STAGE::NONE.
+     *
+     */
+    class AllocationCounter {
+         public:
+        /**
+         * @brief Number of driver stages
+         *
+         */
+        static constexpr std::size_t stageCount = 6;
+        /**
+         * @brief Number of allocation sources
+         *
+         */
+        static constexpr std::size_t sourceCount = 2;
+        /**
+         * @brief Statistics indexed by allocation source and driver stage
+         *
+         */
+        using Table = std::array<std::array<AllocationStatistics, stageCount>, sourceCount>;
+
+         private:
+        inline static std::atomic<bool> enabled{false};
+        inline static thread_local DRIVER_STAGE stage = DRIVER_STAGE::NONE;
+        inline static thread_local Table threadTable{};
+        inline static std::array<std::array<std::atomic<std::size_t>, stageCount>, sourceCount> globalAllocations{};
+        inline static std::array<std::array<std::atomic<std::size_t>, stageCount>, sourceCount> globalBytes{};
+
+         public:
+        /**
+         * @brief Start counting allocations
+         *
+         */
+        static void enable() noexcept { enabled.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Stop counting allocations
+         *
+         */
+        static void disable() noexcept { enabled.store(false, std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns whether allocations are counted
+         *
+         * @return true
+         * @return false
+         */
+        static bool isEnabled() noexcept { return enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Record an allocation of the calling thread. Must not allocate, because it is called from operator new.
+         *
+         * @param source
+         * @param bytes
+         */
+        static void record(ALLOCATION_SOURCE source, std::size_t bytes) noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            const auto src = static_cast<std::size_t>(source);
+            const auto stg = static_cast<std::size_t>(stage);
+            ++threadTable[src][stg].allocations;
+            threadTable[src][stg].bytes += bytes;
+            globalAllocations[src][stg].fetch_add(1, std::memory_order_relaxed);
+            globalBytes[src][stg].fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the stage of the calling thread
+         *
+         * @return DRIVER_STAGE
+         */
+        static DRIVER_STAGE currentStage() noexcept { return stage; }
+
+        /**
+         * @brief Returns the allocations of the calling thread
+         *
+         * @return Table
+         */
+        static Table threadStatistics() noexcept { return threadTable; }
+
+        /**
+         * @brief Returns the allocations of all threads
+         *
+         * @return Table
+         */
+        static Table globalStatistics() noexcept {
+            Table ret{};
+            for (std::size_t src = 0; src < sourceCount; ++src) {
+                for (std::size_t stg = 0; stg < stageCount; ++stg) {
+                    ret[src][stg] = {globalAllocations[src][stg].load(std::memory_order_relaxed), globalBytes[src][stg].load(std::memory_order_relaxed)};
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Reset the statistics of all threads. The thread local statistics of other threads than the calling thread are kept.
+         *
+         */
+        static void reset() noexcept {
+            threadTable = Table{};
+            for (std::size_t src = 0; src < sourceCount; ++src) {
+                for (std::size_t stg = 0; stg < stageCount; ++stg) {
+                    globalAllocations[src][stg].store(0, std::memory_order_relaxed);
+                    globalBytes[src][stg].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Sum of all sources and stages of a table
+         *
+         * @param table
+         * @return AllocationStatistics
+         */
+        static AllocationStatistics total(const Table& table) noexcept {
+            AllocationStatistics ret;
+            for (const auto& source : table) {
+                for (const auto& stats : source) {
+                    ret += stats;
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Sum of all sources of one stage of a table
+         *
+         * @param table
+         * @param pStage
+         * @return AllocationStatistics
+         */
+        static AllocationStatistics total(const Table& table, DRIVER_STAGE pStage) noexcept {
+            AllocationStatistics ret;
+            for (const auto& source : table) {
+                ret += source[static_cast<std::size_t>(pStage)];
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Attributes all allocations of the calling thread to a driver stage for the lifetime of the guard. Restores the previous stage on destruction.
+         *
+         */
+        class StageGuard {
+             private:
+            DRIVER_STAGE previous;
+
+             public:
+            /**
+             * @brief Construct a new Stage Guard object
+             *
+             * @param pStage
+             */
+            explicit StageGuard(DRIVER_STAGE pStage) noexcept : previous(stage) { stage = pStage; }
+            /**
+             * @brief Destroy the Stage Guard object
+             *
+             */
+            ~StageGuard() { stage = previous; }
+            StageGuard(const StageGuard&) = delete;
+            StageGuard(StageGuard&&) = delete;
+            StageGuard& operator=(const StageGuard&) = delete;
+            StageGuard& operator=(StageGuard&&) = delete;
+        };
+    };
+}  // namespace FinnUtils
+
+#endif  // ALLOCATIONCOUNTER_H
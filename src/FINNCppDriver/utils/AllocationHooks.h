@@ -0,0 +1,79 @@
+/**
+ * @file AllocationHooks.h
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Replaces the global operator new and delete to record allocations in the AllocationCounter
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * Include this header in exactly ONE translation unit of a test or benchmark executable (usually the one containing main).
+ * The replacement operators are not meant for the production driver.
+ */
+
+#ifndef ALLOCATIONHOOKS_H
+#define ALLOCATIONHOOKS_H
+
+#include <FINNCppDriver/utils/AllocationCounter.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace FinnUtils::detail {
+    inline void* countedAlloc(std::size_t size) noexcept {
+        FinnUtils::AllocationCounter::record(ALLOCATION_SOURCE::GLOBAL_NEW, size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    inline void* countedAlignedAlloc(std::size_t size, std::align_val_t align) noexcept {
+        FinnUtils::AllocationCounter::record(ALLOCATION_SOURCE::GLOBAL_NEW, size);
+        const auto alignment = static_cast<std::size_t>(align);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const std::size_t allocBytes = ((size == 0 ? 1 : size) + alignment - 1) / alignment * alignment;
+        return std::aligned_alloc(alignment, allocBytes);
+    }
+
+    /**
+     * @brief Release memory of countedAlloc or countedAlignedAlloc. Never inlined: GCC would otherwise see std::free on pointers returned by operator new at
+     * every inlined delete and report -Wmismatched-new-delete, although both operators are replaced consistently here.
+     *
+     */
+    [[gnu::noinline]] inline void countedFree(void* ptr) noexcept { std::free(ptr); }
+}  // namespace FinnUtils::detail
+
+// NOLINTBEGIN
+void* operator new(std::size_t size) {
+    if (void* ptr = FinnUtils::detail::countedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept { return FinnUtils::detail::countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept { return FinnUtils::detail::countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* ptr = FinnUtils::detail::countedAlignedAlloc(size, align)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) { return operator new(size, align); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t& /*tag*/) noexcept { return FinnUtils::detail::countedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t& /*tag*/) noexcept { return FinnUtils::detail::countedAlignedAlloc(size, align); }
+
+void operator delete(void* ptr) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t& /*tag*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t& /*tag*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t /*align*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t /*align*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete[](void* ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t /*align*/, const std::nothrow_t& /*tag*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t /*align*/, const std::nothrow_t& /*tag*/) noexcept { FinnUtils::detail::countedFree(ptr); }
+// NOLINTEND
+
+#endif  // ALLOCATIONHOOKS_H
@@ -0,0 +1,361 @@
+/**
+ * @file CodecAutotuner.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Startup micro benchmark that picks the fastest sharding of the multi dimensional codecs for the host and caches the choice in a profile file
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef CODECAUTOTUNER
+#define CODECAUTOTUNER
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <omp.h>
+
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DoNotOptimize.h>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <random>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Finn {
+    /**
+     * @brief Persistent cache of autotuned codec choices. The file holds one section per CPU model, so a profile can be shared between hosts.
+     *
+     * Layout: {"version": 1, "hosts": {"<cpu model>": {"<operation key>": {"maxThreads": 4, "minElementsPerThread": 32768, "ns": 1234}}}}
+     *
+     */
+    class CodecProfile {
+         private:
+        std::filesystem::path path;
+        std::string host;
+        nlohmann::json content = {{"version", profileVersion}, {"hosts", nlohmann::json::object()}};
+        logger_type& logger = Logger::getLogger();
+
+        static std::string loggerPrefix() { return "[CodecProfile] "; }
+
+         public:
+        /**
+         * @brief Layout version of the profile file. Profiles with another version are ignored.
+         *
+         */
+        static constexpr int profileVersion = 1;
+
+        /**
+         * @brief Model name of the CPU as reported by /proc/cpuinfo, combined with the number of usable threads
+         *
+         * @return std::string
+         */
+        static std::string cpuModel() {
+            std::ifstream cpuinfo("/proc/cpuinfo");
+            std::string line;
+            std::string model = "unknown cpu";
+            while (std::getline(cpuinfo, line)) {
+                if (line.starts_with("model name")) {
+                    if (const auto colon = line.find(':'); colon != std::string::npos && colon + 2 <= line.size()) {
+                        model = line.substr(colon + 2);
+                    }
+                    break;
+                }
+            }
+            // The best sharding depends on the threads the driver may use, not only on the core type
+            return model + " x" + std::to_string(omp_get_max_threads());
+        }
+
+        /**
+         * @brief Load the profile. A missing file starts an empty profile, an unreadable one is replaced on the next save.
+         *
+         * @param pPath Path of the profile file
+         * @param pHost Host key, defaults to the CPU model of this host
+         */
+        explicit CodecProfile(std::filesystem::path pPath, std::string pHost = cpuModel()) : path(std::move(pPath)), host(std::move(pHost)) {
+            if (!std::filesystem::exists(path)) {
+                return;
+            }
+            std::ifstream file(path);
+            auto parsed = nlohmann::json::parse(file, nullptr, false);
+            if (parsed.is_discarded() || !parsed.is_object() || parsed.value("version", 0) != profileVersion || !parsed.contains("hosts") || !parsed["hosts"].is_object()) {
+                FINN_LOG(logger, loglevel::warning) << loggerPrefix() << "Ignoring unreadable codec profile " << path.string();
+                return;
+            }
+            content = std::move(parsed);
+        }
+
+        /**
+         * @brief Look up the tuning stored for an operation on this host
+         *
+         * @param key Operation key, see CodecAutotuner::operationKey
+         * @return std::optional<CodecTuning> Empty if the operation was not tuned on this host yet
+         */
+        std::optional<CodecTuning> find(const std::string& key) const {
+            const auto& hosts = content["hosts"];
+            if (!hosts.contains(host) || !hosts[host].contains(key)) {
+                return std::nullopt;
+            }
+            const auto& entry = hosts[host][key];
+            CodecTuning tuning;
+            tuning.maxThreads = entry.value("maxThreads", tuning.maxThreads);
+            tuning.minElementsPerThread = std::max(entry.value("minElementsPerThread", tuning.minElementsPerThread), std::size_t{1});
+            return tuning;
+        }
+
+        /**
+         * @brief Store the tuning of an operation for this host
+         *
+         * @param key Operation key
+         * @param tuning Chosen tuning
+         * @param nanoseconds Measured duration of the operation with the chosen tuning
+         */
+        void insert(const std::string& key, const CodecTuning& tuning, uint64_t nanoseconds) {
+            content["hosts"][host][key] = {{"maxThreads", tuning.maxThreads}, {"minElementsPerThread", tuning.minElementsPerThread}, {"ns", nanoseconds}};
+        }
+
+        /**
+         * @brief Write the profile to its file. A profile that cannot be written only costs the measurement on the next start, so failures are logged, not thrown.
+         *
+         * @return true Profile was written
+         * @return false Profile could not be written
+         */
+        bool save() const {
+            std::error_code error;
+            if (path.has_parent_path()) {
+                std::filesystem::create_directories(path.parent_path(), error);
+            }
+            std::ofstream file;
+            if (!error) {
+                file.open(path);
+            }
+            if (error || !file) {
+                FINN_LOG(logger, loglevel::warning) << loggerPrefix() << "Could not write codec profile " << path.string() << ", the tuning is not cached";
+                return false;
+            }
+            file << content.dump(4) << "\n";
+            return true;
+        }
+
+        /**
+         * @brief Host key of this profile
+         *
+         * @return const std::string&
+         */
+        const std::string& getHost() const { return host; }
+    };
+
+    /**
+     * @brief Picks the fastest CodecTuning for the pack and unpack operations of a driver by timing the candidates on this host within a time budget.
+     * Choices are cached in a CodecProfile, so only the first start on a host pays for the measurement.
+     *
+     * The candidates differ in the thread limit and the minimum number of elements per thread. Candidates that result in the same sharding of the
+     * operation are only measured once. The heuristic default is always the first candidate, so it wins ties.
+     *
+     */
+    class CodecAutotuner {
+         private:
+        CodecProfile profile;
+        std::chrono::nanoseconds budget;
+        std::size_t measuredOperations = 0;
+        std::mt19937 engine{42};
+        logger_type& logger = Logger::getLogger();
+
+        static std::string loggerPrefix() { return "[CodecAutotuner] "; }
+
+        /**
+         * @brief All candidates that result in a distinct sharding of rows x rowElements elements of datatype U
+         *
+         */
+        template<IsDatatype U>
+        static std::vector<CodecTuning> candidates(std::size_t rows, std::size_t rowElements) {
+            const std::size_t hostThreads = static_cast<std::size_t>(std::max(omp_get_max_threads(), 1));
+            std::vector<std::size_t> threadLimits;
+            for (std::size_t threads = 1; threads < hostThreads; threads *= 2) {
+                threadLimits.emplace_back(threads);
+            }
+            threadLimits.emplace_back(hostThreads);
+            constexpr std::array<std::size_t, 3> minElements = {CodecTuning::defaultMinElementsPerThread / 4, CodecTuning::defaultMinElementsPerThread, CodecTuning::defaultMinElementsPerThread * 4};
+
+            std::vector<CodecTuning> ret = {CodecTuning{}};
+            std::vector<std::pair<std::size_t, std::size_t>> shardings = {shardingOf<U>(rows, rowElements, ret.front())};
+            for (const std::size_t limit : threadLimits) {
+                for (const std::size_t elements : minElements) {
+                    const CodecTuning tuning{limit, elements};
+                    const auto sharding = shardingOf<U>(rows, rowElements, tuning);
+                    if (std::find(shardings.begin(), shardings.end(), sharding) == shardings.end()) {
+                        shardings.emplace_back(sharding);
+                        ret.emplace_back(tuning);
+                    }
+                }
+            }
+            return ret;
+        }
+
+        template<IsDatatype U>
+        static std::pair<std::size_t, std::size_t> shardingOf(std::size_t rows, std::size_t rowElements, const CodecTuning& tuning) {
+            const auto sharding = CodecSharding::create<U>(rows, rowElements, tuning);
+            return {sharding.threads, sharding.shardsPerRow};
+        }
+
+        /**
+         * @brief Time every candidate round robin until the budget is used up and return the candidate with the lowest minimum.
+         * Every candidate is run at least once, even if this exceeds the budget.
+         *
+         */
+        template<typename Operation>
+        std::pair<CodecTuning, uint64_t> pickFastest(const std::vector<CodecTuning>& tunings, Operation&& operation) {
+            std::vector<uint64_t> best(tunings.size(), std::numeric_limits<uint64_t>::max());
+            const auto deadline = std::chrono::steady_clock::now() + budget;
+            bool first = true;
+            while (first || std::chrono::steady_clock::now() < deadline) {
+                for (std::size_t i = 0; i < tunings.size(); ++i) {
+                    const auto start = std::chrono::steady_clock::now();
+                    operation(tunings[i]);
+                    const auto duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+                    best[i] = std::min(best[i], duration);
+                }
+                first = false;
+            }
+            const auto winner = static_cast<std::size_t>(std::distance(best.begin(), std::min_element(best.begin(), best.end())));
+            ++measuredOperations;
+            return {tunings[winner], best[winner]};
+        }
+
+        static shape_t shape(std::size_t rows, std::size_t rowElements) { return {static_cast<unsigned int>(rows), static_cast<unsigned int>(rowElements)}; }
+
+        template<IsDatatype U>
+        Finn::vector<UnpackingAutoRetType::AutoRetType<U>> createInput(std::size_t elements) {
+            using HostType = UnpackingAutoRetType::AutoRetType<U>;
+            Finn::vector<HostType> input(elements);
+            if constexpr (std::is_same_v<U, DatatypeBipolar>) {
+                std::bernoulli_distribution dist;
+                std::generate(input.begin(), input.end(), [&]() { return dist(engine) ? HostType{1} : HostType{-1}; });
+            } else {
+                std::uniform_real_distribution<double> dist{U().min(), U().max()};
+                std::generate(input.begin(), input.end(), [&]() { return static_cast<HostType>(dist(engine)); });
+            }
+            return input;
+        }
+
+        CodecTuning lookupOrTune(const std::string& key, auto&& tune) {
+            if (auto cached = profile.find(key)) {
+                FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Using cached codec tuning for " << key << ": maxThreads " << cached->maxThreads << ", minElementsPerThread " << cached->minElementsPerThread;
+                return *cached;
+            }
+            const auto [tuning, nanoseconds] = tune();
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Tuned " << key << ": maxThreads " << tuning.maxThreads << ", minElementsPerThread " << tuning.minElementsPerThread << " (" << nanoseconds << "ns)";
+            profile.insert(key, tuning, nanoseconds);
+            profile.save();
+            return tuning;
+        }
+
+         public:
+        /**
+         * @brief Construct a new Codec Autotuner
+         *
+         * @param profilePath Path of the profile file that caches the choices
+         * @param pBudget Time budget for the measurement of one operation
+         * @param host Host key in the profile, defaults to the CPU model of this host
+         */
+        explicit CodecAutotuner(const std::filesystem::path& profilePath, std::chrono::milliseconds pBudget = std::chrono::milliseconds(250), std::string host = CodecProfile::cpuModel())
+            : profile(profilePath, std::move(host)), budget(pBudget) {}
+
+        /**
+         * @brief Key of an operation in the profile, e.g. "pack INT2 1x600"
+         *
+         * @tparam U Finn datatype
+         * @param operation "pack" or "unpack"
+         * @param rows Number of rows (innermost dimensions)
+         * @param rowElements Number of elements per row
+         * @return std::string
+         */
+        template<IsDatatype U>
+        static std::string operationKey(const std::string& operation, std::size_t rows, std::size_t rowElements) {
+            std::string type;
+            if constexpr (U().isInteger()) {
+                type = U().sign() ? "INT" : "UINT";
+            } else if constexpr (U().isFixedPoint()) {
+                type = "FIXED";
+            } else {
+                type = "FLOAT";
+            }
+            return operation + " " + type + std::to_string(U().bitwidth()) + " " + std::to_string(rows) + "x" + std::to_string(rowElements);
+        }
+
+        /**
+         * @brief Tuning for packMultiDimensionalInputs of rows x rowElements elements of datatype U
+         *
+         * @tparam U Finn datatype of the input
+         * @param rows
+         * @param rowElements
+         * @return CodecTuning
+         */
+        template<IsDatatype U>
+        CodecTuning tunePack(std::size_t rows, std::size_t rowElements) {
+            return lookupOrTune(operationKey<U>("pack", rows, rowElements), [&]() {
+                auto input = createInput<U>(rows * rowElements);
+                const Finn::DynamicMdSpan reshaped(input.begin(), input.end(), shape(rows, rowElements));
+                return pickFastest(candidates<U>(rows, rowElements), [&](const CodecTuning& tuning) {
+                    auto packed = Finn::packMultiDimensionalInputs<U>(input.begin(), input.end(), reshaped, rowElements, tuning);
+                    DoNotOptimize(packed);
+                });
+            });
+        }
+
+        /**
+         * @brief Tuning for unpackMultiDimensionalOutputs of rows x rowElements elements of datatype U
+         *
+         * @tparam U Finn datatype of the output
+         * @param rows
+         * @param rowElements
+         * @return CodecTuning
+         */
+        template<IsDatatype U>
+        CodecTuning tuneUnpack(std::size_t rows, std::size_t rowElements) {
+            return lookupOrTune(operationKey<U>("unpack", rows, rowElements), [&]() {
+                auto unpackedInput = createInput<U>(rows * rowElements);
+                const Finn::DynamicMdSpan reshapedInput(unpackedInput.begin(), unpackedInput.end(), shape(rows, rowElements));
+                auto input = Finn::packMultiDimensionalInputs<U>(unpackedInput.begin(), unpackedInput.end(), reshapedInput, rowElements);
+                const Finn::DynamicMdSpan reshaped(input.begin(), input.end(), shape(rows, input.size() / std::max(rows, std::size_t{1})));
+                const shapeFolded_t foldedShape = shape(rows, rowElements);
+                return pickFastest(candidates<U>(rows, rowElements), [&](const CodecTuning& tuning) {
+                    auto unpacked = Finn::unpackMultiDimensionalOutputs<U>(input.begin(), input.end(), reshaped, foldedShape, tuning);
+                    DoNotOptimize(unpacked);
+                });
+            });
+        }
+
+        /**
+         * @brief Number of operations that were measured instead of being taken from the profile
+         *
+         * @return std::size_t
+         */
+        std::size_t getMeasuredOperations() const { return measuredOperations; }
+
+        /**
+         * @brief Get the profile
+         *
+         * @return const CodecProfile&
+         */
+        const CodecProfile& getProfile() const { return profile; }
+    };
+}  // namespace Finn
+
+#endif  // CODECAUTOTUNER
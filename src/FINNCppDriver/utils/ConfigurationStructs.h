@@ -68,6 +68,14 @@ namespace nlohmann {
     };
 }  // namespace nlohmann
 
+/**
+ * @brief Json conversion of the buffer mapping type
+ *
+ */
+// NOLINTNEXTLINE
+NLOHMANN_JSON_SERIALIZE_ENUM(MAP_TYPE, {{MAP_TYPE::CACHED, "cached"}, {MAP_TYPE::WRITE_COMBINED, "write_combined"}, {MAP_TYPE::UNCACHED, "uncached"}})
+NLOHMANN_JSON_SERIALIZE_ENUM(SUBMISSION_QUEUE, {{SUBMISSION_QUEUE::RING_BUFFER, "ring_buffer"}, {SUBMISSION_QUEUE::MPMC, "mpmc"}})
+
 
 namespace Finn {
     /**
@@ -92,6 +100,16 @@ namespace Finn {
          *
          */
         unsigned int slrIndex = 0;
+        /**
+         * @brief Caching behaviour of the host mapping of the buffer. Optional config entry "mapType" ("cached", "write_combined" or "uncached")
+         *
+         */
+        MAP_TYPE mapType = MAP_TYPE::CACHED;
+        /**
+         * @brief Queue that collects the submitted inputs of asynchronous input buffers. Optional config entry "submissionQueue" ("ring_buffer" or "mpmc")
+         *
+         */
+        SUBMISSION_QUEUE submissionQueue = SUBMISSION_QUEUE::RING_BUFFER;
 
         /**
          * @brief Construct a new Buffer Descriptor object
@@ -233,7 +251,9 @@ namespace Finn {
      * @param ebd
      */
     // NOLINTNEXTLINE
-    void inline to_json(json& j, const ExtendedBufferDescriptor& ebd) { j = json{{"kernelName", ebd.kernelName}, {"packedShape", ebd.packedShape}, {"normalShape", ebd.normalShape}, {"foldedShape", ebd.foldedShape}}; }
+    void inline to_json(json& j, const ExtendedBufferDescriptor& ebd) {
+        j = json{{"kernelName", ebd.kernelName}, {"packedShape", ebd.packedShape}, {"normalShape", ebd.normalShape}, {"foldedShape", ebd.foldedShape}, {"mapType", ebd.mapType}, {"submissionQueue", ebd.submissionQueue}};
+    }
 
     /**
      * @brief ExtendedBufferDescriptor -> JSON
@@ -247,6 +267,12 @@ namespace Finn {
         j.at("packedShape").get_to(ebd.packedShape);
         j.at("normalShape").get_to(ebd.normalShape);
         j.at("foldedShape").get_to(ebd.foldedShape);
+        if (j.contains("mapType")) {
+            j.at("mapType").get_to(ebd.mapType);
+        }
+        if (j.contains("submissionQueue")) {
+            j.at("submissionQueue").get_to(ebd.submissionQueue);
+        }
     }
 
     /**
@@ -0,0 +1,277 @@
+/**
+ * @file ControlServer.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unix domain socket that allows changing the runtime tunables of a running driver process
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef CONTROLSERVER
+#define CONTROLSERVER
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Tunables.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace Finn {
+    /**
+     * @brief Serves a line based protocol on a unix domain socket to inspect and change FinnUtils::Tunables while the driver is running.
+     *
+     * Commands are "get", "set <key> <value>" and "help", every command is answered with one or more lines. Keys are batch_size, codec_threads and
+     * codec_min_elements, which every driver of the process applies between two batches, and wait_policy (spin|yield), log_level (trace|debug|info|warning|error|fatal) and
+     * stats (on|off), which take effect immediately. A background thread serves one client at a time, so the hot path is never involved.
+     *
+     */
+    class ControlServer {
+         private:
+        static constexpr std::size_t maxLineLength = 256;
+        static constexpr int pollTimeoutMs = 100;
+        static constexpr std::array<std::pair<std::string_view, loglevel::severity_level>, 6> logLevels = {{{"trace", loglevel::trace},
+                                                                                                             {"debug", loglevel::debug},
+                                                                                                             {"info", loglevel::info},
+                                                                                                             {"warning", loglevel::warning},
+                                                                                                             {"error", loglevel::error},
+                                                                                                             {"fatal", loglevel::fatal}}};
+
+        std::filesystem::path socketPath;
+        int listenFd = -1;
+        logger_type& logger = Logger::getLogger();
+        std::jthread worker;
+
+        static std::string loggerPrefix() { return "[ControlServer] "; }
+
+        static std::optional<uint64_t> parsePositive(std::string_view value) {
+            uint64_t ret = 0;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), ret);
+            if (error != std::errc() || end != value.data() + value.size() || ret == 0) {
+                return std::nullopt;
+            }
+            return ret;
+        }
+
+        static std::string logLevelName(loglevel::severity_level level) {
+            const auto* entry = std::find_if(logLevels.begin(), logLevels.end(), [level](const auto& pair) { return pair.second == level; });
+            return (entry != logLevels.end()) ? std::string(entry->first) : "unknown";
+        }
+
+        static std::string set(const std::string& key, const std::string& value) {
+            if (key == "batch_size" || key == "codec_threads" || key == "codec_min_elements") {
+                const auto number = parsePositive(value);
+                if (!number || (key == "batch_size" && *number > std::numeric_limits<uint32_t>::max())) {
+                    return "error: " + key + " has to be a positive integer";
+                }
+                if (key == "batch_size") {
+                    FinnUtils::Tunables::setBatchSize(static_cast<uint32_t>(*number));
+                } else if (key == "codec_threads") {
+                    FinnUtils::Tunables::setCodecThreads(*number);
+                } else {
+                    FinnUtils::Tunables::setCodecMinElements(*number);
+                }
+                FINN_LOG(Logger::getLogger(), loglevel::info) << loggerPrefix() << "Requested " << key << " " << *number << " for every driver of this process";
+            } else if (key == "wait_policy") {
+                if (value != "spin" && value != "yield") {
+                    return "error: wait_policy has to be spin or yield";
+                }
+                FinnUtils::Tunables::setWaitPolicy((value == "yield") ? WAIT_POLICY::YIELD : WAIT_POLICY::SPIN);
+            } else if (key == "log_level") {
+                const auto level = parseLogLevel(value);
+                if (!level) {
+                    return "error: log_level has to be one of trace, debug, info, warning, error, fatal";
+                }
+                FinnUtils::Tunables::setLogLevel(*level);
+            } else if (key == "stats") {
+                if (value != "on" && value != "off") {
+                    return "error: stats has to be on or off";
+                }
+                FinnUtils::Tunables::setStats(value == "on");
+            } else {
+                return "error: unknown key " + key;
+            }
+            return "ok";
+        }
+
+        void serve(int client, std::string& pending) {
+            std::size_t end = 0;
+            while ((end = pending.find('\n')) != std::string::npos) {
+                std::string line = pending.substr(0, end);
+                pending.erase(0, end + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                const std::string reply = execute(line) + "\n";
+                // A client that went away is noticed by the next recv
+                [[maybe_unused]] const auto sent = send(client, reply.data(), reply.size(), MSG_NOSIGNAL);
+            }
+        }
+
+        void run(std::stop_token stoken) {
+            int client = -1;
+            std::string pending;
+            while (!stoken.stop_requested()) {
+                pollfd descriptor{(client >= 0) ? client : listenFd, POLLIN, 0};
+                // Bounded timeout, so that the stop request is noticed
+                if (poll(&descriptor, 1, pollTimeoutMs) <= 0) {
+                    continue;
+                }
+                if (client < 0) {
+                    client = accept(listenFd, nullptr, nullptr);
+                    continue;
+                }
+                std::array<char, maxLineLength> chunk{};
+                const auto received = recv(client, chunk.data(), chunk.size(), 0);
+                if (received > 0) {
+                    pending.append(chunk.data(), static_cast<std::size_t>(received));
+                    serve(client, pending);
+                }
+                if (received <= 0 || pending.size() > maxLineLength) {
+                    close(client);
+                    client = -1;
+                    pending.clear();
+                }
+            }
+            if (client >= 0) {
+                close(client);
+            }
+        }
+
+         public:
+        /**
+         * @brief Default socket path of this process
+         *
+         * @return std::filesystem::path /tmp/finn-control.<pid>.sock
+         */
+        static std::filesystem::path defaultPath() { return std::filesystem::temp_directory_path() / ("finn-control." + std::to_string(getpid()) + ".sock"); }
+
+        /**
+         * @brief Create the socket and start serving
+         *
+         * @param pSocketPath An existing socket at this path is replaced
+         */
+        explicit ControlServer(std::filesystem::path pSocketPath = defaultPath()) : socketPath(std::move(pSocketPath)) {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            const std::string path = socketPath.string();
+            if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+                FinnUtils::logAndError<std::invalid_argument>("Control socket path " + path + " is empty or too long!");
+            }
+            path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+            if (std::filesystem::is_socket(socketPath)) {
+                std::filesystem::remove(socketPath);
+            }
+            listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (listenFd < 0) {
+                FinnUtils::logAndError<std::runtime_error>(std::string("Could not create control socket: ") + std::strerror(errno));
+            }
+            if (bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listenFd, 4) != 0) {
+                const std::string reason = std::strerror(errno);
+                close(listenFd);
+                FinnUtils::logAndError<std::runtime_error>("Could not bind control socket " + path + ": " + reason);
+            }
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Accepting tunable changes on " << path;
+            worker = std::jthread([this](std::stop_token stoken) { run(stoken); });
+        }
+
+        ControlServer(ControlServer&& other) = delete;
+        ControlServer(const ControlServer& other) = delete;
+        ControlServer& operator=(ControlServer&& other) = delete;
+        ControlServer& operator=(const ControlServer& other) = delete;
+
+        /**
+         * @brief Stop serving and remove the socket
+         *
+         */
+        ~ControlServer() {
+            worker.request_stop();
+            if (worker.joinable()) {
+                worker.join();
+            }
+            close(listenFd);
+            std::error_code error;
+            std::filesystem::remove(socketPath, error);
+        }
+
+        /**
+         * @brief Execute one command of the protocol
+         *
+         * @param command e.g. "set batch_size 16"
+         * @return std::string Reply without trailing newline, starts with "error:" if the command failed
+         */
+        static std::string execute(const std::string& command) {
+            std::istringstream stream(command);
+            std::string verb;
+            std::string key;
+            std::string value;
+            std::string rest;
+            stream >> verb >> key >> value >> rest;
+            if (verb == "get" && key.empty()) {
+                std::ostringstream reply;
+                reply << "generation " << FinnUtils::Tunables::generation() << "\n"
+                      << "batch_size " << FinnUtils::Tunables::batchSize() << "\n"
+                      << "codec_threads " << FinnUtils::Tunables::codecThreads() << "\n"
+                      << "codec_min_elements " << FinnUtils::Tunables::codecMinElements() << "\n"
+                      << "wait_policy " << ((FinnUtils::Tunables::waitPolicy() == WAIT_POLICY::YIELD) ? "yield" : "spin") << "\n"
+                      << "log_level " << logLevelName(FinnUtils::Tunables::logLevel()) << "\n"
+                      << "stats " << (FinnUtils::LiveStats::isEnabled() ? "on" : "off");
+                return reply.str();
+            }
+            if (verb == "set" && !value.empty() && rest.empty()) {
+                return set(key, value);
+            }
+            if (verb == "help" && key.empty()) {
+                return "get | set <key> <value> | help\n"
+                       "keys: batch_size, codec_threads, codec_min_elements (positive integers, 0 in get means the driver setting is kept), wait_policy (spin|yield), "
+                       "log_level (trace|debug|info|warning|error|fatal), stats (on|off)";
+            }
+            return "error: unknown command, try help";
+        }
+
+        /**
+         * @brief Parse the name of a log level as used by the protocol
+         *
+         * @param name One of trace, debug, info, warning, error, fatal
+         * @return std::optional<loglevel::severity_level> std::nullopt if the name is unknown
+         */
+        static std::optional<loglevel::severity_level> parseLogLevel(std::string_view name) {
+            const auto* entry = std::find_if(logLevels.begin(), logLevels.end(), [name](const auto& pair) { return pair.first == name; });
+            if (entry == logLevels.end()) {
+                return std::nullopt;
+            }
+            return entry->second;
+        }
+
+        /**
+         * @brief Path of the socket
+         *
+         * @return const std::filesystem::path&
+         */
+        const std::filesystem::path& getSocketPath() const { return socketPath; }
+    };
+}  // namespace Finn
+
+#endif  // CONTROLSERVER
@@ -15,17 +15,24 @@
 
 #include <FINNCppDriver/utils/CustomDynamicBitset.h>
 #include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Tracepoints.h>
 #include <FINNCppDriver/utils/Types.h>
 #include <omp.h>
 
 #include <FINNCppDriver/utils/AlignedAllocator.hpp>
 #include <FINNCppDriver/utils/DynamicMdSpan.hpp>
 #include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <FINNCppDriver/utils/StreamingCopy.hpp>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <bitset>
 #include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <numeric>
+#include <span>
 
 namespace Finn {
     /**
@@ -514,6 +521,87 @@ namespace Finn {
         return pack<U>(foldedVec.begin(), foldedVec.end());
     }
 
+    namespace detail {
+        /**
+         * @brief Bit representation of a single input in the packed stream. Applies the same conversions as pack to a single element without modifying the input.
+         *
+         * @tparam U Finn Datatype of input data
+         * @tparam T
+         * @param val Input value
+         * @return uint64_t The lower U().bitwidth() bits of the packed representation, all other bits are zero
+         */
+        template<IsDatatype U, typename T>
+        constexpr uint64_t packedBits(T val) {
+            constexpr std::size_t bitw = U().bitwidth();
+            static_assert(bitw <= 64, "Datatypes with more than 64 bits are currently not supported!");
+            constexpr uint64_t mask = (bitw == 64) ? ~uint64_t{0} : ((uint64_t{1} << bitw) - 1);
+            constexpr bool isFix = U().isFixedPoint();
+            constexpr bool isInt = U().isInteger();
+            if constexpr (isFix) {  // Datatype is Fixed Point Number
+                constexpr std::size_t bytes = FinnUtils::fastDivCeil(bitw, 8UL);
+                using FourBytesOrLonger = typename std::conditional<bytes <= 4, uint32_t, uint64_t>::type;
+                using TwoBytesOrLonger = typename std::conditional<bytes == 2, uint16_t, FourBytesOrLonger>::type;
+                using OneByteOrLonger = typename std::conditional<bytes == 1, uint8_t, TwoBytesOrLonger>::type;
+                if constexpr (std::is_floating_point_v<T>) {
+                    return static_cast<uint64_t>(static_cast<OneByteOrLonger>(static_cast<T>(val * (1 << U().fracBits())))) & mask;
+                } else {
+                    return static_cast<uint64_t>(static_cast<OneByteOrLonger>(static_cast<T>(val << U().fracBits()))) & mask;
+                }
+            } else if constexpr (!isInt) {  // Datatype is floating point number, FINN only supports 32 bit floating point numbers
+                return static_cast<uint64_t>(std::bit_cast<uint32_t>(static_cast<float>(val))) & mask;
+            } else {
+                // Integers stored in floating point inputs are converted, signed integers are reinterpreted as unsigned integers of the same width
+                using StorageType = typename std::conditional_t<std::is_floating_point_v<T>, std::conditional<sizeof(T) == 4, uint32_t, uint64_t>, std::make_unsigned<T>>::type;
+                auto bits = static_cast<uint64_t>(static_cast<StorageType>(val));
+                if constexpr (std::is_same_v<U, DatatypeBipolar>) {
+                    bits = (bits + 1) >> 1;  // This converts bipolar to binary
+                }
+                return bits & mask;
+            }
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Function to pack a range of U stored in T into a destination without padding bits inbetween.
+     * In contrast to pack, this does not allocate and does not modify the input. Writes every byte of the destination exactly once and in order, the padding bits of the last byte are zero.
+     *
+     * @tparam U Finn Datatype of input data
+     * @tparam IteratorType
+     * @param first iterator pointing to first element of input
+     * @param last iterator pointing to last element of input
+     * @param destination Destination of the packed bytes. Has to hold at least ceil(elements * bitwidth / 8) bytes
+     * @return std::size_t Number of bytes written
+     */
+    template<IsDatatype U, typename IteratorType>
+    std::size_t packInto(IteratorType first, IteratorType last, std::span<uint8_t> destination) {
+        static_assert(std::endian::native == std::endian::little, "Only little-endian architectures are currently supported!");
+        constexpr std::size_t bitw = U().bitwidth();
+        constexpr std::size_t accumulatorBits = 64;
+        const std::size_t bytes = FinnUtils::fastDivCeil(static_cast<std::size_t>(std::distance(first, last)) * bitw, 8UL);
+        if (bytes > destination.size()) {
+            FinnUtils::logAndError<std::length_error>("Destination of packing operation is too small! Needed bytes: " + std::to_string(bytes) + ", available: " + std::to_string(destination.size()));
+        }
+
+        // Collect the bits in a 64 bit accumulator and write it out whenever it is full
+        uint8_t* out = destination.data();
+        uint64_t accumulator = 0;
+        std::size_t filled = 0;
+        for (; first != last; ++first) {
+            const uint64_t bits = detail::packedBits<U>(*first);
+            accumulator |= bits << filled;
+            filled += bitw;
+            if (filled >= accumulatorBits) {
+                std::memcpy(out, &accumulator, sizeof(accumulator));
+                out += sizeof(accumulator);
+                filled -= accumulatorBits;
+                // Bits of the input that did not fit into the accumulator anymore
+                accumulator = (filled == 0) ? 0 : bits >> (bitw - filled);
+            }
+        }
+        std::memcpy(out, &accumulator, FinnUtils::fastDivCeil(filled, 8UL));
+        return bytes;
+    }
+
     /**
      * @brief Function for template meta code. Tests if a FinnDatatype and C++ are compatible
      *
@@ -527,6 +615,172 @@ namespace Finn {
                (std::is_floating_point_v<T> || std::is_integral_v<T>);
     }
 
+    /**
+     * @brief Tunable parameters of the sharding of the multi dimensional codecs. The defaults are the built in heuristic, the CodecAutotuner picks host specific values.
+     *
+     */
+    struct CodecTuning {
+        /**
+         * @brief Default for the number of elements a thread should at least work on
+         *
+         */
+        static constexpr std::size_t defaultMinElementsPerThread = 1UL << 15U;
+
+        /**
+         * @brief Upper bound for the number of threads. 0 uses the OpenMP thread limit (OMP_NUM_THREADS)
+         *
+         */
+        std::size_t maxThreads = 0;
+        /**
+         * @brief Number of elements a thread should at least work on, smaller shards are dominated by the threading overhead
+         *
+         */
+        std::size_t minElementsPerThread = defaultMinElementsPerThread;
+
+        /**
+         * @brief Compare two tunings
+         *
+         * @return true
+         * @return false
+         */
+        bool operator==(const CodecTuning&) const = default;
+    };
+
+    /**
+     * @brief Describes how a multi dimensional pack or unpack operation is split between threads.
+     * The thread count only depends on the total number of elements, not on the folded shape. If there are fewer rows (innermost dimensions) than threads,
+     * every row is split into shards. Shards start at multiples of lcm(bitwidth, 8) bits, so every shard begins on a byte boundary of the packed data
+     * and can be packed or unpacked independently of its neighbours.
+     *
+     */
+    struct CodecSharding {
+        /**
+         * @brief Number of elements a thread should at least work on, smaller shards are dominated by the threading overhead
+         *
+         */
+        static constexpr std::size_t minElementsPerThread = CodecTuning::defaultMinElementsPerThread;
+
+        /**
+         * @brief Number of rows (innermost dimensions)
+         *
+         */
+        std::size_t rows = 0;
+        /**
+         * @brief Number of elements per row
+         *
+         */
+        std::size_t rowElements = 0;
+        /**
+         * @brief Number of packed bytes per row, including padding
+         *
+         */
+        std::size_t rowBytes = 0;
+        /**
+         * @brief Bitwidth of the datatype
+         *
+         */
+        std::size_t bitwidth = 0;
+        /**
+         * @brief Number of shards every row is split into
+         *
+         */
+        std::size_t shardsPerRow = 1;
+        /**
+         * @brief Number of elements per shard. Only the last shard of a row can be shorter.
+         *
+         */
+        std::size_t shardElements = 0;
+        /**
+         * @brief Number of threads used for the operation
+         *
+         */
+        std::size_t threads = 1;
+
+        /**
+         * @brief Create the sharding for rows of datatype U
+         *
+         * @tparam U
+         * @param pRows Number of rows
+         * @param pRowElements Number of elements per row
+         * @param maxThreads Upper bound for the number of threads. Defaults to the OpenMP thread limit (OMP_NUM_THREADS)
+         * @param minElements Number of elements a thread should at least work on
+         * @return CodecSharding
+         */
+        template<IsDatatype U>
+        static CodecSharding create(std::size_t pRows, std::size_t pRowElements, std::size_t maxThreads = static_cast<std::size_t>(omp_get_max_threads()), std::size_t minElements = minElementsPerThread) {
+            constexpr std::size_t bitw = U().bitwidth();
+            constexpr std::size_t alignElements = std::lcm(bitw, std::size_t{8}) / bitw;
+            CodecSharding sharding;
+            sharding.rows = pRows;
+            sharding.rowElements = pRowElements;
+            sharding.rowBytes = FinnUtils::fastDivCeil(pRowElements * bitw, std::size_t{8});
+            sharding.bitwidth = bitw;
+            sharding.shardElements = pRowElements;
+            sharding.threads = std::clamp((pRows * pRowElements) / std::max(minElements, std::size_t{1}), std::size_t{1}, std::max(maxThreads, std::size_t{1}));
+            if (pRows < sharding.threads && pRowElements > alignElements) {
+                const std::size_t wantedShards = FinnUtils::fastDivCeil(sharding.threads, std::max(pRows, std::size_t{1}));
+                sharding.shardElements = FinnUtils::fastDivCeil(FinnUtils::fastDivCeil(pRowElements, wantedShards), alignElements) * alignElements;
+                // Rounding to the alignment can make some of the wanted shards obsolete
+                sharding.shardsPerRow = FinnUtils::fastDivCeil(pRowElements, sharding.shardElements);
+            }
+            return sharding;
+        }
+
+        /**
+         * @brief Create the sharding for rows of datatype U with the given tuning
+         *
+         * @tparam U
+         * @param pRows Number of rows
+         * @param pRowElements Number of elements per row
+         * @param tuning
+         * @return CodecSharding
+         */
+        template<IsDatatype U>
+        static CodecSharding create(std::size_t pRows, std::size_t pRowElements, const CodecTuning& tuning) {
+            const std::size_t maxThreads = (tuning.maxThreads == 0) ? static_cast<std::size_t>(omp_get_max_threads()) : tuning.maxThreads;
+            return create<U>(pRows, pRowElements, maxThreads, tuning.minElementsPerThread);
+        }
+
+        /**
+         * @brief Number of independent tasks (shards over all rows)
+         *
+         * @return std::size_t
+         */
+        std::size_t tasks() const { return rows * shardsPerRow; }
+
+        /**
+         * @brief Row of a task
+         *
+         * @param task
+         * @return std::size_t
+         */
+        std::size_t row(std::size_t task) const { return task / shardsPerRow; }
+
+        /**
+         * @brief Index of the first element of a task within its row
+         *
+         * @param task
+         * @return std::size_t
+         */
+        std::size_t firstElement(std::size_t task) const { return (task % shardsPerRow) * shardElements; }
+
+        /**
+         * @brief Number of elements of a task
+         *
+         * @param task
+         * @return std::size_t
+         */
+        std::size_t elements(std::size_t task) const { return std::min(shardElements, rowElements - firstElement(task)); }
+
+        /**
+         * @brief Offset of the first packed byte of a task. task == tasks() returns the total number of packed bytes.
+         *
+         * @param task
+         * @return std::size_t
+         */
+        std::size_t byteOffset(std::size_t task) const { return row(task) * rowBytes + firstElement(task) * bitwidth / 8; }
+    };
+
     /**
      * @brief Function to pack multi dimensional input arrays
      *
@@ -536,10 +790,11 @@ namespace Finn {
      * @param last  Iterator to last element of input
      * @param dynamicSpan DynamicMdSpan object that describes the folded structure of the input
      * @param elementsInnerMostDim number of elements in the inner most dimension
+     * @param tuning Sharding parameters, defaults to the built in heuristic
      * @return Finn::vector<uint8_t> Vector of packed bytes
      */
     template<IsDatatype U, typename IteratorType>
-    Finn::vector<uint8_t> packMultiDimensionalInputs(IteratorType first, IteratorType last, const Finn::DynamicMdSpan<IteratorType>& dynamicSpan, const std::size_t elementsInnerMostDim) {
+    Finn::vector<uint8_t> packMultiDimensionalInputs(IteratorType first, IteratorType last, const Finn::DynamicMdSpan<IteratorType>& dynamicSpan, const std::size_t elementsInnerMostDim, const CodecTuning& tuning = {}) {
         auto innerVecs = dynamicSpan.getMostInnerDims();
         std::size_t innerVecSize = innerVecs.size();
 
@@ -550,34 +805,125 @@ namespace Finn {
         const std::size_t neededBytesTotal = neededBytesPerInnerDim * innerVecSize;
 
         Finn::vector<uint8_t> packedMerged(neededBytesTotal);
-        std::size_t threadcount = std::min({(innerVecSize >> 5), static_cast<std::size_t>(omp_get_num_procs()), FinnUtils::fastLog2(innerVecSize) << 1});
-        omp_set_num_threads(threadcount);
-        //        std::cout << (std::min({(innerVecSize >> 5), static_cast<std::size_t>(omp_get_num_procs()), FinnUtils::fastLog2(innerVecSize2)<<1})) << "\n";
-
-        // for each most inner dimension
-#pragma omp parallel for
-        for (std::size_t i = 0; i < innerVecSize; ++i) {
-            auto packed = Finn::pack<U>(innerVecs[i].begin(), innerVecs[i].end());
+        const auto sharding = CodecSharding::create<U>(innerVecSize, elementsInnerMostDim, tuning);
+        FINN_TRACE(codec_pack_start, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+
+        // for each shard of the most inner dimensions
+#pragma omp parallel for num_threads(sharding.threads)
+        for (std::size_t task = 0; task < sharding.tasks(); ++task) {
+            const auto shardBegin = innerVecs[sharding.row(task)].begin() + static_cast<std::ptrdiff_t>(sharding.firstElement(task));
+            auto packed = Finn::pack<U>(shardBegin, shardBegin + static_cast<std::ptrdiff_t>(sharding.elements(task)));
             // combine packing results
-            std::copy(packed.begin(), packed.end(), packedMerged.begin() + i * neededBytesPerInnerDim);
+            std::copy(packed.begin(), packed.end(), packedMerged.begin() + static_cast<std::ptrdiff_t>(sharding.byteOffset(task)));
         }
 
+        FINN_TRACE(codec_pack_done, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
         return packedMerged;
     }
 
+    /**
+     * @brief Function to pack contiguous multi dimensional input arrays directly into a destination such as the map of a buffer object. Does not allocate.
+     * Every thread packs a contiguous block of inner dimensions. Cached destinations are packed into in place, for write-combined or uncached maps the block is packed in chunks into a
+     * staging buffer on the stack and every chunk is written with the matching copy routine. This avoids partial (read-modify-write) accesses on these maps.
+     *
+     * @tparam U Finn Datatype of input data
+     * @tparam T
+     * @param input Input in row major order
+     * @param elementsInnerMostDim number of elements in the inner most dimension
+     * @param destination Destination of the packed bytes. Has to be large enough to hold all packed data
+     * @param mapType Mapping type of the destination
+     * @param tuning Sharding parameters, defaults to the built in heuristic
+     * @return std::size_t Number of bytes written to the destination
+     */
+    template<IsDatatype U, typename T>
+    std::size_t packMultiDimensionalInputs(std::span<const T> input, const std::size_t elementsInnerMostDim, std::span<uint8_t> destination, MAP_TYPE mapType, const CodecTuning& tuning = {}) {
+        if (elementsInnerMostDim == 0 || input.size() % elementsInnerMostDim != 0) {
+            FinnUtils::logAndError<std::invalid_argument>("Input of " + std::to_string(input.size()) + " elements can not be split into inner dimensions of " + std::to_string(elementsInnerMostDim) + " elements!");
+        }
+        const std::size_t innerVecSize = input.size() / elementsInnerMostDim;
+
+        const std::size_t payloadBitsPerInnerDim = elementsInnerMostDim * U().bitwidth();
+        constexpr std::size_t byte = 8;
+        const std::size_t neededBytesPerInnerDim = FinnUtils::fastDivCeil(payloadBitsPerInnerDim, byte);
+        const std::size_t neededBytesTotal = neededBytesPerInnerDim * innerVecSize;
+        if (neededBytesTotal > destination.size()) {
+            FinnUtils::logAndError<std::length_error>("Destination of packing operation is too small! Needed bytes: " + std::to_string(neededBytesTotal) + ", available: " + std::to_string(destination.size()));
+        }
+
+        const auto sharding = CodecSharding::create<U>(innerVecSize, elementsInnerMostDim, tuning);
+        const std::size_t tasksPerThread = FinnUtils::fastDivCeil(sharding.tasks(), sharding.threads);
+        // Chunks of whole bytes for maps that are not cached. A multiple of 8 elements always ends on a byte boundary.
+        constexpr std::size_t mapStagingBytes = 4096;
+        constexpr std::size_t chunkElements = (mapStagingBytes * 8 / U().bitwidth()) & ~std::size_t{7};
+        FINN_TRACE(codec_pack_start, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+
+        // Consecutive shards cover a contiguous byte range of the destination
+#pragma omp parallel for num_threads(sharding.threads)
+        for (std::size_t block = 0; block < sharding.threads; ++block) {
+            const std::size_t begin = block * tasksPerThread;
+            const std::size_t end = std::min(begin + tasksPerThread, sharding.tasks());
+            if (begin >= end) {
+                continue;
+            }
+            if (mapType == MAP_TYPE::CACHED) {
+                for (std::size_t task = begin; task < end; ++task) {
+                    const auto shard = input.subspan(sharding.row(task) * elementsInnerMostDim + sharding.firstElement(task), sharding.elements(task));
+                    Finn::packInto<U>(shard.begin(), shard.end(), destination.subspan(sharding.byteOffset(task)));
+                }
+                continue;
+            }
+            alignas(64) std::array<uint8_t, mapStagingBytes> staging;
+            for (std::size_t task = begin; task < end; ++task) {
+                auto shard = input.subspan(sharding.row(task) * elementsInnerMostDim + sharding.firstElement(task), sharding.elements(task));
+                std::size_t offset = sharding.byteOffset(task);
+                while (!shard.empty()) {
+                    const auto chunk = shard.first(std::min(chunkElements, shard.size()));
+                    const std::size_t chunkBytes = Finn::packInto<U>(chunk.begin(), chunk.end(), staging);
+                    FinnUtils::copyToMap(mapType, destination.data() + offset, staging.data(), chunkBytes);
+                    offset += chunkBytes;
+                    shard = shard.subspan(chunk.size());
+                }
+            }
+        }
+
+        FINN_TRACE(codec_pack_done, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+        return neededBytesTotal;
+    }
 
     /**
-     * @brief Unpacks a byte vector into a vector of T containing U.
+     * @brief Function to pack multi dimensional input arrays directly into a destination such as the map of a buffer object, see the overload for contiguous inputs.
+     *
+     * @tparam U Finn Datatype of input data
+     * @tparam IteratorType
+     * @param first Iterator to first element of input
+     * @param last  Iterator to last element of input
+     * @param dynamicSpan DynamicMdSpan object that describes the folded structure of the input
+     * @param elementsInnerMostDim number of elements in the inner most dimension
+     * @param destination Destination of the packed bytes. Has to be large enough to hold all packed data
+     * @param mapType Mapping type of the destination
+     * @param tuning Sharding parameters, defaults to the built in heuristic
+     * @return std::size_t Number of bytes written to the destination
+     */
+    template<IsDatatype U, typename IteratorType>
+    std::size_t packMultiDimensionalInputs(IteratorType first, IteratorType last, [[maybe_unused]] const Finn::DynamicMdSpan<IteratorType>& dynamicSpan, const std::size_t elementsInnerMostDim, std::span<uint8_t> destination,
+                                           MAP_TYPE mapType, const CodecTuning& tuning = {}) {
+        // The inner dimensions of a DynamicMdSpan are consecutive slices of its contiguous input
+        using T = typename std::iterator_traits<IteratorType>::value_type;
+        return packMultiDimensionalInputs<U, T>(std::span<const T>(std::to_address(first), static_cast<std::size_t>(std::distance(first, last))), elementsInnerMostDim, destination, mapType, tuning);
+    }
+
+
+    /**
+     * @brief Unpacks bytes into a destination of T containing U. Does not allocate. Unpacks exactly as many elements as the destination holds, starting at the first bit of the input.
      *
      * @tparam U FinnDatatype that is contained in byte array
-     * @tparam T Type of return vector. Is usually autodeduced, but it is also supported to use larger types for outputs: ex.: uint16_t instead of uint8_t is valid.
+     * @tparam T Type of the destination. It is also supported to use larger types for outputs: ex.: uint16_t instead of uint8_t is valid.
      * @tparam typename Unnamed template param is used to enable the function only for supported types
-     * @param inp Byte vector
-     * @param padding Number of padding bits inserted into last byte of input
-     * @return Finn::vector<T> Vector of T containing U
+     * @param inp Packed bytes
+     * @param destination Destination of the unpacked elements
      */
-    template<IsDatatype U, bool reverseByte = false, typename T = UnpackingAutoRetType::AutoRetType<U>, typename = std::enable_if_t<IsCorrectFinnType<U, T>()>>
-    Finn::vector<T> unpack(std::span<uint8_t>& inp, std::size_t padding = 0) {
+    template<IsDatatype U, typename T = UnpackingAutoRetType::AutoRetType<U>, typename = std::enable_if_t<IsCorrectFinnType<U, T>()>>
+    void unpackInto(std::span<const uint8_t> inp, std::span<T> destination) {
         static_assert(U().bitwidth() <= 64, "Finn Datatypes with more than 64 bit are not supported!");
 
         constexpr std::size_t neededBytes = FinnUtils::fastDivCeil(U().bitwidth(), 8UL);
@@ -587,82 +933,90 @@ namespace Finn {
         using FixedPointType = typename std::conditional<neededBytes == 1, int8_t, TwoBytesOrLonger>::type;
         using RetType = typename std::conditional<U().isFixedPoint(), FixedPointType, T>::type;
 
-        if (inp.empty()) {
-            FinnUtils::logAndError<std::runtime_error>("Input to unpacking operation is empty! Abord.");
-        }
-
-        if constexpr (reverseByte) {
-            std::reverse(inp.begin(), inp.end());
+        constexpr std::size_t bitwidth = U().bitwidth();
+        constexpr bool isSigned = U().sign();
+        constexpr bool isFixed = U().isFixedPoint();
+        if (inp.size() * 8 < destination.size() * bitwidth) {
+            FinnUtils::logAndError<std::length_error>("Input to unpacking operation is too small! Needed bits: " + std::to_string(destination.size() * bitwidth) + ", available: " + std::to_string(inp.size() * 8));
         }
 
-        if ((inp.size() * 8 - padding) % U().bitwidth() != 0) {
-            FinnUtils::logAndError<std::runtime_error>("Amount of input elements is not a multiple of output elements");
-        }
+        const auto store = [&destination](std::size_t index, RetType val) {
+            if constexpr (isFixed) {
+                destination[index] = static_cast<float>(val) / (1 << U().fracBits());
+            } else {
+                destination[index] = val;
+            }
+        };
 
-        constexpr size_t bitw = U().bitwidth();
-        constexpr bool isSigned = U().sign();
-        if constexpr (bitw / 8.0 == neededBytes) {  // complete Bytes, therefore no padding after here
-            Finn::vector<RetType> ret(inp.size() / neededBytes, 0);
-            for (std::size_t i = 0; i < ret.size(); ++i) {
+        if constexpr (bitwidth % 8 == 0) {  // complete Bytes, therefore no padding after here
+            for (std::size_t i = 0; i < destination.size(); ++i) {
                 const std::size_t offset = i * neededBytes;
-                if constexpr (isSigned) {  // TODO(linusjun): Test if this needs to be optimized or put into a seperate loop to allow vectorization.
-                    if ((-128 & inp[offset + neededBytes - 1]) != 0) {
-                        ret[i] = -1;
+                RetType val = 0;
+                if constexpr (isSigned) {
+                    if ((inp[offset + neededBytes - 1] & 0x80U) != 0) {
+                        val = -1;
                     }
                 }
-                std::memcpy(&ret.data()[i], &inp.data()[offset], neededBytes);
-            }
-            constexpr bool isFixed = U().isFixedPoint();
-            if constexpr (isFixed) {
-                Finn::vector<float> fixedRet(ret.size());
-                std::transform(ret.begin(), ret.end(), fixedRet.begin(), [](const RetType& val) { return static_cast<float>(val) / (1 << U().fracBits()); });
-                return fixedRet;
-            } else {
-                return ret;
+                std::memcpy(&val, &inp[offset], neededBytes);
+                store(i, val);
             }
-
-
         } else {
-            constexpr std::size_t bitwidth = U().bitwidth();
-
             using FourBytesOrLongerUnsigned = typename std::conditional<bitwidth <= 32, uint64_t, __uint128_t>::type;
             using TwoBytesOrLongerUnsigned = typename std::conditional<bitwidth <= 16, uint32_t, FourBytesOrLongerUnsigned>::type;
             using BufferType = typename std::conditional<bitwidth <= 8, uint16_t, TwoBytesOrLongerUnsigned>::type;
 
             constexpr BufferType mask = createMask<BufferType>(bitwidth);
-            const std::size_t elementsInInput = ((inp.size() * 8) - padding) / U().bitwidth();
-            Finn::vector<RetType> ret(elementsInInput, 0);
-
-            for (std::size_t index = 0; index < elementsInInput; ++index) {
+            for (std::size_t index = 0; index < destination.size(); ++index) {
                 const std::size_t lowerBit = index * bitwidth;
                 const std::size_t lowerBorderByte = lowerBit / 8;                   // Intentionally rounding down
                 const std::size_t upperBorderByte = (lowerBit + bitwidth - 1) / 8;  // Intentionally rounding down
                 const std::size_t numBytes = upperBorderByte - lowerBorderByte + 1;
                 const std::size_t shiftOffset = lowerBit - (lowerBorderByte * 8);
 
-                BufferType buffer = 0;                                         // This buffer is big enough to contain two FinnDatatype elements. Therefore no problem if one FinnDatatype element is shifted.
-                std::memcpy(&buffer, &inp.data()[lowerBorderByte], numBytes);  // Fill Buffer with from byte inputs
-                buffer = static_cast<BufferType>(buffer >> shiftOffset);       // remove remaining bits from previous element
-                buffer &= mask;                                                // remove bits from next element
-
-                constexpr bool isSigned = U().sign();
-                if constexpr (isSigned) {  // TODO(linusjun): Test if this needs to be optimized or put into a seperate loop to allow vectorization.
+                BufferType buffer = 0;  // This buffer is big enough to contain two FinnDatatype elements. Therefore no problem if one FinnDatatype element is shifted.
+                std::memcpy(&buffer, &inp[lowerBorderByte], numBytes);
+                buffer = static_cast<BufferType>(buffer >> shiftOffset);  // remove remaining bits from previous element
+                buffer &= mask;                                           // remove bits from next element
+                if constexpr (isSigned) {
                     if (((BufferType(1U) << (bitwidth - 1)) & buffer) != 0) {
-                        buffer |= ~mask;
+                        buffer |= static_cast<BufferType>(~mask);
                     }
                 }
-                ret[index] = static_cast<RetType>(buffer);
+                store(index, static_cast<RetType>(buffer));
             }
+        }
+    }
 
-            constexpr bool isFixed = U().isFixedPoint();
-            if constexpr (isFixed) {
-                Finn::vector<float> fixedRet(ret.size());
-                std::transform(ret.begin(), ret.end(), fixedRet.begin(), [](const RetType& val) { return static_cast<float>(static_cast<FixedPointType>(val)) / (1 << U().fracBits()); });
-                return fixedRet;
-            } else {
-                return ret;
-            }
+    /**
+     * @brief Unpacks a byte vector into a vector of T containing U.
+     *
+     * @tparam U FinnDatatype that is contained in byte array
+     * @tparam T Type of return vector. Is usually autodeduced, but it is also supported to use larger types for outputs: ex.: uint16_t instead of uint8_t is valid.
+     * @tparam typename Unnamed template param is used to enable the function only for supported types
+     * @param inp Byte vector
+     * @param padding Number of padding bits inserted into last byte of input
+     * @return Finn::vector<T> Vector of T containing U
+     */
+    template<IsDatatype U, bool reverseByte = false, typename T = UnpackingAutoRetType::AutoRetType<U>, typename = std::enable_if_t<IsCorrectFinnType<U, T>()>>
+    Finn::vector<T> unpack(std::span<uint8_t>& inp, std::size_t padding = 0) {
+        if (inp.empty()) {
+            FinnUtils::logAndError<std::runtime_error>("Input to unpacking operation is empty! Abord.");
+        }
+
+        if constexpr (reverseByte) {
+            std::reverse(inp.begin(), inp.end());
+        }
+
+        if ((inp.size() * 8 - padding) % U().bitwidth() != 0) {
+            FinnUtils::logAndError<std::runtime_error>("Amount of input elements is not a multiple of output elements");
         }
+
+        constexpr std::size_t bitwidth = U().bitwidth();
+        // Complete bytes contain no padding
+        const std::size_t elementsInInput = (bitwidth % 8 == 0) ? inp.size() / (bitwidth / 8) : ((inp.size() * 8) - padding) / bitwidth;
+        Finn::vector<T> ret(elementsInInput);
+        unpackInto<U, T>(inp, ret);
+        return ret;
     }
 
     /**
@@ -681,6 +1035,41 @@ namespace Finn {
         return unpack<U, reverseByte, T>(spa, padding);
     }
 
+    /**
+     * @brief Unpacks contiguous multi-dimensional outputs into a destination. Does not allocate.
+     *
+     * @tparam U FinnDatatype that is contained in byte array
+     * @tparam T Type of the destination. Usually autodeduced.
+     * @param packed Linearized byte array. Every inner dimension occupies the same number of bytes
+     * @param foldedShape Shape of the target
+     * @param destination Destination of the unpacked elements. Has to hold exactly the elements of the folded shape
+     * @param tuning Sharding parameters, defaults to the built in heuristic
+     */
+    template<IsDatatype U, typename T = UnpackingAutoRetType::AutoRetType<U>, typename = std::enable_if_t<IsCorrectFinnType<U, T>()>>
+    void unpackMultiDimensionalOutputs(std::span<const uint8_t> packed, const shapeFolded_t& foldedShape, std::span<T> destination, const CodecTuning& tuning = {}) {
+        const std::size_t retSizeTotal = FinnUtils::shapeToElements(foldedShape);
+        if (destination.size() != retSizeTotal) {
+            FinnUtils::logAndError<std::length_error>("Destination of unpacking operation holds " + std::to_string(destination.size()) + " elements, but the output has " + std::to_string(retSizeTotal) + " elements!");
+        }
+        const std::size_t rows = retSizeTotal / foldedShape.back();
+        const std::size_t packedRowBytes = packed.size() / rows;
+        const auto sharding = CodecSharding::create<U>(rows, foldedShape.back(), tuning);
+        if (packedRowBytes < sharding.rowBytes) {
+            FinnUtils::logAndError<std::length_error>("Input to unpacking operation is too small! Needed bytes: " + std::to_string(sharding.rowBytes * rows) + ", available: " + std::to_string(packed.size()));
+        }
+        FINN_TRACE(codec_unpack_start, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+
+#pragma omp parallel for num_threads(sharding.threads)
+        for (std::size_t task = 0; task < sharding.tasks(); ++task) {
+            const std::size_t row = sharding.row(task);
+            // Rows of the packed input may be longer than their payload
+            const std::size_t offset = row * packedRowBytes + sharding.byteOffset(task) - row * sharding.rowBytes;
+            Finn::unpackInto<U, T>(packed.subspan(offset), destination.subspan(row * sharding.rowElements + sharding.firstElement(task), sharding.elements(task)));
+        }
+
+        FINN_TRACE(codec_unpack_done, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+    }
+
     /**
      * @brief Unpacks multi-dimensional output vectors
      *
@@ -692,28 +1081,43 @@ namespace Finn {
      * @param end Iterator to the end of linearized byte array
      * @param dynSpan DynamicMdSpan describing the structure of the byte array
      * @param foldedShape Shape of the target vector
+     * @param tuning Sharding parameters, defaults to the built in heuristic
      * @return Finn::vector<T> Vector of T containing U
      */
     template<IsDatatype U, std::input_iterator IteratorType, bool reverseByte = false, typename T = UnpackingAutoRetType::AutoRetType<U>, typename = std::enable_if_t<IsCorrectFinnType<U, T>()>>
-    Finn::vector<T> unpackMultiDimensionalOutputs(IteratorType begin, IteratorType end, const Finn::DynamicMdSpan<IteratorType>& dynSpan, const shapeFolded_t& foldedShape)
+    Finn::vector<T> unpackMultiDimensionalOutputs(IteratorType begin, IteratorType end, [[maybe_unused]] const Finn::DynamicMdSpan<IteratorType>& dynSpan, const shapeFolded_t& foldedShape, const CodecTuning& tuning = {})
         requires(std::is_same_v<uint8_t, typename std::iterator_traits<IteratorType>::value_type>)
     {
-        constexpr std::size_t bytes = 8;
-        auto innerDimVecs = dynSpan.getMostInnerDims();
-        std::size_t innerVecSize = innerDimVecs.size();
-        const std::size_t padding = innerDimVecs[0].size() * bytes - foldedShape.back() * U().bitwidth();
-
-        // preallocate memory to make copy more efficient
         const std::size_t retSizeTotal = FinnUtils::shapeToElements(foldedShape);
-        Finn::vector<T> unpackedMerged(retSizeTotal);
+        if constexpr (std::contiguous_iterator<IteratorType>) {
+            // The inner dimensions of a DynamicMdSpan are consecutive slices of its contiguous input
+            Finn::vector<T> unpackedMerged(retSizeTotal);
+            unpackMultiDimensionalOutputs<U, T>(std::span<const uint8_t>(std::to_address(begin), static_cast<std::size_t>(std::distance(begin, end))), foldedShape, std::span<T>(unpackedMerged), tuning);
+            return unpackedMerged;
+        } else {
+            constexpr std::size_t bytes = 8;
+            auto innerDimVecs = dynSpan.getMostInnerDims();
+            const std::size_t padding = innerDimVecs[0].size() * bytes - foldedShape.back() * U().bitwidth();
+
+            // preallocate memory to make copy more efficient
+            Finn::vector<T> unpackedMerged(retSizeTotal);
+            const auto sharding = CodecSharding::create<U>(innerDimVecs.size(), foldedShape.back(), tuning);
+            FINN_TRACE(codec_unpack_start, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+
+#pragma omp parallel for num_threads(sharding.threads)
+            for (std::size_t task = 0; task < sharding.tasks(); ++task) {
+                const std::size_t row = sharding.row(task);
+                const std::size_t rowOffset = sharding.byteOffset(task) - row * sharding.rowBytes;
+                // Only the last shard of a row contains the padding of the row
+                const bool lastShard = sharding.firstElement(task) + sharding.elements(task) == sharding.rowElements;
+                auto shard = innerDimVecs[row].subspan(rowOffset, lastShard ? innerDimVecs[row].size() - rowOffset : sharding.elements(task) * U().bitwidth() / bytes);
+                auto unpacked = Finn::unpack<U>(shard, lastShard ? padding : 0);
+                std::copy(unpacked.begin(), unpacked.end(), unpackedMerged.begin() + static_cast<std::ptrdiff_t>(row * sharding.rowElements + sharding.firstElement(task)));
+            }
 
-#pragma omp parallel for
-        for (std::size_t i = 0; i < innerDimVecs.size(); ++i) {
-            auto unpacked = Finn::unpack<U>(innerDimVecs[i], padding);
-            std::copy(unpacked.begin(), unpacked.end(), unpackedMerged.begin() + i * foldedShape.back());
+            FINN_TRACE(codec_unpack_done, sharding.rows, sharding.rowElements, sharding.bitwidth, sharding.threads);
+            return unpackedMerged;
         }
-
-        return unpackedMerged;
     }
 
 }  // namespace Finn
@@ -0,0 +1,401 @@
+/**
+ * @file LiveStats.h
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Process wide live counters of the driver (throughput, stage latencies, device busy time, ...) that are published by the StatsPublisher
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef LIVESTATS_H
+#define LIVESTATS_H
+
+#include <FINNCppDriver/utils/AllocationCounter.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace FinnUtils {
+    /**
+     * @brief Live counters of the driver. Recording is disabled by default; while disabled, recording costs one relaxed atomic load.
+     * All updates are relaxed atomic increments, so the hot path never blocks. Stage latencies are kept in histograms with power of two buckets.
+     *
+     */
+    class LiveStats {
+         public:
+        /**
+         * @brief Number of latency histograms. Indexed by DRIVER_STAGE, the slot of DRIVER_STAGE::NONE holds the latency of the whole raw inference.
+         *
+         */
+        static constexpr std::size_t latencySlots = AllocationCounter::stageCount;
+        /**
+         * @brief Number of histogram buckets. Bucket b counts latencies in [2^(b-1), 2^b) ns, the last bucket everything above.
+         *
+         */
+        static constexpr std::size_t histogramBuckets = 40;
+        /**
+         * @brief Number of devices for which the busy time is tracked
+         *
+         */
+        static constexpr std::size_t maxDevices = 8;
+
+        /**
+         * @brief Latency histogram
+         *
+         */
+        using Histogram = std::array<uint64_t, histogramBuckets>;
+
+        /**
+         * @brief Copy of all counters. Trivially copyable, so that it can be placed in shared memory.
+         *
+         */
+        struct Snapshot {
+            /**
+             * @brief Number of raw inferences
+             *
+             */
+            uint64_t inferences = 0;
+            /**
+             * @brief Number of batch elements (samples) processed
+             *
+             */
+            uint64_t batchElements = 0;
+            /**
+             * @brief Packed bytes sent to the devices
+             *
+             */
+            uint64_t bytesIn = 0;
+            /**
+             * @brief Packed bytes received from the devices
+             *
+             */
+            uint64_t bytesOut = 0;
+            /**
+             * @brief Register polls while waiting for kernels
+             *
+             */
+            uint64_t waitPolls = 0;
+            /**
+             * @brief Parts in the most recently used submission queue
+             *
+             */
+            uint64_t ringUsed = 0;
+            /**
+             * @brief Capacity in parts of the most recently used submission queue
+             *
+             */
+            uint64_t ringCapacity = 0;
+            /**
+             * @brief Generation of the runtime tunables most recently applied by a driver
+             *
+             */
+            uint64_t tunablesGeneration = 0;
+            /**
+             * @brief Duplicate launches of slow requests on another device
+             *
+             */
+            uint64_t hedges = 0;
+            /**
+             * @brief Requests answered by their duplicate launch
+             *
+             */
+            uint64_t hedgeWins = 0;
+            /**
+             * @brief Time in ns every device spent executing kernels
+             *
+             */
+            std::array<uint64_t, maxDevices> deviceBusyNs{};
+            /**
+             * @brief Latency histograms indexed by DRIVER_STAGE
+             *
+             */
+            std::array<Histogram, latencySlots> latency{};
+        };
+
+         private:
+        inline static std::atomic<bool> enabled{false};
+        inline static std::atomic<uint64_t> inferences{0};
+        inline static std::atomic<uint64_t> batchElements{0};
+        inline static std::atomic<uint64_t> bytesIn{0};
+        inline static std::atomic<uint64_t> bytesOut{0};
+        inline static std::atomic<uint64_t> waitPolls{0};
+        inline static std::atomic<uint64_t> ringUsed{0};
+        inline static std::atomic<uint64_t> ringCapacity{0};
+        inline static std::atomic<uint64_t> tunablesGeneration{0};
+        inline static std::atomic<uint64_t> hedges{0};
+        inline static std::atomic<uint64_t> hedgeWins{0};
+        inline static std::array<std::atomic<uint64_t>, maxDevices> deviceBusyNs{};
+        inline static std::array<std::array<std::atomic<uint64_t>, histogramBuckets>, latencySlots> latency{};
+
+         public:
+        /**
+         * @brief Start recording
+         *
+         */
+        static void enable() noexcept { enabled.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Stop recording
+         *
+         */
+        static void disable() noexcept { enabled.store(false, std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns whether counters are recorded
+         *
+         * @return true
+         * @return false
+         */
+        static bool isEnabled() noexcept { return enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Histogram bucket of a latency
+         *
+         * @param ns
+         * @return std::size_t
+         */
+        static constexpr std::size_t bucket(uint64_t ns) noexcept {
+            // Same as std::bit_width, whose return type differs between standard library versions
+            const int width = std::numeric_limits<uint64_t>::digits - std::countl_zero(ns);
+            return std::min(static_cast<std::size_t>(width), histogramBuckets - 1);
+        }
+
+        /**
+         * @brief Record the latency of a driver stage
+         *
+         * @param stage DRIVER_STAGE::NONE for the whole raw inference
+         * @param ns
+         */
+        static void recordLatency(DRIVER_STAGE stage, uint64_t ns) noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            latency[static_cast<std::size_t>(stage)][bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record time a device spent executing kernels
+         *
+         * @param device Device index, devices beyond maxDevices are not tracked
+         * @param ns
+         */
+        static void recordDeviceBusy(std::size_t device, uint64_t ns) noexcept {
+            if (!isEnabled() || device >= maxDevices) {
+                return;
+            }
+            deviceBusyNs[device].fetch_add(ns, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record a finished raw inference
+         *
+         * @param pBytesIn Packed input bytes
+         * @param pBytesOut Packed output bytes
+         * @param pBatchElements Batch size of the inference
+         */
+        static void recordInference(uint64_t pBytesIn, uint64_t pBytesOut, uint64_t pBatchElements) noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            inferences.fetch_add(1, std::memory_order_relaxed);
+            batchElements.fetch_add(pBatchElements, std::memory_order_relaxed);
+            bytesIn.fetch_add(pBytesIn, std::memory_order_relaxed);
+            bytesOut.fetch_add(pBytesOut, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record output that is retrieved separately from its inference, as done by asynchronous inference
+         *
+         * @param pBytesOut Packed output bytes
+         */
+        static void recordOutput(uint64_t pBytesOut) noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            bytesOut.fetch_add(pBytesOut, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record register polls of a kernel wait
+         *
+         * @param polls
+         */
+        static void recordPolls(uint64_t polls) noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            waitPolls.fetch_add(polls, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Update the occupancy of the submission queue
+         *
+         * @param used Parts currently in the queue
+         * @param capacity Parts the queue can hold
+         */
+        static void setRingOccupancy(uint64_t used, uint64_t capacity) noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            ringUsed.store(used, std::memory_order_relaxed);
+            ringCapacity.store(capacity, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record a duplicate launch of a slow request
+         *
+         */
+        static void recordHedge() noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            hedges.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record a request that was answered by its duplicate launch
+         *
+         */
+        static void recordHedgeWin() noexcept {
+            if (!isEnabled()) {
+                return;
+            }
+            hedgeWins.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Record that a driver applied the runtime tunables. Recorded even while disabled, since it only changes on reconfiguration.
+         *
+         * @param generation
+         */
+        static void recordTunablesApplied(uint64_t generation) noexcept { tunablesGeneration.store(generation, std::memory_order_relaxed); }
+
+        /**
+         * @brief Copy all counters
+         *
+         * @return Snapshot
+         */
+        static Snapshot snapshot() noexcept {
+            Snapshot ret;
+            ret.inferences = inferences.load(std::memory_order_relaxed);
+            ret.batchElements = batchElements.load(std::memory_order_relaxed);
+            ret.bytesIn = bytesIn.load(std::memory_order_relaxed);
+            ret.bytesOut = bytesOut.load(std::memory_order_relaxed);
+            ret.waitPolls = waitPolls.load(std::memory_order_relaxed);
+            ret.ringUsed = ringUsed.load(std::memory_order_relaxed);
+            ret.ringCapacity = ringCapacity.load(std::memory_order_relaxed);
+            ret.tunablesGeneration = tunablesGeneration.load(std::memory_order_relaxed);
+            ret.hedges = hedges.load(std::memory_order_relaxed);
+            ret.hedgeWins = hedgeWins.load(std::memory_order_relaxed);
+            for (std::size_t device = 0; device < maxDevices; ++device) {
+                ret.deviceBusyNs[device] = deviceBusyNs[device].load(std::memory_order_relaxed);
+            }
+            for (std::size_t slot = 0; slot < latencySlots; ++slot) {
+                for (std::size_t b = 0; b < histogramBuckets; ++b) {
+                    ret.latency[slot][b] = latency[slot][b].load(std::memory_order_relaxed);
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Reset all counters
+         *
+         */
+        static void reset() noexcept {
+            for (auto* counter : {&inferences, &batchElements, &bytesIn, &bytesOut, &waitPolls, &ringUsed, &ringCapacity, &hedges, &hedgeWins}) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (auto& counter : deviceBusyNs) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            for (auto& histogram : latency) {
+                for (auto& counter : histogram) {
+                    counter.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Approximate percentile of a histogram. Returns the upper bound of the bucket containing the percentile.
+         *
+         * @param histogram
+         * @param fraction Percentile in [0, 1], e.g. 0.99
+         * @return uint64_t Latency in ns, 0 if the histogram is empty
+         */
+        static uint64_t percentile(const Histogram& histogram, double fraction) noexcept {
+            uint64_t total = 0;
+            for (auto count : histogram) {
+                total += count;
+            }
+            if (total == 0) {
+                return 0;
+            }
+            const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5));
+            uint64_t seen = 0;
+            for (std::size_t b = 0; b < histogramBuckets; ++b) {
+                seen += histogram[b];
+                if (seen >= rank) {
+                    return uint64_t{1} << b;
+                }
+            }
+            return uint64_t{1} << (histogramBuckets - 1);
+        }
+
+        /**
+         * @brief Measures the latency of a driver stage from construction until stop() or destruction. Does not read the clock while recording is disabled.
+         *
+         */
+        class StageTimer {
+             private:
+            DRIVER_STAGE stage;
+            std::size_t device;
+            bool active;
+            std::chrono::steady_clock::time_point start;
+
+             public:
+            /**
+             * @brief Construct a new Stage Timer object
+             *
+             * @param pStage
+             * @param pDevice If smaller than maxDevices, the latency is also added to the busy time of this device
+             */
+            explicit StageTimer(DRIVER_STAGE pStage, std::size_t pDevice = maxDevices) noexcept
+                : stage(pStage), device(pDevice), active(isEnabled()), start(active ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}) {}
+            /**
+             * @brief Destroy the Stage Timer object. Records the latency, if stop() was not called before.
+             *
+             */
+            ~StageTimer() { stop(); }
+            StageTimer(const StageTimer&) = delete;
+            StageTimer(StageTimer&&) = delete;
+            StageTimer& operator=(const StageTimer&) = delete;
+            StageTimer& operator=(StageTimer&&) = delete;
+
+            /**
+             * @brief Record the latency up to now
+             *
+             */
+            void stop() noexcept {
+                if (!active) {
+                    return;
+                }
+                active = false;
+                const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+                recordLatency(stage, ns);
+                recordDeviceBusy(device, ns);
+            }
+        };
+    };
+}  // namespace FinnUtils
+
+#endif  // LIVESTATS_H
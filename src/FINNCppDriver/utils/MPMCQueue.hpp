@@ -0,0 +1,296 @@
+/**
+ * @file MPMCQueue.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Implements a bounded lock-free multi producer multi consumer queue of part sized slots
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are
+ * made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef MPMCQUEUE
+#define MPMCQUEUE
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stop_token>
+#include <thread>
+
+namespace Finn {
+    /**
+     * @brief Bounded multi producer multi consumer queue after Dmitry Vyukov. Every slot holds one part (one batch element) and has its own sequence number,
+     * so producers and consumers only synchronize on the slot they use and on one position counter each. No mutex is taken on the submission path.
+     * Blocked producers wait on the sequence number of the slot they want to fill and are only woken when exactly this slot is freed.
+     * Blocked consumers park on a shared signal that producers only touch while a consumer is actually waiting.
+     *
+     * The interface follows RingBuffer<T, true>, so that it can be used as submission queue of the asynchronous input buffers.
+     * Parts of one multi part store() can interleave with parts of other producers, but every part stays contiguous.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class MPMCQueue {
+         private:
+        /**
+         * @brief Sequence number of a slot. Padded to a cache line to avoid false sharing between neighbouring slots.
+         *
+         */
+        struct alignas(64) Slot {
+            std::atomic<std::size_t> sequence;
+        };
+
+        std::size_t elementsPerPart;
+        std::size_t slotCount;
+        std::unique_ptr<Slot[]> slots;
+        Finn::vector<T> data;
+
+        alignas(64) std::atomic<std::size_t> enqueuePos{0};
+        alignas(64) std::atomic<std::size_t> dequeuePos{0};
+        alignas(64) std::atomic<std::uint32_t> waitingConsumers{0};
+        std::atomic<std::uint32_t> consumerSignal{0};
+
+        /**
+         * @brief Number of unsuccessful attempts before a blocked thread goes to sleep
+         *
+         */
+        static constexpr int spinLimit = 64;
+
+        /**
+         * @brief A small prefix to determine the source of the log write
+         *
+         * @return std::string
+         */
+        std::string static loggerPrefix() { return "[MPMCQueue] "; }
+
+        void wakeConsumers() {
+            // Pairs with the fence in read(): either the consumer sees the new part or we see the waiting consumer
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waitingConsumers.load(std::memory_order_relaxed) != 0) {
+                consumerSignal.fetch_add(1, std::memory_order_release);
+                consumerSignal.notify_all();
+            }
+        }
+
+         public:
+        /**
+         * @brief Construct a new MPMC Queue object that holds exactly pParts parts
+         *
+         * @param pParts
+         * @param pElementsPerPart
+         */
+        MPMCQueue(const std::size_t pParts, const std::size_t pElementsPerPart)
+            : elementsPerPart(pElementsPerPart), slotCount(pParts), slots(std::make_unique<Slot[]>(slotCount)), data(slotCount * pElementsPerPart) {
+            if (pElementsPerPart * pParts == 0) {
+                FinnUtils::logAndError<std::runtime_error>("It is not possible to create a buffer of size 0!");
+            }
+            for (std::size_t i = 0; i < slotCount; ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            FINN_LOG(Logger::getLogger(), loglevel::info) << loggerPrefix() << "Initialised with " << pElementsPerPart << " Elements per Part and " << slotCount << " Parts.\n";
+        }
+
+        MPMCQueue(MPMCQueue&& other) = delete;
+        MPMCQueue(const MPMCQueue& other) = delete;
+        ~MPMCQueue() = default;
+        MPMCQueue& operator=(MPMCQueue&& other) = delete;
+        MPMCQueue& operator=(const MPMCQueue& other) = delete;
+
+        /**
+         * @brief Try to store exactly one part. Never blocks.
+         *
+         * @tparam IteratorType
+         * @param first Iterator to the first element of the part. The part has to contain elementsPerPart values.
+         * @return true Part was stored
+         * @return false Queue is full
+         */
+        template<typename IteratorType>
+        bool tryStorePart(IteratorType first) {
+            std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            while (true) {
+                slot = &slots[pos % slotCount];
+                const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            std::copy_n(first, elementsPerPart, data.begin() + static_cast<std::ptrdiff_t>((pos % slotCount) * elementsPerPart));
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            wakeConsumers();
+            return true;
+        }
+
+        /**
+         * @brief Try to read exactly one part. Never blocks.
+         *
+         * @tparam IteratorType
+         * @param outputIt
+         * @return true Part was read and invalidated
+         * @return false Queue is empty
+         */
+        template<typename IteratorType>
+        bool tryReadPart(IteratorType outputIt) {
+            std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            while (true) {
+                slot = &slots[pos % slotCount];
+                const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+            const auto begin = data.begin() + static_cast<std::ptrdiff_t>((pos % slotCount) * elementsPerPart);
+            std::copy(begin, begin + static_cast<std::ptrdiff_t>(elementsPerPart), outputIt);
+            slot->sequence.store(pos + slotCount, std::memory_order_release);
+            // Only producers waiting for exactly this slot are woken
+            slot->sequence.notify_all();
+            return true;
+        }
+
+        /**
+         * @brief Stores data in the queue. The data has to be a multiple of a part. Blocks until all parts are stored.
+         *
+         * @tparam IteratorType
+         * @param first
+         * @param last
+         * @return true
+         */
+        template<typename IteratorType>
+        bool store(IteratorType first, IteratorType last) {
+            const std::size_t datasize = static_cast<std::size_t>(std::abs(std::distance(first, last)));
+            if (datasize % elementsPerPart != 0) {
+                FinnUtils::logAndError<std::runtime_error>("It is not possible to store data that is not a multiple of a part! Datasize: " + std::to_string(datasize) + ", Elements per Part: " + std::to_string(elementsPerPart) + "\n");
+            }
+            for (auto part = first; part != last; part += static_cast<std::ptrdiff_t>(elementsPerPart)) {
+                int attempts = 0;
+                while (!tryStorePart(part)) {
+                    if (++attempts < spinLimit) {
+                        continue;
+                    }
+                    // Sleep until the slot this producer is going to fill next has been consumed
+                    const std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+                    const std::size_t seq = slots[pos % slotCount].sequence.load(std::memory_order_acquire);
+                    if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos) < 0) {
+                        slots[pos % slotCount].sequence.wait(seq, std::memory_order_acquire);
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Read one part from the queue. Blocks until a part is available or a stop is requested.
+         *
+         * @tparam IteratorType
+         * @param outputIt
+         * @param stoken Needed for threaded operation. Do not set by hand!
+         * @return true Part was read
+         * @return false Stop was requested
+         */
+        template<typename IteratorType>
+        bool read(IteratorType outputIt, std::stop_token stoken = {}) {
+            for (int attempts = 0; attempts < spinLimit; ++attempts) {
+                if (tryReadPart(outputIt)) {
+                    return true;
+                }
+            }
+            const std::stop_callback wakeOnStop(stoken, [this]() {
+                consumerSignal.fetch_add(1, std::memory_order_release);
+                consumerSignal.notify_all();
+            });
+            while (!stoken.stop_requested()) {
+                waitingConsumers.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const std::uint32_t signal = consumerSignal.load(std::memory_order_acquire);
+                if (tryReadPart(outputIt)) {
+                    waitingConsumers.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+                if (!stoken.stop_requested()) {
+                    consumerSignal.wait(signal, std::memory_order_acquire);
+                }
+                waitingConsumers.fetch_sub(1, std::memory_order_relaxed);
+                if (tryReadPart(outputIt)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Tests if the queue is empty. Only a snapshot while other threads access the queue.
+         *
+         * @return true
+         * @return false
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Tests if the queue is full. Only a snapshot while other threads access the queue.
+         *
+         * @return true
+         * @return false
+         */
+        bool full() const { return size() == slotCount; }
+
+        /**
+         * @brief Get the number of parts currently stored. Only a snapshot while other threads access the queue.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            const std::size_t head = dequeuePos.load(std::memory_order_acquire);
+            const std::size_t tail = enqueuePos.load(std::memory_order_acquire);
+            return (tail > head) ? std::min(tail - head, slotCount) : 0;
+        }
+
+        /**
+         * @brief Return the queue's size, either in elements of T, in bytes or in parts
+         *
+         * @param ss
+         * @return size_t
+         */
+        size_t size(SIZE_SPECIFIER ss) const {
+            if (ss == SIZE_SPECIFIER::TOTAL_DATA_SIZE) {
+                return slotCount * elementsPerPart;
+            } else if (ss == SIZE_SPECIFIER::BYTES) {
+                return slotCount * elementsPerPart * sizeof(T);
+            } else if (ss == SIZE_SPECIFIER::BATCHSIZE) {
+                return slotCount;
+            } else if (ss == SIZE_SPECIFIER::FEATUREMAP_SIZE) {
+                return elementsPerPart;
+            } else {
+                FinnUtils::logAndError<std::runtime_error>("Unknown size specifier!");
+                return 0;
+            }
+        }
+    };
+}  // namespace Finn
+
+#endif  // MPMCQUEUE
@@ -0,0 +1,425 @@
+/**
+ * @file PackedView.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Compact result types for sub-byte FINN datatypes that keep the packed bit layout instead of expanding every element into a byte
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef PACKEDVIEW
+#define PACKEDVIEW
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/utils/AlignedAllocator.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <utility>
+
+namespace Finn {
+    /**
+     * @brief Checks if a FINN datatype can be accessed in its packed form. Elements of these types never span more than two bytes.
+     *
+     * @tparam U
+     * @return true
+     * @return false
+     */
+    template<IsDatatype U>
+    consteval bool isCompactDatatype() {
+        return U().isInteger() && !U().isFixedPoint() && U().bitwidth() <= 8;
+    }
+
+    /**
+     * @brief Concept for FINN datatypes that can be accessed in their packed form
+     *
+     * @tparam U
+     */
+    template<typename U>
+    concept IsCompactDatatype = IsDatatype<U> && isCompactDatatype<U>();
+
+    /**
+     * @brief Non-owning view of packed output data of a sub-byte FINN datatype.
+     *
+     * The layout is the one produced by the FPGA and consumed by unpackMultiDimensionalOutputs: Elements are stored LSB first, one after another.
+     * Every row (innermost dimension of the folded shape) is padded to a full byte. The view decodes elements on access, so consumers that only
+     * need a few elements or work on the bits directly (popcount, hashing, masks) never pay for the expansion into one byte per element.
+     *
+     * Decoded values match unpack<U>, with the exception of DatatypeBipolar, which is decoded to -1 and 1 (the inverse of pack<DatatypeBipolar>).
+     *
+     * @tparam U FINN datatype of the elements
+     */
+    template<IsCompactDatatype U>
+    class PackedView {
+         public:
+        /**
+         * @brief Type of a decoded element
+         *
+         */
+        using value_type = UnpackingAutoRetType::AutoRetType<U>;
+
+        /**
+         * @brief Random access iterator over the decoded elements
+         *
+         */
+        class Iterator {
+             private:
+            const PackedView* view = nullptr;
+            std::ptrdiff_t index = 0;
+
+             public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = PackedView::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type;
+            using pointer = void;
+
+            Iterator() = default;
+            /**
+             * @brief Construct a new Iterator object
+             *
+             * @param pView
+             * @param pIndex
+             */
+            Iterator(const PackedView* pView, std::ptrdiff_t pIndex) : view(pView), index(pIndex) {}
+
+            value_type operator*() const { return (*view)[static_cast<std::size_t>(index)]; }
+            value_type operator[](difference_type n) const { return (*view)[static_cast<std::size_t>(index + n)]; }
+
+            Iterator& operator++() {
+                ++index;
+                return *this;
+            }
+            Iterator operator++(int) {
+                Iterator tmp = *this;
+                ++index;
+                return tmp;
+            }
+            Iterator& operator--() {
+                --index;
+                return *this;
+            }
+            Iterator operator--(int) {
+                Iterator tmp = *this;
+                --index;
+                return tmp;
+            }
+            Iterator& operator+=(difference_type n) {
+                index += n;
+                return *this;
+            }
+            Iterator& operator-=(difference_type n) {
+                index -= n;
+                return *this;
+            }
+            friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) { return lhs.index - rhs.index; }
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.index == rhs.index; }
+            friend auto operator<=>(const Iterator& lhs, const Iterator& rhs) { return lhs.index <=> rhs.index; }
+        };
+
+         private:
+        static constexpr std::size_t bitwidth = U().bitwidth();
+        static constexpr unsigned rawMask = (1U << bitwidth) - 1U;
+
+        std::span<const uint8_t> packed;
+        std::size_t rowElements = 0;
+        std::size_t rowBytes = 0;
+        std::size_t rows = 0;
+        bool paddedRows = false;
+
+        /**
+         * @brief Decode the raw bits of an element
+         *
+         * @param raw
+         * @return value_type
+         */
+        static constexpr value_type decode(unsigned raw) {
+            if constexpr (std::is_same_v<U, DatatypeBipolar>) {
+                return static_cast<value_type>(raw == 0 ? -1 : 1);
+            } else if constexpr (U().sign()) {
+                // Sign extension like unpack
+                return static_cast<value_type>(((raw & (1U << (bitwidth - 1))) != 0) ? static_cast<int>(raw | ~rawMask) : static_cast<int>(raw));
+            } else {
+                return static_cast<value_type>(raw);
+            }
+        }
+
+        /**
+         * @brief Popcount of the first bits of a byte range. Whole 64 bit words are counted at once.
+         *
+         * @param data
+         * @param bits
+         * @return std::size_t
+         */
+        static std::size_t popcountBits(const uint8_t* data, std::size_t bits) {
+            std::size_t count = 0;
+            std::size_t byte = 0;
+            const std::size_t fullBytes = bits / 8;
+            for (; byte + sizeof(uint64_t) <= fullBytes; byte += sizeof(uint64_t)) {
+                uint64_t word = 0;
+                std::memcpy(&word, data + byte, sizeof(uint64_t));
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+            for (; byte < fullBytes; ++byte) {
+                count += static_cast<std::size_t>(std::popcount(data[byte]));
+            }
+            if (const std::size_t tailBits = bits % 8; tailBits != 0) {
+                // Padding bits are the upper bits of the last byte of a row
+                count += static_cast<std::size_t>(std::popcount(static_cast<uint8_t>(data[fullBytes] & ((1U << tailBits) - 1U))));
+            }
+            return count;
+        }
+
+         public:
+        PackedView() = default;
+
+        /**
+         * @brief Construct a new Packed View object
+         *
+         * @param pPacked Packed data. Has to contain a multiple of the bytes of one row. Empty data gives an empty view.
+         * @param pRowElements Elements per row (last dimension of the folded shape). Every row is padded to a full byte.
+         */
+        PackedView(std::span<const uint8_t> pPacked, std::size_t pRowElements)
+            : packed(pPacked), rowElements(pRowElements), rowBytes(FinnUtils::fastDivCeil(pRowElements * bitwidth, 8UL)), rows((rowBytes == 0) ? 0 : pPacked.size() / rowBytes), paddedRows((pRowElements * bitwidth) % 8 != 0) {
+            if (!pPacked.empty() && (rowBytes == 0 || pPacked.size() % rowBytes != 0)) {
+                FinnUtils::logAndError<std::runtime_error>("Packed data of " + std::to_string(pPacked.size()) + " bytes does not consist of rows with " + std::to_string(pRowElements) + " elements!");
+            }
+        }
+
+        /**
+         * @brief Construct a new Packed View object for data without rows. Only the last byte may contain padding.
+         *
+         * @param pPacked Packed data
+         */
+        explicit PackedView(std::span<const uint8_t> pPacked) : PackedView(pPacked, pPacked.size() * 8 / bitwidth) {}
+
+        /**
+         * @brief Position of the first bit of an element. Padding at the end of rows is skipped.
+         *
+         * @param index
+         * @return std::size_t
+         */
+        std::size_t bitOffset(std::size_t index) const {
+            if (!paddedRows) {
+                return index * bitwidth;
+            }
+            const std::size_t row = index / rowElements;
+            return row * rowBytes * 8 + (index - row * rowElements) * bitwidth;
+        }
+
+        /**
+         * @brief Get the raw bits of an element without decoding
+         *
+         * @param index
+         * @return unsigned
+         */
+        unsigned raw(std::size_t index) const {
+            const std::size_t bit = bitOffset(index);
+            const std::size_t byte = bit / 8;
+            if constexpr (8 % bitwidth == 0) {
+                // Elements never straddle a byte
+                return (static_cast<unsigned>(packed[byte]) >> (bit % 8)) & rawMask;
+            } else {
+                unsigned buffer = packed[byte];
+                if ((bit % 8) + bitwidth > 8) {
+                    buffer |= static_cast<unsigned>(packed[byte + 1]) << 8U;
+                }
+                return (buffer >> (bit % 8)) & rawMask;
+            }
+        }
+
+        /**
+         * @brief Element access. Decodes the element at index.
+         *
+         * @param index
+         * @return value_type
+         */
+        value_type operator[](std::size_t index) const { return decode(raw(index)); }
+
+        /**
+         * @brief Test the bit of a 1-bit element
+         *
+         * @param index
+         * @return true
+         * @return false
+         */
+        bool test(std::size_t index) const
+            requires(bitwidth == 1)
+        {
+            const std::size_t bit = bitOffset(index);
+            return ((packed[bit / 8] >> (bit % 8)) & 1U) != 0;
+        }
+
+        /**
+         * @brief Number of set bits over all elements, padding excluded. For 1-bit datatypes this is the number of set elements.
+         *
+         * @return std::size_t
+         */
+        std::size_t popcount() const {
+            if (!paddedRows) {
+                return popcountBits(packed.data(), packed.size() * 8);
+            }
+            std::size_t count = 0;
+            for (std::size_t row = 0; row < rows; ++row) {
+                count += popcountBits(packed.data() + row * rowBytes, rowElements * bitwidth);
+            }
+            return count;
+        }
+
+        /**
+         * @brief Get a view of a single row
+         *
+         * @param row
+         * @return PackedView
+         */
+        PackedView row(std::size_t row) const { return PackedView(packed.subspan(row * rowBytes, rowBytes), rowElements); }
+
+        /**
+         * @brief Expand all elements into one value per element. Only needed for consumers that require the unpacked layout.
+         *
+         * @return Finn::vector<value_type>
+         */
+        Finn::vector<value_type> expand() const {
+            Finn::vector<value_type> ret(size());
+            for (std::size_t i = 0; i < ret.size(); ++i) {
+                ret[i] = (*this)[i];
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Number of elements
+         *
+         * @return std::size_t
+         */
+        std::size_t size() const { return rows * rowElements; }
+
+        /**
+         * @brief Number of rows
+         *
+         * @return std::size_t
+         */
+        std::size_t rowCount() const { return rows; }
+
+        /**
+         * @brief Number of elements per row
+         *
+         * @return std::size_t
+         */
+        std::size_t elementsPerRow() const { return rowElements; }
+
+        /**
+         * @brief Tests if the view contains no elements
+         *
+         * @return true
+         * @return false
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief The underlying packed bytes, including row padding. Can be hashed or combined with masks directly.
+         *
+         * @return std::span<const uint8_t>
+         */
+        std::span<const uint8_t> bytes() const { return packed; }
+
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, static_cast<std::ptrdiff_t>(size())); }
+    };
+
+    /**
+     * @brief Owning compact result of a sub-byte FINN datatype. Holds the packed bytes and offers the interface of PackedView.
+     *
+     * @tparam U FINN datatype of the elements
+     */
+    template<IsCompactDatatype U>
+    class PackedVector {
+         private:
+        Finn::vector<uint8_t> storage;
+        PackedView<U> packedView;
+
+         public:
+        PackedVector() = default;
+
+        /**
+         * @brief Construct a new Packed Vector object. Takes ownership of the packed data.
+         *
+         * @param pStorage Packed data
+         * @param rowElements Elements per row (last dimension of the folded shape)
+         */
+        PackedVector(Finn::vector<uint8_t>&& pStorage, std::size_t rowElements) : storage(std::move(pStorage)), packedView(std::span<const uint8_t>(storage.data(), storage.size()), rowElements) {}
+
+        PackedVector(PackedVector&& other) noexcept : storage(std::move(other.storage)), packedView(std::span<const uint8_t>(storage.data(), storage.size()), other.packedView.elementsPerRow()) {
+            // The moved-from vector must not keep viewing the storage it gave away
+            other.packedView = PackedView<U>();
+        }
+        PackedVector(const PackedVector& other) : storage(other.storage), packedView(std::span<const uint8_t>(storage.data(), storage.size()), other.packedView.elementsPerRow()) {}
+        ~PackedVector() = default;
+        PackedVector& operator=(PackedVector&& other) noexcept {
+            if (this != &other) {
+                storage = std::move(other.storage);
+                packedView = PackedView<U>(std::span<const uint8_t>(storage.data(), storage.size()), other.packedView.elementsPerRow());
+                other.storage.clear();
+                other.packedView = PackedView<U>();
+            }
+            return *this;
+        }
+        PackedVector& operator=(const PackedVector& other) {
+            if (this != &other) {
+                storage = other.storage;
+                packedView = PackedView<U>(std::span<const uint8_t>(storage.data(), storage.size()), other.packedView.elementsPerRow());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Get a view of the data
+         *
+         * @return const PackedView<U>&
+         */
+        const PackedView<U>& view() const { return packedView; }
+
+        typename PackedView<U>::value_type operator[](std::size_t index) const { return packedView[index]; }
+        std::size_t popcount() const { return packedView.popcount(); }
+        std::size_t size() const { return packedView.size(); }
+        bool empty() const { return packedView.empty(); }
+        std::span<const uint8_t> bytes() const { return packedView.bytes(); }
+        Finn::vector<typename PackedView<U>::value_type> expand() const { return packedView.expand(); }
+        auto begin() const { return packedView.begin(); }
+        auto end() const { return packedView.end(); }
+    };
+
+    /**
+     * @brief Compact result of 1-bit datatypes (DatatypeBinary, DatatypeBipolar)
+     *
+     * @tparam U
+     */
+    template<IsCompactDatatype U>
+        requires(U().bitwidth() == 1)
+    using BitView = PackedView<U>;
+
+    /**
+     * @brief Compact result of 4-bit datatypes
+     *
+     * @tparam U
+     */
+    template<IsCompactDatatype U>
+        requires(U().bitwidth() == 4)
+    using NibbleView = PackedView<U>;
+}  // namespace Finn
+
+#endif  // PACKEDVIEW
@@ -0,0 +1,344 @@
+/**
+ * @file SamplingVerifier.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Bit exact verification of a sample of the inferences against a golden reference on a background thread
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef SAMPLINGVERIFIER
+#define SAMPLINGVERIFIER
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <FINNCppDriver/utils/AlignedAllocator.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Finn {
+    /**
+     * @brief Configuration of the sampling verifier
+     *
+     */
+    struct VerifierOptions {
+        /**
+         * @brief Verify one in sampleEvery batches. 1 verifies every batch.
+         *
+         */
+        std::size_t sampleEvery = 1000;
+        /**
+         * @brief Fraction of one core the verification thread may use on average (0 < cpuBudget <= 1)
+         *
+         */
+        double cpuBudget = 0.05;
+        /**
+         * @brief Number of captured batches that can wait for verification. Further samples are dropped until the verifier caught up.
+         *
+         */
+        std::size_t queueDepth = 4;
+        /**
+         * @brief Run the verification thread with the lowest scheduling priority
+         *
+         */
+        bool lowPriority = true;
+    };
+
+    /**
+     * @brief Counters of the sampling verifier
+     *
+     */
+    struct VerifierStatistics {
+        /**
+         * @brief Batches seen by the verifier
+         *
+         */
+        std::size_t batches = 0;
+        /**
+         * @brief Batches selected for verification
+         *
+         */
+        std::size_t sampled = 0;
+        /**
+         * @brief Sampled batches that were dropped, because the queue was full
+         *
+         */
+        std::size_t dropped = 0;
+        /**
+         * @brief Sampled batches that were compared with the reference
+         *
+         */
+        std::size_t verified = 0;
+        /**
+         * @brief Verified batches that differed from the reference
+         *
+         */
+        std::size_t mismatches = 0;
+    };
+
+    /**
+     * @brief Verifies a sample of the inferences bit exact against a golden reference.
+     *
+     * The hot path only increments a counter. For one in sampleEvery batches the packed input and output are copied into a preallocated slot
+     * and compared on a background thread against the output of a reference: the known-answer identity net, a user supplied functor or
+     * a software model of the network. The background thread runs with low priority and sleeps after every verification, so that it stays
+     * within its CPU budget. Mismatches are logged and counted in the statistics.
+     *
+     */
+    class SamplingVerifier {
+         public:
+        /**
+         * @brief Reference implementation. Computes the expected packed output from the packed input.
+         *
+         */
+        using ReferenceModel = std::function<Finn::vector<uint8_t>(std::span<const uint8_t>)>;
+
+         private:
+        /**
+         * @brief Captured input and output of one batch
+         *
+         */
+        struct Sample {
+            Finn::vector<uint8_t> input;
+            Finn::vector<uint8_t> output;
+            std::size_t batch = 0;
+        };
+
+        ReferenceModel reference;
+        VerifierOptions options;
+        logger_type& logger = Logger::getLogger();
+
+        std::atomic<std::size_t> batchCounter{0};
+        std::atomic<std::size_t> sampledCounter{0};
+        std::atomic<std::size_t> droppedCounter{0};
+        std::atomic<std::size_t> verifiedCounter{0};
+        std::atomic<std::size_t> mismatchCounter{0};
+
+        std::mutex queueMutex;
+        std::condition_variable_any queueCondition;
+        std::vector<Sample> freeSlots;
+        std::vector<Sample> pendingSamples;
+        std::jthread worker;
+
+        /**
+         * @brief A small prefix to determine the source of the log write
+         *
+         * @return std::string
+         */
+        static std::string loggerPrefix() { return "[SamplingVerifier] "; }
+
+        void verify(const Sample& sample) {
+            const Finn::vector<uint8_t> expected = reference(std::span<const uint8_t>(sample.input.data(), sample.input.size()));
+            verifiedCounter.fetch_add(1, std::memory_order_relaxed);
+            if (expected.size() == sample.output.size() && std::equal(expected.begin(), expected.end(), sample.output.begin())) {
+                return;
+            }
+            mismatchCounter.fetch_add(1, std::memory_order_relaxed);
+            if (expected.size() != sample.output.size()) {
+                FINN_LOG(logger, loglevel::error) << loggerPrefix() << "Mismatch in batch " << sample.batch << ": Output has " << sample.output.size() << " bytes, reference has " << expected.size() << " bytes";
+            } else {
+                const auto [outIt, refIt] = std::mismatch(sample.output.begin(), sample.output.end(), expected.begin());
+                const auto differing = std::inner_product(sample.output.begin(), sample.output.end(), expected.begin(), std::size_t{0}, std::plus<>(), [](uint8_t lhs, uint8_t rhs) { return std::size_t{lhs != rhs}; });
+                FINN_LOG(logger, loglevel::error) << loggerPrefix() << "Mismatch in batch " << sample.batch << ": " << differing << " of " << expected.size() << " bytes differ, first at byte "
+                                                  << std::distance(sample.output.begin(), outIt) << " (output " << static_cast<int>(*outIt) << ", reference " << static_cast<int>(*refIt) << ")";
+            }
+        }
+
+        void run(std::stop_token stoken) {
+            if (options.lowPriority) {
+                // On Linux the nice value is a per thread attribute
+                if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19) != 0) {
+                    FINN_LOG(logger, loglevel::warning) << loggerPrefix() << "Could not lower the priority of the verification thread";
+                }
+            }
+            while (!stoken.stop_requested()) {
+                Sample sample;
+                {
+                    std::unique_lock lock(queueMutex);
+                    if (!queueCondition.wait(lock, stoken, [this]() { return !pendingSamples.empty(); })) {
+                        return;
+                    }
+                    sample = std::move(pendingSamples.front());
+                    pendingSamples.erase(pendingSamples.begin());
+                }
+                const auto start = std::chrono::steady_clock::now();
+                verify(sample);
+                const auto busy = std::chrono::steady_clock::now() - start;
+                {
+                    const std::lock_guard lock(queueMutex);
+                    freeSlots.emplace_back(std::move(sample));
+                }
+                // Idle long enough to keep the average utilisation of the thread within the budget
+                const auto idle = std::chrono::duration_cast<std::chrono::nanoseconds>(busy * ((1.0 - options.cpuBudget) / options.cpuBudget));
+                std::mutex sleepMutex;
+                std::unique_lock sleepLock(sleepMutex);
+                std::condition_variable_any().wait_for(sleepLock, stoken, idle, []() { return false; });
+            }
+        }
+
+         public:
+        /**
+         * @brief Construct a new Sampling Verifier object and start the verification thread
+         *
+         * @param pReference Reference that computes the expected packed output of a packed input
+         * @param pOptions
+         */
+        explicit SamplingVerifier(ReferenceModel pReference, const VerifierOptions& pOptions = {}) : reference(std::move(pReference)), options(pOptions) {
+            if (!reference) {
+                FinnUtils::logAndError<std::invalid_argument>("The sampling verifier needs a reference!");
+            }
+            if (options.sampleEvery == 0 || options.queueDepth == 0 || !(options.cpuBudget > 0.0 && options.cpuBudget <= 1.0)) {
+                FinnUtils::logAndError<std::invalid_argument>("Invalid sampling verifier options: Sampling rate and queue depth have to be positive and the CPU budget has to be in (0, 1]!");
+            }
+            freeSlots.resize(options.queueDepth);
+            pendingSamples.reserve(options.queueDepth);
+            worker = std::jthread([this](std::stop_token stoken) { run(stoken); });
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Verifying 1 in " << options.sampleEvery << " batches with a CPU budget of " << options.cpuBudget * 100 << "%";
+        }
+
+        SamplingVerifier(SamplingVerifier&& other) = delete;
+        SamplingVerifier(const SamplingVerifier& other) = delete;
+        SamplingVerifier& operator=(SamplingVerifier&& other) = delete;
+        SamplingVerifier& operator=(const SamplingVerifier& other) = delete;
+
+        /**
+         * @brief Destroy the Sampling Verifier object. Pending samples are discarded.
+         *
+         */
+        ~SamplingVerifier() {
+            worker.request_stop();
+            if (worker.joinable()) {
+                worker.join();
+            }
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << toString(getStatistics());
+        }
+
+        /**
+         * @brief Count a batch and decide if it is sampled. This is the only work done on the hot path for batches that are not sampled.
+         *
+         * @return true The batch should be passed to capture()
+         * @return false
+         */
+        bool sample() { return batchCounter.fetch_add(1, std::memory_order_relaxed) % options.sampleEvery == 0; }
+
+        /**
+         * @brief Capture the packed input and output of a sampled batch. The data is copied, the caller can reuse its buffers immediately.
+         *
+         * @param input Packed input
+         * @param output Packed output
+         * @return true Sample was queued for verification
+         * @return false Sample was dropped, because the verifier has not caught up yet
+         */
+        bool capture(std::span<const uint8_t> input, std::span<const uint8_t> output) {
+            const std::size_t batch = sampledCounter.fetch_add(1, std::memory_order_relaxed);
+            Sample slot;
+            {
+                const std::lock_guard lock(queueMutex);
+                if (freeSlots.empty()) {
+                    droppedCounter.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                slot = std::move(freeSlots.back());
+                freeSlots.pop_back();
+            }
+            // Slots keep their capacity, so only the first captures allocate
+            slot.input.assign(input.begin(), input.end());
+            slot.output.assign(output.begin(), output.end());
+            slot.batch = batch;
+            {
+                const std::lock_guard lock(queueMutex);
+                pendingSamples.emplace_back(std::move(slot));
+            }
+            queueCondition.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Get a snapshot of the counters
+         *
+         * @return VerifierStatistics
+         */
+        VerifierStatistics getStatistics() const {
+            return {batchCounter.load(std::memory_order_relaxed), sampledCounter.load(std::memory_order_relaxed), droppedCounter.load(std::memory_order_relaxed), verifiedCounter.load(std::memory_order_relaxed),
+                    mismatchCounter.load(std::memory_order_relaxed)};
+        }
+
+        /**
+         * @brief Get the options of the verifier
+         *
+         * @return const VerifierOptions&
+         */
+        const VerifierOptions& getOptions() const { return options; }
+
+        /**
+         * @brief Reference of a known-answer identity net, whose packed output equals its packed input
+         *
+         * @return ReferenceModel
+         */
+        static ReferenceModel identityReference() {
+            return [](std::span<const uint8_t> input) { return Finn::vector<uint8_t>(input.begin(), input.end()); };
+        }
+
+        /**
+         * @brief Reference from a software model of the network. The packed input is unpacked row by row, passed to the model and its result is packed again.
+         *
+         * @tparam F FINN datatype of the input
+         * @tparam S FINN datatype of the output
+         * @tparam Model Callable taking a Finn::vector of unpacked inputs and returning a Finn::vector of unpacked outputs
+         * @param model Software model of the network
+         * @param inputRowElements Elements of the innermost dimension of the folded input shape
+         * @param outputRowElements Elements of the innermost dimension of the folded output shape
+         * @return ReferenceModel
+         */
+        template<IsDatatype F, IsDatatype S, typename Model>
+        static ReferenceModel softwareModel(Model model, std::size_t inputRowElements, std::size_t outputRowElements) {
+            return [model = std::move(model), inputRowElements, outputRowElements](std::span<const uint8_t> input) {
+                const std::size_t inputRowBytes = FinnUtils::fastDivCeil(inputRowElements * F().bitwidth(), std::size_t{8});
+                Finn::vector<uint8_t> packedInput(input.begin(), input.end());
+                const std::size_t rows = packedInput.size() / inputRowBytes;
+                const Finn::DynamicMdSpan reshapedInput(packedInput.begin(), packedInput.end(), {rows, inputRowBytes});
+                auto unpacked = Finn::unpackMultiDimensionalOutputs<F>(packedInput.begin(), packedInput.end(), reshapedInput, {rows, inputRowElements});
+
+                auto result = model(unpacked);
+                const Finn::DynamicMdSpan reshapedOutput(result.begin(), result.end(), {result.size() / outputRowElements, outputRowElements});
+                return Finn::packMultiDimensionalInputs<S>(result.begin(), result.end(), reshapedOutput, outputRowElements);
+            };
+        }
+
+        /**
+         * @brief Format the statistics for logging
+         *
+         * @param stats
+         * @return std::string
+         */
+        static std::string toString(const VerifierStatistics& stats) {
+            std::stringstream sstream;
+            sstream << "batches " << stats.batches << ", sampled " << stats.sampled << ", dropped " << stats.dropped << ", verified " << stats.verified << ", mismatches " << stats.mismatches;
+            return sstream.str();
+        }
+    };
+}  // namespace Finn
+
+#endif  // SAMPLINGVERIFIER
@@ -0,0 +1,408 @@
+/**
+ * @file SoakMonitor.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Periodic sampling of throughput, latency and memory usage for long running soak tests
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef SOAKMONITOR
+#define SOAKMONITOR
+
+#include <FINNCppDriver/utils/AllocationCounter.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Finn {
+    /**
+     * @brief Limits a soak test has to stay within
+     *
+     */
+    struct SoakThresholds {
+        /**
+         * @brief Maximum relative deviation of the throughput of a sample from the baseline sample (0.1 = 10%)
+         *
+         */
+        double maxThroughputDrift = 0.1;
+        /**
+         * @brief Maximum growth of the resident set size compared to the baseline sample in bytes
+         *
+         */
+        std::size_t maxRssGrowth = 64UL * 1024 * 1024;
+        /**
+         * @brief Maximum growth of the allocated heap memory compared to the baseline sample in bytes
+         *
+         */
+        std::size_t maxHeapGrowth = 64UL * 1024 * 1024;
+        /**
+         * @brief Number of samples that are not checked, because caches, buffers and the allocator are still warming up. The first checked sample is the baseline
+         *
+         */
+        std::size_t warmupSamples = 1;
+    };
+
+    /**
+     * @brief Measurements of one sampling interval
+     *
+     */
+    struct SoakSample {
+        /**
+         * @brief Time since the start of the soak test
+         *
+         */
+        std::chrono::duration<double> elapsed{};
+        /**
+         * @brief Inferences finished in this interval
+         *
+         */
+        std::size_t inferences = 0;
+        /**
+         * @brief Inferences per second in this interval
+         *
+         */
+        double throughput = 0;
+        /**
+         * @brief Median latency of a step in this interval in microseconds
+         *
+         */
+        double p50 = 0;
+        /**
+         * @brief 99th percentile latency of a step in this interval in microseconds
+         *
+         */
+        double p99 = 0;
+        /**
+         * @brief 99.9th percentile latency of a step in this interval in microseconds
+         *
+         */
+        double p999 = 0;
+        /**
+         * @brief Maximum latency of a step in this interval in microseconds
+         *
+         */
+        double max = 0;
+        /**
+         * @brief Resident set size at the end of the interval in bytes
+         *
+         */
+        std::size_t rss = 0;
+        /**
+         * @brief Heap memory handed out by malloc at the end of the interval in bytes
+         *
+         */
+        std::size_t heap = 0;
+        /**
+         * @brief Counted allocations of all threads in this interval (see AllocationCounter)
+         *
+         */
+        FinnUtils::AllocationStatistics allocations;
+    };
+
+    /**
+     * @brief Collects latencies of a soak test, takes periodic samples and checks them against the thresholds.
+     * A step is one unit of work of the soak test (e.g. one synchronous inference of a batch). record() may be called from multiple threads.
+     * Latencies are counted in a fixed size histogram, so the memory of the monitor does not grow with the number of steps and does not disturb the
+     * memory growth the soak test is looking for.
+     *
+     */
+    class SoakMonitor {
+         public:
+        /**
+         * @brief Every power of two of the latency in nanoseconds is split into 2^latencySubBucketBits buckets. Reported percentiles are the upper bound
+         * of their bucket and at most 1/16 too high.
+         *
+         */
+        static constexpr std::size_t latencySubBucketBits = 4;
+        /**
+         * @brief Number of buckets per power of two
+         *
+         */
+        static constexpr std::size_t latencySubBuckets = std::size_t{1} << latencySubBucketBits;
+        /**
+         * @brief Number of buckets needed to cover all latencies that fit into 64 bit
+         *
+         */
+        static constexpr std::size_t latencyBuckets = (64 - latencySubBucketBits + 1) * latencySubBuckets;
+        /**
+         * @brief Number of steps per latency bucket
+         *
+         */
+        using LatencyHistogram = std::array<uint64_t, latencyBuckets>;
+
+        /**
+         * @brief Bucket of a latency. Latencies below latencySubBuckets nanoseconds get a bucket of their own.
+         *
+         * @param ns
+         * @return std::size_t
+         */
+        static constexpr std::size_t latencyBucket(uint64_t ns) noexcept {
+            if (ns < latencySubBuckets) {
+                return ns;
+            }
+            const auto shift = static_cast<std::size_t>(std::numeric_limits<uint64_t>::digits - 1 - std::countl_zero(ns)) - latencySubBucketBits;
+            return (shift + 1) * latencySubBuckets + ((ns >> shift) & (latencySubBuckets - 1));
+        }
+
+        /**
+         * @brief Largest latency that falls into a bucket
+         *
+         * @param bucket
+         * @return uint64_t
+         */
+        static constexpr uint64_t latencyBucketUpperBound(std::size_t bucket) noexcept {
+            if (bucket < latencySubBuckets) {
+                return bucket;
+            }
+            const std::size_t shift = bucket / latencySubBuckets - 1;
+            const uint64_t lower = uint64_t{latencySubBuckets + bucket % latencySubBuckets} << shift;
+            return lower + ((uint64_t{1} << shift) - 1);
+        }
+
+         private:
+        SoakThresholds thresholds;
+        std::mutex latencyMutex;
+        LatencyHistogram latencies{};
+        uint64_t latencyCount = 0;
+        std::chrono::nanoseconds maxLatency{0};
+        std::size_t inferencesInInterval = 0;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point lastSample;
+        std::vector<SoakSample> samples;
+        FinnUtils::AllocationStatistics lastAllocations;
+        logger_type& logger;
+
+        static std::string loggerPrefix() { return "[SoakMonitor] "; }
+
+        static double percentile(const LatencyHistogram& histogram, uint64_t count, double fraction) {
+            if (count == 0) {
+                return 0;
+            }
+            const auto rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count))), 1);
+            uint64_t seen = 0;
+            for (std::size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+                seen += histogram[bucket];
+                if (seen >= rank) {
+                    return static_cast<double>(latencyBucketUpperBound(bucket)) / 1000.0;
+                }
+            }
+            return static_cast<double>(latencyBucketUpperBound(histogram.size() - 1)) / 1000.0;
+        }
+
+         public:
+        /**
+         * @brief Construct a new Soak Monitor object
+         *
+         * @param pThresholds
+         */
+        explicit SoakMonitor(const SoakThresholds& pThresholds) : thresholds(pThresholds), start(std::chrono::steady_clock::now()), lastSample(start), logger(Logger::getLogger()) {}
+
+        /**
+         * @brief Record the latency of one step
+         *
+         * @param latency
+         * @param inferences Number of inferences finished by the step
+         */
+        void record(std::chrono::nanoseconds latency, std::size_t inferences = 1) {
+            const auto ns = static_cast<uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{0}));
+            std::lock_guard guard(latencyMutex);
+            ++latencies[latencyBucket(ns)];
+            ++latencyCount;
+            maxLatency = std::max(maxLatency, latency);
+            inferencesInInterval += inferences;
+        }
+
+        /**
+         * @brief Close the current interval and return its measurements. The sample is also stored in the sample history.
+         *
+         * @return SoakSample
+         */
+        SoakSample sample() {
+            LatencyHistogram interval{};
+            uint64_t count = 0;
+            std::chrono::nanoseconds intervalMax{0};
+            SoakSample ret;
+            {
+                std::lock_guard guard(latencyMutex);
+                interval.swap(latencies);
+                count = std::exchange(latencyCount, 0);
+                intervalMax = std::exchange(maxLatency, std::chrono::nanoseconds{0});
+                ret.inferences = inferencesInInterval;
+                inferencesInInterval = 0;
+            }
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> intervalLength = now - lastSample;
+            lastSample = now;
+
+            ret.elapsed = now - start;
+            ret.throughput = (intervalLength.count() > 0) ? static_cast<double>(ret.inferences) / intervalLength.count() : 0;
+            ret.p50 = percentile(interval, count, 0.5);
+            ret.p99 = percentile(interval, count, 0.99);
+            ret.p999 = percentile(interval, count, 0.999);
+            ret.max = static_cast<double>(intervalMax.count()) / 1000.0;
+            ret.rss = residentSetSize();
+            ret.heap = heapInUse();
+            const auto allocations = FinnUtils::AllocationCounter::total(FinnUtils::AllocationCounter::globalStatistics());
+            ret.allocations = allocations - lastAllocations;
+            lastAllocations = allocations;
+            samples.emplace_back(ret);
+            return ret;
+        }
+
+        /**
+         * @brief Check a sample against the baseline sample. Samples taken during the warmup are always accepted.
+         *
+         * @param toCheck
+         * @param reason Is set to a description of the violated threshold if the check fails
+         * @return true Sample is within the thresholds
+         * @return false Sample violates a threshold
+         */
+        bool check(const SoakSample& toCheck, std::string& reason) const {
+            if (samples.size() <= thresholds.warmupSamples) {
+                return true;
+            }
+            const SoakSample& baseline = samples[thresholds.warmupSamples];
+            if (baseline.throughput > 0) {
+                const double drift = std::abs(toCheck.throughput - baseline.throughput) / baseline.throughput;
+                if (drift > thresholds.maxThroughputDrift) {
+                    reason = "Throughput drifted by " + std::to_string(drift * 100) + "% (baseline " + std::to_string(baseline.throughput) + " inferences/s, now " + std::to_string(toCheck.throughput) + " inferences/s)";
+                    return false;
+                }
+            }
+            if (toCheck.rss > baseline.rss && toCheck.rss - baseline.rss > thresholds.maxRssGrowth) {
+                reason = "Resident set size grew by " + std::to_string(toCheck.rss - baseline.rss) + " bytes (baseline " + std::to_string(baseline.rss) + " bytes)";
+                return false;
+            }
+            if (toCheck.heap > baseline.heap && toCheck.heap - baseline.heap > thresholds.maxHeapGrowth) {
+                reason = "Heap usage grew by " + std::to_string(toCheck.heap - baseline.heap) + " bytes (baseline " + std::to_string(baseline.heap) + " bytes)";
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Run a soak test. step is executed repeatedly until the duration is over; every interval a sample is taken, logged and checked.
+         * Enables the AllocationCounter for the duration of the soak test.
+         *
+         * @param step Unit of work. Returns the number of inferences it finished
+         * @param duration Duration of the soak test
+         * @param interval Sampling interval
+         * @param reason Is set to a description of the violated threshold if the soak test fails
+         * @return true All samples were within the thresholds
+         * @return false A sample violated a threshold. The soak test is stopped at the first violation
+         */
+        bool run(const std::function<std::size_t()>& step, std::chrono::seconds duration, std::chrono::seconds interval, std::string& reason) {
+            start = std::chrono::steady_clock::now();
+            lastSample = start;
+            samples.clear();
+            {
+                std::lock_guard guard(latencyMutex);
+                latencies.fill(0);
+                latencyCount = 0;
+                maxLatency = std::chrono::nanoseconds{0};
+                inferencesInInterval = 0;
+            }
+            const bool countingWasEnabled = FinnUtils::AllocationCounter::isEnabled();
+            FinnUtils::AllocationCounter::enable();
+            lastAllocations = FinnUtils::AllocationCounter::total(FinnUtils::AllocationCounter::globalStatistics());
+            const auto end = start + duration;
+            auto nextSample = start + interval;
+            bool passed = true;
+            while (passed) {
+                const auto stepStart = std::chrono::steady_clock::now();
+                const std::size_t inferences = step();
+                const auto stepEnd = std::chrono::steady_clock::now();
+                record(stepEnd - stepStart, inferences);
+
+                if (stepEnd >= nextSample || stepEnd >= end) {
+                    nextSample += interval;
+                    auto current = sample();
+                    FINN_LOG(logger, loglevel::info) << loggerPrefix() << toString(current);
+                    if (!check(current, reason)) {
+                        FINN_LOG(logger, loglevel::error) << loggerPrefix() << "Soak test failed: " << reason;
+                        passed = false;
+                    }
+                }
+                if (stepEnd >= end) {
+                    break;
+                }
+            }
+            if (!countingWasEnabled) {
+                FinnUtils::AllocationCounter::disable();
+            }
+            return passed;
+        }
+
+        /**
+         * @brief Get all samples taken so far
+         *
+         * @return const std::vector<SoakSample>&
+         */
+        const std::vector<SoakSample>& getSamples() const { return samples; }
+
+        /**
+         * @brief Format a sample for logging
+         *
+         * @param toFormat
+         * @return std::string
+         */
+        static std::string toString(const SoakSample& toFormat) {
+            std::stringstream stream;
+            stream << "t=" << toFormat.elapsed.count() << "s throughput=" << toFormat.throughput << "/s p50=" << toFormat.p50 << "us p99=" << toFormat.p99 << "us p99.9=" << toFormat.p999 << "us max=" << toFormat.max
+                   << "us rss=" << toFormat.rss << "B heap=" << toFormat.heap << "B allocs=" << toFormat.allocations.allocations << " alloc_bytes=" << toFormat.allocations.bytes;
+            return stream.str();
+        }
+
+        /**
+         * @brief Returns the resident set size of the process in bytes
+         *
+         * @return std::size_t
+         */
+        static std::size_t residentSetSize() {
+            std::ifstream statm("/proc/self/statm");
+            std::size_t totalPages = 0;
+            std::size_t residentPages = 0;
+            if (!(statm >> totalPages >> residentPages)) {
+                return 0;
+            }
+            return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        }
+
+        /**
+         * @brief Returns the number of bytes currently allocated through malloc
+         *
+         * @return std::size_t
+         */
+        static std::size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+            const auto info = mallinfo2();
+            return info.uordblks + info.hblkhd;
+#else
+            return 0;
+#endif
+        }
+    };
+}  // namespace Finn
+
+#endif  // SOAKMONITOR
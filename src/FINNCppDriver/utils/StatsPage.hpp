@@ -0,0 +1,370 @@
+/**
+ * @file StatsPage.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Publishes the live statistics of a driver process in a seqlock protected shared memory page, so that monitors like finn-top can read them
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef STATSPAGE
+#define STATSPAGE
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Finn {
+    /**
+     * @brief Content of a stats page
+     *
+     */
+    struct StatsPageData {
+        /**
+         * @brief Identifies a stats page
+         *
+         */
+        static constexpr uint64_t pageMagic = 0x5354415453464e4eULL;  // "FNNSTATS"
+        /**
+         * @brief Layout version, increased whenever the layout changes
+         *
+         */
+        static constexpr uint32_t pageVersion = 3;
+
+        /**
+         * @brief Magic number
+         *
+         */
+        uint64_t magic = pageMagic;
+        /**
+         * @brief Layout version
+         *
+         */
+        uint32_t version = pageVersion;
+        /**
+         * @brief Process id of the driver
+         *
+         */
+        int32_t pid = 0;
+        /**
+         * @brief Name of the driver, null terminated
+         *
+         */
+        char name[64] = {};
+        /**
+         * @brief Time of the last publish in ns of CLOCK_MONOTONIC
+         *
+         */
+        uint64_t publishTimeNs = 0;
+        /**
+         * @brief Counters of the driver
+         *
+         */
+        FinnUtils::LiveStats::Snapshot stats;
+    };
+
+    /**
+     * @brief Memory layout of a stats page. The sequence number is odd while the single writer updates the data.
+     *
+     */
+    struct StatsPage {
+        /**
+         * @brief Seqlock sequence number
+         *
+         */
+        std::atomic<uint64_t> sequence{0};
+        /**
+         * @brief Data protected by the sequence number
+         *
+         */
+        StatsPageData data;
+    };
+
+    static_assert(std::is_trivially_copyable_v<StatsPageData>, "Stats page data is copied between processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlock in shared memory requires lock free atomics");
+
+    /**
+     * @brief Common helpers for stats pages
+     *
+     */
+    namespace StatsPages {
+        /**
+         * @brief Prefix of the shared memory object names of stats pages
+         *
+         */
+        inline constexpr const char* namePrefix = "finn-stats.";
+
+        /**
+         * @brief Shared memory object name of the stats page of a process
+         *
+         * @param pid
+         * @return std::string
+         */
+        inline std::string pageName(pid_t pid) { return "/" + std::string(namePrefix) + std::to_string(pid); }
+
+        /**
+         * @brief Current time of CLOCK_MONOTONIC in ns. Comparable across processes.
+         *
+         * @return uint64_t
+         */
+        inline uint64_t monotonicNs() {
+            timespec time{};
+            clock_gettime(CLOCK_MONOTONIC, &time);
+            return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(time.tv_nsec);
+        }
+
+        /**
+         * @brief Check if the process that owns a stats page is still running
+         *
+         * @param pid
+         * @return true
+         * @return false
+         */
+        inline bool isAlive(pid_t pid) { return kill(pid, 0) == 0 || errno == EPERM; }
+
+        /**
+         * @brief List the names of all stats pages currently present in /dev/shm. Pages left behind by processes that were killed are removed.
+         *
+         * @return std::vector<std::string>
+         */
+        inline std::vector<std::string> list() {
+            std::vector<std::string> ret;
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator("/dev/shm", error)) {
+                const auto filename = entry.path().filename().string();
+                if (!filename.starts_with(namePrefix)) {
+                    continue;
+                }
+                const std::string_view pidString = std::string_view(filename).substr(std::string_view(namePrefix).size());
+                pid_t pid = 0;
+                const auto [end, parseError] = std::from_chars(pidString.data(), pidString.data() + pidString.size(), pid);
+                if (parseError == std::errc() && end == pidString.data() + pidString.size() && pid > 0 && !isAlive(pid)) {
+                    shm_unlink(("/" + filename).c_str());
+                    continue;
+                }
+                ret.emplace_back("/" + filename);
+            }
+            std::sort(ret.begin(), ret.end());
+            return ret;
+        }
+    }  // namespace StatsPages
+
+    /**
+     * @brief Publishes the LiveStats of this process into the stats page /dev/shm/finn-stats.<pid>. Enables the recording of LiveStats.
+     *
+     * The hot path only updates process local atomics. A background thread is the single writer of the page and copies a snapshot of the counters
+     * into it once per interval, so readers never stall the driver.
+     *
+     */
+    class StatsPublisher {
+         private:
+        std::string pageName;
+        StatsPage* page = nullptr;
+        std::chrono::milliseconds interval;
+        std::mutex publishMutex;
+        std::mutex waitMutex;
+        std::condition_variable_any waitCondition;
+        logger_type& logger = Logger::getLogger();
+        std::jthread worker;
+
+        static std::string loggerPrefix() { return "[StatsPublisher] "; }
+
+        void run(std::stop_token stoken) {
+            std::unique_lock lock(waitMutex);
+            while (!waitCondition.wait_for(lock, stoken, interval, [&stoken]() { return stoken.stop_requested(); })) {
+                publish();
+            }
+        }
+
+         public:
+        /**
+         * @brief Create the stats page of this process and start publishing
+         *
+         * @param name Name of the driver shown by monitors
+         * @param pInterval Time between two publishes
+         */
+        explicit StatsPublisher(const std::string& name, std::chrono::milliseconds pInterval = std::chrono::milliseconds(500)) : pageName(StatsPages::pageName(getpid())), interval(pInterval) {
+            if (interval.count() <= 0) {
+                FinnUtils::logAndError<std::invalid_argument>("Publish interval of the stats page has to be positive!");
+            }
+            const int fd = shm_open(pageName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+            if (fd < 0) {
+                FinnUtils::logAndError<std::runtime_error>("Could not create stats page " + pageName + ": " + std::strerror(errno));
+            }
+            if (ftruncate(fd, sizeof(StatsPage)) != 0) {
+                close(fd);
+                shm_unlink(pageName.c_str());
+                FinnUtils::logAndError<std::runtime_error>("Could not resize stats page " + pageName + ": " + std::strerror(errno));
+            }
+            void* memory = mmap(nullptr, sizeof(StatsPage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED) {
+                shm_unlink(pageName.c_str());
+                FinnUtils::logAndError<std::runtime_error>("Could not map stats page " + pageName + ": " + std::strerror(errno));
+            }
+            page = new (memory) StatsPage();
+            page->data.pid = getpid();
+            name.copy(page->data.name, sizeof(page->data.name) - 1);
+
+            FinnUtils::LiveStats::enable();
+            publish();
+            FINN_LOG(logger, loglevel::info) << loggerPrefix() << "Publishing live statistics to /dev/shm" << pageName;
+            worker = std::jthread([this](std::stop_token stoken) { run(stoken); });
+        }
+
+        StatsPublisher(StatsPublisher&& other) = delete;
+        StatsPublisher(const StatsPublisher& other) = delete;
+        StatsPublisher& operator=(StatsPublisher&& other) = delete;
+        StatsPublisher& operator=(const StatsPublisher& other) = delete;
+
+        /**
+         * @brief Stop publishing, disable LiveStats and remove the stats page
+         *
+         */
+        ~StatsPublisher() {
+            worker.request_stop();
+            if (worker.joinable()) {
+                worker.join();
+            }
+            FinnUtils::LiveStats::disable();
+            shm_unlink(pageName.c_str());
+            munmap(page, sizeof(StatsPage));
+        }
+
+        /**
+         * @brief Copy the current counters into the page right away. Serialized with the publisher thread, so the page always has a single writer.
+         *
+         */
+        void publish() {
+            const std::lock_guard lock(publishMutex);
+            const auto snapshot = FinnUtils::LiveStats::snapshot();
+            const uint64_t sequence = page->sequence.load(std::memory_order_relaxed);
+            page->sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            page->data.publishTimeNs = StatsPages::monotonicNs();
+            page->data.stats = snapshot;
+            page->sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Shared memory object name of the page
+         *
+         * @return const std::string&
+         */
+        const std::string& getPageName() const { return pageName; }
+    };
+
+    /**
+     * @brief Read only view of the stats page of a driver process
+     *
+     */
+    class StatsPageReader {
+         private:
+        std::string pageName;
+        const StatsPage* page = nullptr;
+
+         public:
+        /**
+         * @brief Map the stats page
+         *
+         * @param pPageName Shared memory object name, e.g. /finn-stats.1234
+         */
+        explicit StatsPageReader(std::string pPageName) : pageName(std::move(pPageName)) {
+            const int fd = shm_open(pageName.c_str(), O_RDONLY, 0);
+            if (fd < 0) {
+                FinnUtils::logAndError<std::runtime_error>("Could not open stats page " + pageName + ": " + std::strerror(errno));
+            }
+            struct stat status {};
+            if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(StatsPage)) {
+                close(fd);
+                FinnUtils::logAndError<std::runtime_error>("Stats page " + pageName + " is too small!");
+            }
+            void* memory = mmap(nullptr, sizeof(StatsPage), PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED) {
+                FinnUtils::logAndError<std::runtime_error>("Could not map stats page " + pageName + ": " + std::strerror(errno));
+            }
+            page = static_cast<const StatsPage*>(memory);
+        }
+
+        StatsPageReader(StatsPageReader&& other) noexcept : pageName(std::move(other.pageName)), page(std::exchange(other.page, nullptr)) {}
+        StatsPageReader(const StatsPageReader& other) = delete;
+        StatsPageReader& operator=(StatsPageReader&& other) = delete;
+        StatsPageReader& operator=(const StatsPageReader& other) = delete;
+
+        /**
+         * @brief Unmap the stats page
+         *
+         */
+        ~StatsPageReader() {
+            if (page) {
+                munmap(const_cast<StatsPage*>(page), sizeof(StatsPage));
+            }
+        }
+
+        /**
+         * @brief Read a consistent copy of the page. Retries while the writer updates the page.
+         *
+         * @param maxAttempts
+         * @return std::optional<StatsPageData> Empty if no consistent copy could be read or the page has an unknown layout
+         */
+        std::optional<StatsPageData> read(std::size_t maxAttempts = 1000) const {
+            StatsPageData copy;
+            for (std::size_t attempt = 0; attempt < maxAttempts; ++attempt) {
+                const uint64_t before = page->sequence.load(std::memory_order_acquire);
+                if (before % 2 != 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::memcpy(static_cast<void*>(&copy), &page->data, sizeof(StatsPageData));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (page->sequence.load(std::memory_order_relaxed) == before) {
+                    if (copy.magic != StatsPageData::pageMagic || copy.version != StatsPageData::pageVersion) {
+                        return std::nullopt;
+                    }
+                    return copy;
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Shared memory object name of the page
+         *
+         * @return const std::string&
+         */
+        const std::string& getPageName() const { return pageName; }
+    };
+}  // namespace Finn
+
+#endif  // STATSPAGE
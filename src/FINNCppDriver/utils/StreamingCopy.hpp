@@ -0,0 +1,188 @@
+/**
+ * @file StreamingCopy.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Copy routines for memory maps of XRT buffer objects that are write-combined or uncached
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef STREAMINGCOPY
+#define STREAMINGCOPY
+
+#include <FINNCppDriver/utils/Types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+    #include <smmintrin.h>
+#endif
+
+namespace FinnUtils {
+    /**
+     * @brief Internal implementations. Should not be used by user.
+     *
+     */
+    namespace detail {
+        /**
+         * @brief Width of a SSE vector in bytes
+         *
+         */
+        constexpr std::size_t vectorBytes = 16;
+
+        /**
+         * @brief How far ahead (in bytes) streaming loads prefetch the source
+         *
+         */
+        constexpr std::size_t prefetchDistance = 512;
+
+        /**
+         * @brief Returns the number of bytes that have to be copied until ptr is aligned to a vector boundary
+         *
+         * @param ptr
+         * @param bytes Number of bytes that are still to be copied
+         * @return std::size_t
+         */
+        inline std::size_t bytesUntilAligned(const void* ptr, std::size_t bytes) {
+            const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(ptr) & (vectorBytes - 1);
+            const std::size_t head = (vectorBytes - misalignment) & (vectorBytes - 1);
+            return (head < bytes) ? head : bytes;
+        }
+    }  // namespace detail
+
+    /**
+     * @brief Copy bytes from cached host memory into a write-combined or uncached destination using non-temporal stores (movntdq).
+     * The stores bypass the cache hierarchy and are combined into full cache line writes. A store fence is executed at the end, so the data is globally visible before the buffer is synced to the device.
+     * Falls back to memcpy if SSE2 is not available.
+     *
+     * @param dst Destination (usually the map of a buffer object)
+     * @param src Source
+     * @param bytes Number of bytes to copy
+     */
+    inline void streamingStore(void* dst, const void* src, std::size_t bytes) {
+#if defined(__SSE2__)
+        auto* out = static_cast<uint8_t*>(dst);
+        const auto* in = static_cast<const uint8_t*>(src);
+
+        // Non-temporal stores need an aligned destination
+        const std::size_t head = detail::bytesUntilAligned(out, bytes);
+        std::memcpy(out, in, head);
+        out += head;
+        in += head;
+        bytes -= head;
+
+        for (; bytes >= 4 * detail::vectorBytes; bytes -= 4 * detail::vectorBytes) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + detail::vectorBytes));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * detail::vectorBytes));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 3 * detail::vectorBytes));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(out), a);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(out + detail::vectorBytes), b);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(out + 2 * detail::vectorBytes), c);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(out + 3 * detail::vectorBytes), d);
+            out += 4 * detail::vectorBytes;
+            in += 4 * detail::vectorBytes;
+        }
+        for (; bytes >= detail::vectorBytes; bytes -= detail::vectorBytes) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(out), _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+            out += detail::vectorBytes;
+            in += detail::vectorBytes;
+        }
+        std::memcpy(out, in, bytes);
+        _mm_sfence();
+#else
+        std::memcpy(dst, src, bytes);
+#endif
+    }
+
+    /**
+     * @brief Copy bytes from a write-combined or uncached source into cached host memory using streaming loads (movntdqa) and software prefetching.
+     * On write-combined memory the streaming loads fetch a full line into a streaming load buffer instead of issuing one uncached read per access.
+     * Falls back to memcpy if SSE4.1 is not available.
+     *
+     * @param dst Destination
+     * @param src Source (usually the map of a buffer object)
+     * @param bytes Number of bytes to copy
+     */
+    inline void streamingLoad(void* dst, const void* src, std::size_t bytes) {
+#if defined(__SSE4_1__)
+        auto* out = static_cast<uint8_t*>(dst);
+        const auto* in = static_cast<const uint8_t*>(src);
+
+        // Streaming loads need an aligned source
+        const std::size_t head = detail::bytesUntilAligned(in, bytes);
+        std::memcpy(out, in, head);
+        out += head;
+        in += head;
+        bytes -= head;
+
+        // Order the streaming loads after all previous (possibly weakly ordered) writes to the map
+        _mm_mfence();
+        for (; bytes >= 4 * detail::vectorBytes; bytes -= 4 * detail::vectorBytes) {
+            _mm_prefetch(reinterpret_cast<const char*>(in + detail::prefetchDistance), _MM_HINT_NTA);
+            // _mm_stream_load_si128 is not declared const correct in older compilers
+            auto* inVec = const_cast<__m128i*>(reinterpret_cast<const __m128i*>(in));
+            const __m128i a = _mm_stream_load_si128(inVec);
+            const __m128i b = _mm_stream_load_si128(inVec + 1);
+            const __m128i c = _mm_stream_load_si128(inVec + 2);
+            const __m128i d = _mm_stream_load_si128(inVec + 3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + detail::vectorBytes), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * detail::vectorBytes), c);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * detail::vectorBytes), d);
+            out += 4 * detail::vectorBytes;
+            in += 4 * detail::vectorBytes;
+        }
+        for (; bytes >= detail::vectorBytes; bytes -= detail::vectorBytes) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_stream_load_si128(const_cast<__m128i*>(reinterpret_cast<const __m128i*>(in))));
+            out += detail::vectorBytes;
+            in += detail::vectorBytes;
+        }
+        std::memcpy(out, in, bytes);
+#else
+        std::memcpy(dst, src, bytes);
+#endif
+    }
+
+    /**
+     * @brief Copy bytes into a buffer object map. The copy routine is chosen by the mapping type of the destination.
+     *
+     * @param mapType Mapping type of dst
+     * @param dst
+     * @param src
+     * @param bytes
+     */
+    inline void copyToMap(MAP_TYPE mapType, void* dst, const void* src, std::size_t bytes) {
+        if (mapType == MAP_TYPE::CACHED) {
+            std::memcpy(dst, src, bytes);
+        } else {
+            streamingStore(dst, src, bytes);
+        }
+    }
+
+    /**
+     * @brief Copy bytes out of a buffer object map. The copy routine is chosen by the mapping type of the source.
+     *
+     * @param mapType Mapping type of src
+     * @param dst
+     * @param src
+     * @param bytes
+     */
+    inline void copyFromMap(MAP_TYPE mapType, void* dst, const void* src, std::size_t bytes) {
+        if (mapType == MAP_TYPE::CACHED) {
+            std::memcpy(dst, src, bytes);
+        } else {
+            streamingLoad(dst, src, bytes);
+        }
+    }
+}  // namespace FinnUtils
+
+#endif  // STREAMINGCOPY
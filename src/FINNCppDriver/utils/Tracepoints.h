@@ -0,0 +1,47 @@
+/**
+ * @file Tracepoints.h
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief USDT static tracepoints at the stage boundaries of the inference hot path
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ * The probes are compiled in when FINN_ENABLE_TRACEPOINTS is defined (CMake option of the same name, requires sys/sdt.h).
+ * An inactive probe is a single nop instruction, so probes can stay enabled in production builds. With probes compiled in, their
+ * arguments are evaluated on every pass and therefore have to stay cheap (integers and pointers only). Without FINN_ENABLE_TRACEPOINTS
+ * probes and arguments are compiled out, so values that only feed probes have to be marked [[maybe_unused]].
+ *
+ * All probes use the provider "finn". Overview (arguments in order):
+ *   infer_start, infer_done         device, buffer name, bytes, batch size, sequence number
+ *   store_done, execute_done        device, buffer name, bytes, batch size, sequence number
+ *   pack_start, pack_done           device, buffer name, elements, batch size, sequence number
+ *   unpack_start, unpack_done       device, buffer name, bytes, batch size, sequence number
+ *   kernel_start                    buffer name, repetitions
+ *   kernel_wait_start               buffer name
+ *   kernel_wait_done                buffer name, number of register polls
+ *   codec_pack_start, codec_pack_done, codec_unpack_start, codec_unpack_done
+ *                                   rows, elements per row, bitwidth, threads
+ */
+
+#ifndef TRACEPOINTS_H
+#define TRACEPOINTS_H
+
+#ifdef FINN_ENABLE_TRACEPOINTS
+    #include <sys/sdt.h>
+
+    /**
+     * @brief Fire the USDT probe finn:name with the given arguments
+     *
+     */
+    #define FINN_TRACE(name, ...) STAP_PROBEV(finn, name, __VA_ARGS__)
+#else
+    /**
+     * @brief Tracepoints are disabled, the probe and its arguments are compiled out
+     *
+     */
+    #define FINN_TRACE(name, ...) static_cast<void>(0)
+#endif
+
+#endif  // TRACEPOINTS_H
@@ -0,0 +1,164 @@
+/**
+ * @file Tunables.h
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Process wide mailbox for parameters that can be changed while the driver is running, e.g. through the ControlServer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef TUNABLES_H
+#define TUNABLES_H
+
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <atomic>
+#include <boost/log/core/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <cstdint>
+
+namespace FinnUtils {
+    /**
+     * @brief Runtime tunable parameters of the driver.
+     *
+     * Process wide parameters (wait policy, log level, live statistics) take effect immediately. Parameters that belong to a driver instance (batch size,
+     * codec sharding) are only stored here and increase the generation. Drivers pick them up between two batches in BaseDriver::applyTunables, which costs
+     * one relaxed atomic load while nothing changed. For these parameters 0 means "keep the current setting of the driver". There is only one set of
+     * tunables per process, so a change applies to every driver that calls applyTunables, e.g. to all models of a ModelRegistry.
+     *
+     */
+    class Tunables {
+         private:
+        inline static std::atomic<uint64_t> generationCounter{0};
+        inline static std::atomic<uint32_t> pendingBatchSize{0};
+        inline static std::atomic<uint64_t> pendingCodecThreads{0};
+        inline static std::atomic<uint64_t> pendingCodecMinElements{0};
+        inline static std::atomic<WAIT_POLICY> currentWaitPolicy{WAIT_POLICY::SPIN};
+        // Boost installs no filter by default, which is the same as trace. Drivers that install their own filter have to do so through setLogLevel.
+        inline static std::atomic<loglevel::severity_level> currentLogLevel{loglevel::trace};
+
+        static void publish() noexcept { generationCounter.fetch_add(1, std::memory_order_release); }
+
+         public:
+        /**
+         * @brief Generation of the driver parameters. Increased by every change of a parameter that is applied by the drivers.
+         *
+         * @return uint64_t
+         */
+        static uint64_t generation() noexcept { return generationCounter.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Request a new batch size
+         *
+         * @param batchSize 0 keeps the current batch size
+         */
+        static void setBatchSize(uint32_t batchSize) noexcept {
+            pendingBatchSize.store(batchSize, std::memory_order_relaxed);
+            publish();
+        }
+
+        /**
+         * @brief Requested batch size
+         *
+         * @return uint32_t 0 if not set
+         */
+        static uint32_t batchSize() noexcept { return pendingBatchSize.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Request a thread limit for packing and unpacking
+         *
+         * @param threads 0 keeps the current limit
+         */
+        static void setCodecThreads(uint64_t threads) noexcept {
+            pendingCodecThreads.store(threads, std::memory_order_relaxed);
+            publish();
+        }
+
+        /**
+         * @brief Requested thread limit for packing and unpacking
+         *
+         * @return uint64_t 0 if not set
+         */
+        static uint64_t codecThreads() noexcept { return pendingCodecThreads.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Request a minimum number of elements per codec thread
+         *
+         * @param elements 0 keeps the current value
+         */
+        static void setCodecMinElements(uint64_t elements) noexcept {
+            pendingCodecMinElements.store(elements, std::memory_order_relaxed);
+            publish();
+        }
+
+        /**
+         * @brief Requested minimum number of elements per codec thread
+         *
+         * @return uint64_t 0 if not set
+         */
+        static uint64_t codecMinElements() noexcept { return pendingCodecMinElements.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Set how threads wait for kernels. Takes effect with the next wait.
+         *
+         * @param policy
+         */
+        static void setWaitPolicy(WAIT_POLICY policy) noexcept { currentWaitPolicy.store(policy, std::memory_order_relaxed); }
+
+        /**
+         * @brief Current wait policy
+         *
+         * @return WAIT_POLICY
+         */
+        static WAIT_POLICY waitPolicy() noexcept { return currentWaitPolicy.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Only log messages of at least the given severity
+         *
+         * @param level
+         */
+        static void setLogLevel(loglevel::severity_level level) {
+            bl::core::get()->set_filter(loglevel::severity >= level);
+            currentLogLevel.store(level, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Current minimum log severity
+         *
+         * @return loglevel::severity_level
+         */
+        static loglevel::severity_level logLevel() noexcept { return currentLogLevel.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Enable or disable the recording of live statistics
+         *
+         * @param enable
+         */
+        static void setStats(bool enable) noexcept {
+            if (enable) {
+                LiveStats::enable();
+            } else {
+                LiveStats::disable();
+            }
+        }
+
+        /**
+         * @brief Reset all parameters to their defaults. Does not touch the log filter and live statistics.
+         *
+         */
+        static void reset() noexcept {
+            pendingBatchSize.store(0, std::memory_order_relaxed);
+            pendingCodecThreads.store(0, std::memory_order_relaxed);
+            pendingCodecMinElements.store(0, std::memory_order_relaxed);
+            currentWaitPolicy.store(WAIT_POLICY::SPIN, std::memory_order_relaxed);
+            publish();
+        }
+    };
+}  // namespace FinnUtils
+
+#endif  // TUNABLES_H
@@ -78,6 +78,30 @@ enum class SIZE_SPECIFIER { BYTES = 0, TOTAL_DATA_SIZE = 1, BATCHSIZE = 4, FEATU
  */
 enum class ENDIAN { LITTLE = 0, BIG = 1, UNSPECIFIED = -1 };
 
+/**
+ * @brief Caching behaviour of the host mapping of a buffer object. Selects the copy routines used to access the map.
+ *
+ */
+enum class MAP_TYPE { CACHED = 0, WRITE_COMBINED = 1, UNCACHED = 2 };
+
+/**
+ * @brief Queue used by asynchronous input buffers to collect submitted inputs. MPMC avoids the mutex of the ring buffer when many threads submit concurrently.
+ *
+ */
+enum class SUBMISSION_QUEUE { RING_BUFFER = 0, MPMC = 1 };
+
+/**
+ * @brief Kind of synthetic input stream generated for throughput tests and benchmarks
+ *
+ */
+enum class WORKLOAD { UNIFORM = 0, ZIPF = 1, CORRELATED = 2, BURSTY = 3 };
+
+/**
+ * @brief How a thread waits for a kernel to finish. SPIN polls the control register back to back, YIELD gives up the core between two polls.
+ *
+ */
+enum class WAIT_POLICY { SPIN = 0, YIELD = 1 };
+
 /**
  * @brief Type for normal Shape
  *
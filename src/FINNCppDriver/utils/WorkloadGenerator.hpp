@@ -0,0 +1,416 @@
+/**
+ * @file WorkloadGenerator.hpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Generates synthetic input streams (uniform, duplicate heavy, temporally correlated, bursty) for throughput tests and benchmarks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#ifndef WORKLOADGENERATOR
+#define WORKLOADGENERATOR
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/utils/AlignedAllocator.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Finn {
+    /**
+     * @brief Parameters of a synthetic workload
+     *
+     */
+    struct WorkloadOptions {
+        /**
+         * @brief Kind of the generated stream
+         *
+         */
+        WORKLOAD type = WORKLOAD::UNIFORM;
+        /**
+         * @brief ZIPF: Number of distinct frames the stream is drawn from
+         *
+         */
+        std::size_t distinctFrames = 64;
+        /**
+         * @brief ZIPF: Exponent of the rank distribution. Larger values concentrate the stream on fewer frames.
+         *
+         */
+        double zipfExponent = 1.1;
+        /**
+         * @brief CORRELATED: Fraction of the elements of a frame that change compared to the previous frame
+         *
+         */
+        double deltaFraction = 0.01;
+        /**
+         * @brief BURSTY: Number of batches that arrive back to back
+         *
+         */
+        std::size_t burstLength = 8;
+        /**
+         * @brief BURSTY: Idle time between two bursts
+         *
+         */
+        std::chrono::microseconds burstGap{1000};
+        /**
+         * @brief Seed of the generator. 0 selects a random seed.
+         *
+         */
+        std::uint64_t seed = 0;
+    };
+
+    /**
+     * @brief Parse the name of a workload (uniform, zipf, correlated, bursty)
+     *
+     * @param name
+     * @return WORKLOAD
+     */
+    inline WORKLOAD workloadFromString(const std::string& name) {
+        if (name == "uniform") {
+            return WORKLOAD::UNIFORM;
+        } else if (name == "zipf") {
+            return WORKLOAD::ZIPF;
+        } else if (name == "correlated") {
+            return WORKLOAD::CORRELATED;
+        } else if (name == "bursty") {
+            return WORKLOAD::BURSTY;
+        }
+        FinnUtils::logAndError<std::invalid_argument>("Unknown workload: " + name);
+        return WORKLOAD::UNIFORM;
+    }
+
+    /**
+     * @brief Get the name of a workload
+     *
+     * @param workload
+     * @return std::string
+     */
+    inline std::string toString(WORKLOAD workload) {
+        switch (workload) {
+            case WORKLOAD::UNIFORM:
+                return "uniform";
+            case WORKLOAD::ZIPF:
+                return "zipf";
+            case WORKLOAD::CORRELATED:
+                return "correlated";
+            case WORKLOAD::BURSTY:
+                return "bursty";
+            default:
+                FinnUtils::unreachable();
+        }
+    }
+
+    namespace detail {
+        /**
+         * @brief Several independent xoshiro256** generators in structure of arrays layout.
+         * The lanes do not depend on each other, so one step over all lanes is vectorized by the compiler.
+         *
+         */
+        class LaneRandom {
+             public:
+            /**
+             * @brief Number of independent generators
+             *
+             */
+            static constexpr std::size_t lanes = 8;
+
+             private:
+            alignas(64) std::array<std::uint64_t, lanes> s0{};
+            alignas(64) std::array<std::uint64_t, lanes> s1{};
+            alignas(64) std::array<std::uint64_t, lanes> s2{};
+            alignas(64) std::array<std::uint64_t, lanes> s3{};
+
+            static constexpr std::uint64_t rotl(std::uint64_t val, int shift) { return (val << shift) | (val >> (64 - shift)); }
+
+            static std::uint64_t splitmix(std::uint64_t& state) {
+                std::uint64_t val = (state += 0x9E3779B97F4A7C15ULL);
+                val = (val ^ (val >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                val = (val ^ (val >> 27U)) * 0x94D049BB133111EBULL;
+                return val ^ (val >> 31U);
+            }
+
+             public:
+            /**
+             * @brief Construct a new Lane Random object
+             *
+             * @param seed
+             */
+            explicit LaneRandom(std::uint64_t seed) {
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    s0[lane] = splitmix(seed);
+                    s1[lane] = splitmix(seed);
+                    s2[lane] = splitmix(seed);
+                    s3[lane] = splitmix(seed);
+                }
+            }
+
+            /**
+             * @brief Advance all lanes by one step
+             *
+             * @param out One random value per lane
+             */
+            void step(std::array<std::uint64_t, lanes>& out) {
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    out[lane] = rotl(s1[lane] * 5, 7) * 9;
+                    const std::uint64_t tmp = s1[lane] << 17U;
+                    s2[lane] ^= s0[lane];
+                    s3[lane] ^= s1[lane];
+                    s1[lane] ^= s2[lane];
+                    s0[lane] ^= s3[lane];
+                    s2[lane] ^= tmp;
+                    s3[lane] = rotl(s3[lane], 45);
+                }
+            }
+
+            /**
+             * @brief Get a single random value
+             *
+             * @return std::uint64_t
+             */
+            std::uint64_t next() {
+                std::array<std::uint64_t, lanes> out{};
+                step(out);
+                return out[0];
+            }
+        };
+    }  // namespace detail
+
+    /**
+     * @brief Generates a synthetic input stream and precomputes it before the measurement starts.
+     *
+     * The generator produces frames (one input sample) that are grouped into batches. All batches are generated in the constructor
+     * and replayed cyclically, so that generating inputs does not dominate the runtime of the measured loop.
+     *  - UNIFORM: Every element is drawn uniformly from [min, max]
+     *  - ZIPF: Frames are drawn from a pool of distinctFrames uniform frames, the rank of the frame follows a Zipf distribution (duplicate heavy traffic)
+     *  - CORRELATED: Every frame differs from the previous one in deltaFraction of its elements (video like streams, delta sync)
+     *  - BURSTY: Uniform data, but batches arrive in bursts of burstLength separated by burstGap. See arrivalDelay().
+     *
+     * @tparam T Host type of the input elements
+     */
+    template<typename T>
+    class WorkloadGenerator {
+         private:
+        std::size_t frameElements;
+        std::size_t batchSize;
+        std::size_t batchCount;
+        WorkloadOptions options;
+        T minValue;
+        T maxValue;
+        detail::LaneRandom random;
+        Finn::vector<T> batches;
+        std::size_t nextBatch = 0;
+
+        /**
+         * @brief Map a random value into [minValue, maxValue]
+         *
+         * @param rnd
+         * @return T
+         */
+        T map(std::uint64_t rnd) const {
+            if constexpr (std::is_floating_point_v<T>) {
+                constexpr double scale = 1.0 / static_cast<double>(1ULL << 53U);
+                return static_cast<T>(static_cast<double>(minValue) + static_cast<double>(rnd >> 11U) * scale * (static_cast<double>(maxValue) - static_cast<double>(minValue)));
+            } else {
+                // Multiply-shift range reduction, the bias is negligible for the small ranges of FINN datatypes
+                const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(maxValue) - static_cast<std::int64_t>(minValue)) + 1;
+                return static_cast<T>(static_cast<std::int64_t>(minValue) + static_cast<std::int64_t>(((rnd >> 32U) * range) >> 32U));
+            }
+        }
+
+        /**
+         * @brief Fill a range with uniformly distributed values
+         *
+         * @param out
+         */
+        void fillUniform(std::span<T> out) {
+            constexpr std::size_t lanes = detail::LaneRandom::lanes;
+            std::array<std::uint64_t, lanes> rnd{};
+            std::size_t index = 0;
+            for (; index + lanes <= out.size(); index += lanes) {
+                random.step(rnd);
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    out[index + lane] = map(rnd[lane]);
+                }
+            }
+            if (index < out.size()) {
+                random.step(rnd);
+                for (std::size_t lane = 0; index < out.size(); ++index, ++lane) {
+                    out[index] = map(rnd[lane]);
+                }
+            }
+        }
+
+        /**
+         * @brief Draw a uniform value in [0, 1)
+         *
+         * @return double
+         */
+        double uniformReal() { return static_cast<double>(random.next() >> 11U) / static_cast<double>(1ULL << 53U); }
+
+        /**
+         * @brief Get a frame of the precomputed stream
+         *
+         * @param frame
+         * @return std::span<T>
+         */
+        std::span<T> frameSpan(std::size_t frame) { return std::span<T>(batches.data() + frame * frameElements, frameElements); }
+
+        void generateZipf() {
+            const std::size_t poolSize = std::max<std::size_t>(options.distinctFrames, 1);
+            Finn::vector<T> pool(poolSize * frameElements);
+            fillUniform(std::span<T>(pool.data(), pool.size()));
+
+            std::vector<double> cdf(poolSize);
+            double sum = 0.0;
+            for (std::size_t rank = 0; rank < poolSize; ++rank) {
+                sum += 1.0 / std::pow(static_cast<double>(rank + 1), options.zipfExponent);
+                cdf[rank] = sum;
+            }
+            const std::size_t frames = batchCount * batchSize;
+            for (std::size_t frame = 0; frame < frames; ++frame) {
+                const double sample = uniformReal() * sum;
+                const auto rank = static_cast<std::size_t>(std::distance(cdf.begin(), std::upper_bound(cdf.begin(), cdf.end(), sample)));
+                const auto source = pool.begin() + static_cast<std::ptrdiff_t>(std::min(rank, poolSize - 1) * frameElements);
+                std::copy(source, source + static_cast<std::ptrdiff_t>(frameElements), frameSpan(frame).begin());
+            }
+        }
+
+        void generateCorrelated() {
+            const std::size_t frames = batchCount * batchSize;
+            const auto changes = std::max<std::size_t>(1, static_cast<std::size_t>(std::llround(options.deltaFraction * static_cast<double>(frameElements))));
+            fillUniform(frameSpan(0));
+            for (std::size_t frame = 1; frame < frames; ++frame) {
+                auto previous = frameSpan(frame - 1);
+                auto current = frameSpan(frame);
+                std::copy(previous.begin(), previous.end(), current.begin());
+                for (std::size_t change = 0; change < changes; ++change) {
+                    const std::size_t position = ((random.next() >> 32U) * frameElements) >> 32U;
+                    current[position] = map(random.next());
+                }
+            }
+        }
+
+         public:
+        /**
+         * @brief Construct a new Workload Generator object and precompute all batches
+         *
+         * @param pFrameElements Number of elements of one frame (one input sample)
+         * @param pBatchSize Number of frames per batch
+         * @param pBatchCount Number of batches that are precomputed and replayed cyclically
+         * @param pMin Smallest value of an element
+         * @param pMax Largest value of an element
+         * @param pOptions
+         */
+        WorkloadGenerator(std::size_t pFrameElements, std::size_t pBatchSize, std::size_t pBatchCount, T pMin, T pMax, const WorkloadOptions& pOptions = {})
+            : frameElements(pFrameElements),
+              batchSize(pBatchSize),
+              batchCount(pBatchCount),
+              options(pOptions),
+              minValue(pMin),
+              maxValue(pMax),
+              random((pOptions.seed == 0) ? std::random_device{}() : pOptions.seed),
+              batches(pFrameElements * pBatchSize * pBatchCount) {
+            if (batches.empty()) {
+                FinnUtils::logAndError<std::runtime_error>("It is not possible to generate a workload of size 0!");
+            }
+            if (pMin > pMax) {
+                FinnUtils::logAndError<std::invalid_argument>("Minimum of the workload is larger than its maximum!");
+            }
+            switch (options.type) {
+                case WORKLOAD::UNIFORM:
+                case WORKLOAD::BURSTY:
+                    fillUniform(std::span<T>(batches.data(), batches.size()));
+                    break;
+                case WORKLOAD::ZIPF:
+                    generateZipf();
+                    break;
+                case WORKLOAD::CORRELATED:
+                    generateCorrelated();
+                    break;
+                default:
+                    FinnUtils::unreachable();
+            }
+        }
+
+        /**
+         * @brief Get the next batch of the stream. Wraps around after the last precomputed batch.
+         *
+         * @return std::span<const T>
+         */
+        std::span<const T> next() {
+            auto ret = batch(nextBatch);
+            nextBatch = (nextBatch + 1) % batchCount;
+            return ret;
+        }
+
+        /**
+         * @brief Copy the next batch of the stream into the given range. Use this if the consumer modifies its input (e.g. packing in place).
+         *
+         * @tparam IteratorType
+         * @param out Range with space for one batch
+         */
+        template<typename IteratorType>
+        void next(IteratorType out) {
+            auto data = next();
+            std::copy(data.begin(), data.end(), out);
+        }
+
+        /**
+         * @brief Get a precomputed batch
+         *
+         * @param index
+         * @return std::span<const T>
+         */
+        std::span<const T> batch(std::size_t index) const { return std::span<const T>(batches.data() + (index % batchCount) * batchElements(), batchElements()); }
+
+        /**
+         * @brief Idle time before the batch with the given index arrives. Only BURSTY streams have idle times, between two bursts.
+         *
+         * @param index
+         * @return std::chrono::microseconds
+         */
+        std::chrono::microseconds arrivalDelay(std::size_t index) const {
+            if (options.type != WORKLOAD::BURSTY || index == 0 || options.burstLength == 0 || index % options.burstLength != 0) {
+                return std::chrono::microseconds(0);
+            }
+            return options.burstGap;
+        }
+
+        /**
+         * @brief Number of elements of one batch
+         *
+         * @return std::size_t
+         */
+        std::size_t batchElements() const { return frameElements * batchSize; }
+
+        /**
+         * @brief Number of precomputed batches
+         *
+         * @return std::size_t
+         */
+        std::size_t size() const { return batchCount; }
+
+        /**
+         * @brief Get the options of the workload
+         *
+         * @return const WorkloadOptions&
+         */
+        const WorkloadOptions& getOptions() const { return options; }
+    };
+}  // namespace Finn
+
+#endif  // WORKLOADGENERATOR
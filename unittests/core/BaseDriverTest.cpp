@@ -12,14 +12,20 @@
 
 
 #include <FINNCppDriver/config/FinnDriverUsedDatatypes.h>
+#include <FINNCppDriver/utils/AllocationCounter.h>
+#include <FINNCppDriver/utils/AllocationHooks.h>
 #include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/LiveStats.h>
 #include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Tunables.h>
 #include <FINNCppDriver/utils/Types.h>
 
 #include <FINNCppDriver/core/BaseDriver.hpp>
 #include <FINNCppDriver/core/DeviceBuffer/SyncDeviceBuffers.hpp>
 #include <FINNCppDriver/utils/FinnDatatypes.hpp>
 #include <FINNCppDriver/utils/join.hpp>
+#include <chrono>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include "xrt/xrt_device.h"
@@ -105,6 +111,155 @@ TEST_F(BaseDriverTest, syncInferenceTest) {
     EXPECT_EQ(results, expected);
 }
 
+TEST_F(BaseDriverTest, syncPackedInferenceTest) {
+    auto driver = Finn::Driver<true>(unittestConfig, 0, inputDmaName, 0, outputDmaName, 1, true);
+    Finn::vector<int8_t> data(300, 1);
+    Finn::vector<uint8_t> outdata(driver.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, outputDmaName));
+    FinnUtils::BufferFiller(0, 255).fillRandom(outdata.begin(), outdata.end());
+    driver.getDeviceHandler(0).getOutputBuffer(outputDmaName)->testSetMap(outdata);
+
+    auto packed = driver.inferSynchronousPacked(data.begin(), data.end());
+    auto unpacked = driver.inferSynchronous(data.begin(), data.end());
+
+    // The compact result keeps the packed bytes and decodes to the same values
+    EXPECT_TRUE(std::equal(packed.bytes().begin(), packed.bytes().end(), outdata.begin()));
+    EXPECT_EQ(packed.expand(), unpacked);
+}
+
+TEST_F(BaseDriverTest, applyTunablesTest) {
+    FinnUtils::Tunables::reset();
+    auto driver = Finn::Driver<true>(unittestConfig, 0, inputDmaName, 0, outputDmaName, 1, true);
+    // Tunables that were not changed keep the driver settings
+    driver.applyTunables();
+    EXPECT_EQ(driver.getBatchSize(), 1U);
+    EXPECT_EQ(driver.getPackTuning(), Finn::CodecTuning{});
+    EXPECT_FALSE(driver.applyTunables());
+
+    FinnUtils::Tunables::setBatchSize(2);
+    FinnUtils::Tunables::setCodecThreads(3);
+    FinnUtils::Tunables::setWaitPolicy(WAIT_POLICY::YIELD);
+    EXPECT_TRUE(driver.applyTunables());
+    EXPECT_EQ(driver.getBatchSize(), 2U);
+    EXPECT_EQ(driver.getPackTuning().maxThreads, 3U);
+    EXPECT_EQ(driver.getUnpackTuning().maxThreads, 3U);
+    EXPECT_EQ(driver.getPackTuning().minElementsPerThread, Finn::CodecTuning::defaultMinElementsPerThread);
+    EXPECT_EQ(FinnUtils::LiveStats::snapshot().tunablesGeneration, FinnUtils::Tunables::generation());
+    // Nothing changed since the last call
+    EXPECT_FALSE(driver.applyTunables());
+
+    // Inference uses the new batch size and waits with the yield policy
+    Finn::vector<int8_t> data(600, 1);
+    auto results = driver.inferSynchronous(data.begin(), data.end());
+    EXPECT_EQ(results.size(), 2 * driver.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, outputDmaName));
+    FinnUtils::Tunables::reset();
+}
+
+TEST_F(BaseDriverTest, asyncApplyTunablesTest) {
+    FinnUtils::Tunables::reset();
+    {
+        auto driver = Finn::Driver<false>(unittestConfig, 0, inputDmaName, 0, outputDmaName, 1, true);
+        const auto inputBuffer = driver.getInputBuffer(0, inputDmaName);
+        FinnUtils::Tunables::setBatchSize(2);
+        FinnUtils::Tunables::setCodecThreads(3);
+        // The running buffers are kept, the other tunables are applied
+        EXPECT_FALSE(driver.applyTunables());
+        EXPECT_EQ(driver.getBatchSize(), 1U);
+        EXPECT_EQ(driver.getInputBuffer(0, inputDmaName), inputBuffer);
+        EXPECT_EQ(driver.getPackTuning().maxThreads, 3U);
+
+        // The driver still accepts input
+        Finn::vector<int8_t> data(driver.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, inputDmaName) * 4, 1);
+        driver.input(data.begin(), data.end());
+    }
+    FinnUtils::Tunables::reset();
+}
+
+TEST_F(BaseDriverTest, allocationCountingTest) {
+    using FinnUtils::AllocationCounter;
+    auto driver = Finn::Driver<true>(unittestConfig, 0, inputDmaName, 0, outputDmaName, 1, true);
+    Finn::vector<int8_t> data(300, 1);
+    Finn::vector<uint8_t> outdata(driver.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, outputDmaName), 1);
+    driver.getDeviceHandler(0).getOutputBuffer(outputDmaName)->testSetMap(outdata);
+
+    // Warmup, so that lazily initialized state (static shapes, logger, ...) does not count
+    for (int i = 0; i < 3; ++i) {
+        auto warmup = driver.inferSynchronous(data.begin(), data.end());
+    }
+
+    AllocationCounter::enable();
+    const auto inferOnce = [&]() {
+        const auto before = AllocationCounter::threadStatistics();
+        auto results = driver.inferSynchronous(data.begin(), data.end());
+        const auto after = AllocationCounter::threadStatistics();
+        AllocationCounter::Table diff{};
+        for (std::size_t src = 0; src < AllocationCounter::sourceCount; ++src) {
+            for (std::size_t stg = 0; stg < AllocationCounter::stageCount; ++stg) {
+                diff[src][stg] = after[src][stg] - before[src][stg];
+            }
+        }
+        return diff;
+    };
+    const auto first = inferOnce();
+    EXPECT_EQ(AllocationCounter::currentStage(), DRIVER_STAGE::NONE);
+    // Packing straight into the device buffer map must not allocate
+    EXPECT_EQ(AllocationCounter::total(first, DRIVER_STAGE::STORE).allocations, 0U);
+    EXPECT_EQ(AllocationCounter::total(first, DRIVER_STAGE::PACK).allocations, 0U);
+    EXPECT_GT(AllocationCounter::total(first, DRIVER_STAGE::UNPACK).allocations, 0U);
+
+    // In steady state every inference allocates exactly the same
+    for (int i = 0; i < 10; ++i) {
+        const auto next = inferOnce();
+        for (std::size_t stg = 0; stg < AllocationCounter::stageCount; ++stg) {
+            EXPECT_EQ(AllocationCounter::total(next, static_cast<DRIVER_STAGE>(stg)).allocations, AllocationCounter::total(first, static_cast<DRIVER_STAGE>(stg)).allocations) << "stage " << stg;
+            EXPECT_EQ(AllocationCounter::total(next, static_cast<DRIVER_STAGE>(stg)).bytes, AllocationCounter::total(first, static_cast<DRIVER_STAGE>(stg)).bytes) << "stage " << stg;
+        }
+    }
+
+    // Allocations are attributed to the stage of the calling thread
+    const auto before = AllocationCounter::threadStatistics();
+    {
+        const AllocationCounter::StageGuard stage(DRIVER_STAGE::UNPACK);
+        Finn::vector<uint8_t> vec(100);
+        EXPECT_EQ(AllocationCounter::currentStage(), DRIVER_STAGE::UNPACK);
+    }
+    const auto after = AllocationCounter::threadStatistics();
+    const auto diff = after[static_cast<std::size_t>(ALLOCATION_SOURCE::ALIGNED_ALLOCATOR)][static_cast<std::size_t>(DRIVER_STAGE::UNPACK)] -
+                      before[static_cast<std::size_t>(ALLOCATION_SOURCE::ALIGNED_ALLOCATOR)][static_cast<std::size_t>(DRIVER_STAGE::UNPACK)];
+    EXPECT_EQ(diff.allocations, 1U);
+    EXPECT_EQ(diff.bytes, 128U);
+    AllocationCounter::disable();
+}
+
+TEST_F(BaseDriverTest, asyncLiveStatsTest) {
+    using FinnUtils::LiveStats;
+    LiveStats::reset();
+    LiveStats::enable();
+    {
+        auto driver = Finn::Driver<false>(unittestConfig, 0, inputDmaName, 0, outputDmaName, 1, true);
+        const std::size_t packedBytes = driver.size(SIZE_SPECIFIER::FEATUREMAP_SIZE, 0, inputDmaName);
+        Finn::vector<int8_t> data(packedBytes * 4, 1);
+        driver.input(data.begin(), data.end());
+        // The output worker archives results in the background
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (driver.getDeviceHandler(0).getOutputBuffer(outputDmaName)->testGetLongTermStorageSize() == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto results = driver.getResults();
+
+        // Asynchronous inferences show up in the live statistics like synchronous ones
+        const auto stats = LiveStats::snapshot();
+        EXPECT_EQ(stats.inferences, 1U);
+        EXPECT_EQ(stats.batchElements, 1U);
+        EXPECT_EQ(stats.bytesIn, packedBytes);
+        for (const auto stage : {DRIVER_STAGE::PACK, DRIVER_STAGE::STORE, DRIVER_STAGE::RETRIEVE, DRIVER_STAGE::UNPACK}) {
+            const auto& histogram = stats.latency[static_cast<std::size_t>(stage)];
+            EXPECT_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t{0}), 1U) << "stage " << static_cast<int>(stage);
+        }
+    }
+    LiveStats::disable();
+    LiveStats::reset();
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
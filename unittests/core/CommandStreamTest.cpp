@@ -0,0 +1,125 @@
+/**
+ * @file CommandStreamTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the command streams and events
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+
+#include <FINNCppDriver/core/CommandStream.hpp>
+#include <FINNCppDriver/core/DeviceBuffer/SyncDeviceBuffers.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "UnittestConfig.h"
+#include "gtest/gtest.h"
+#include "xrt/xrt_device.h"
+
+using namespace FinnUnittest;
+
+TEST(CommandStreamTest, OrderTest) {
+    Finn::CommandStream stream("Ordered");
+    std::vector<int> order;
+    for (int i = 0; i < 100; ++i) {
+        stream.enqueueHostFn([&order, i]() { order.emplace_back(i); });
+    }
+    stream.synchronize();
+    ASSERT_EQ(order.size(), 100U);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+    }
+    EXPECT_TRUE(stream.record().query());
+    EXPECT_TRUE(Finn::Event().query());
+}
+
+TEST(CommandStreamTest, CrossStreamDependencyTest) {
+    Finn::CommandStream producer("Producer");
+    Finn::CommandStream consumer("Consumer");
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    auto log = [&](const std::string& entry) {
+        const std::lock_guard lock(orderMutex);
+        order.emplace_back(entry);
+    };
+
+    auto produced = producer.enqueueHostFn([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        log("produce");
+    });
+    consumer.enqueueWait(produced);
+    consumer.enqueueHostFn([&]() { log("consume"); });
+    auto finished = consumer.enqueueHostFn([&]() { log("finish"); }, {produced});
+    finished.wait();
+    EXPECT_EQ(order, (std::vector<std::string>{"produce", "consume", "finish"}));
+}
+
+TEST(CommandStreamTest, ErrorPropagationTest) {
+    Finn::CommandStream first("First");
+    Finn::CommandStream second("Second");
+    std::atomic<bool> dependentRan{false};
+    std::atomic<bool> independentRan{false};
+
+    auto failed = first.enqueueHostFn([]() { throw std::runtime_error("host function failed"); });
+    auto dependent = second.enqueueHostFn([&]() { dependentRan = true; }, {failed});
+    auto independent = first.enqueueHostFn([&]() { independentRan = true; });
+
+    EXPECT_THROW(failed.wait(), std::runtime_error);
+    // Commands depending on a failed event are skipped and inherit its error
+    EXPECT_THROW(dependent.wait(), std::runtime_error);
+    EXPECT_FALSE(dependentRan);
+    // The stream itself keeps executing
+    EXPECT_NO_THROW(independent.wait());
+    EXPECT_TRUE(independentRan);
+}
+
+TEST(CommandStreamTest, DeviceBufferPipelineTest) {
+    xrt::device device;
+    xrt::uuid uuid;
+    auto input = std::make_shared<Finn::SyncDeviceInputBuffer<uint8_t>>("InputBuffer", device, uuid, myShapePacked, parts);
+    auto output = std::make_shared<Finn::SyncDeviceOutputBuffer<uint8_t>>("OutputBuffer", device, uuid, myShapePacked, parts);
+
+    Finn::vector<uint8_t> data(input->size(SIZE_SPECIFIER::TOTAL_DATA_SIZE));
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+    Finn::vector<uint8_t> expected(output->size(SIZE_SPECIFIER::TOTAL_DATA_SIZE));
+    FinnUtils::BufferFiller(0, 255).fillRandom(expected.begin(), expected.end());
+    output->testSetMap(expected);
+
+    // Output kernel on its own stream, so that it runs concurrently with the input kernel
+    Finn::CommandStream inputStream("Input");
+    Finn::CommandStream outputStream("Output");
+    Finn::vector<uint8_t> result(expected.size());
+    std::size_t processed = 0;
+
+    inputStream.enqueueWrite(input, data);
+    auto inputDone = inputStream.enqueueRun(input);
+    auto outputDone = outputStream.enqueueRun(output);
+    auto readDone = outputStream.enqueueRead(output, result, {inputDone});
+    // Host processing after the read, e.g. between two partitions
+    auto hostDone = inputStream.enqueueHostFn([&]() { processed = result.size(); }, {readDone});
+
+    hostDone.wait();
+    EXPECT_TRUE(outputDone.query());
+    EXPECT_EQ(input->testGetMap(), data);
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(processed, expected.size());
+
+    Finn::vector<uint8_t> tooSmall(expected.size() - 1);
+    EXPECT_THROW(outputStream.enqueueRead(output, tooSmall), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
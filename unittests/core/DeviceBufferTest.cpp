@@ -54,6 +54,30 @@ TEST_F(DBTest, DBOutputTest) {
     EXPECT_EQ(data, vec);
 }
 
+TEST_F(DBTest, DBMapViewTest) {
+    Finn::SyncDeviceInputBuffer<uint8_t> buffer("InputBuffer", device, uuid, FinnUnittest::myShapePacked, FinnUnittest::parts);
+    auto view = buffer.getMapView();
+    EXPECT_EQ(view.size(), buffer.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE));
+    Finn::vector<uint8_t> data(view.size());
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+    std::copy(data.begin(), data.end(), view.begin());
+    EXPECT_EQ(buffer.testGetMap(), data);
+}
+
+TEST_F(DBTest, DBMapTypeTest) {
+    using Buffer = Finn::SyncDeviceInputBuffer<uint8_t>;
+    EXPECT_EQ(Buffer::mapTypeFromFlags(xrt::bo::flags::p2p, MAP_TYPE::CACHED), MAP_TYPE::WRITE_COMBINED);
+    EXPECT_EQ(Buffer::mapTypeFromFlags(xrt::bo::flags::cacheable, MAP_TYPE::UNCACHED), MAP_TYPE::CACHED);
+    EXPECT_EQ(Buffer::mapTypeFromFlags(xrt::bo::flags::host_only, MAP_TYPE::WRITE_COMBINED), MAP_TYPE::CACHED);
+    EXPECT_EQ(Buffer::mapTypeFromFlags(xrt::bo::flags::normal, MAP_TYPE::UNCACHED), MAP_TYPE::UNCACHED);
+
+    // The buffer objects of the mock have normal flags, so the configuration decides
+    Buffer buffer("InputBuffer", device, uuid, FinnUnittest::myShapePacked, FinnUnittest::parts);
+    EXPECT_EQ(buffer.getMapType(), MAP_TYPE::CACHED);
+    buffer.setMapType(MAP_TYPE::WRITE_COMBINED);
+    EXPECT_EQ(buffer.getMapType(), MAP_TYPE::WRITE_COMBINED);
+}
+
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
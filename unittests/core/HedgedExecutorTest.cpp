@@ -0,0 +1,200 @@
+/**
+ * @file HedgedExecutorTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the hedged execution over several devices
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <FINNCppDriver/utils/Logger.h>
+
+#include <FINNCppDriver/core/HedgedExecutor.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "UnittestConfig.h"
+#include "gtest/gtest.h"
+#include "xrt/xrt_device.h"
+
+using namespace FinnUnittest;
+
+using InputFinnType = Finn::DatatypeInt<2>;
+using OutputFinnType = Finn::DatatypeBinary;
+using Executor = Finn::HedgedExecutor<InputFinnType, OutputFinnType>;
+
+class HedgedExecutorTest : public ::testing::Test {
+     protected:
+    std::string fn = "finn-accel.xclbin";
+    Finn::Config config = unittestConfig;
+    void SetUp() override {
+        std::fstream tmpfile(fn, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+        // Second card with the same bitstream
+        config.deviceWrappers.emplace_back(unittestConfig.deviceWrappers[0]);
+        config.deviceWrappers[1].xrtDeviceIndex = 1;
+    }
+
+    void TearDown() override { std::filesystem::remove(fn); }
+
+    /**
+     * @brief Run requests one after another on alternating devices until the hedge delay is learned. Latency critical requests also earn the budget.
+     *
+     */
+    static void warmUp(Executor& executor, std::size_t requests) {
+        for (std::size_t i = 0; i < requests; ++i) {
+            executor.submit(i % executor.devices(), Finn::vector<Executor::InputType>(executor.inputSize())).get();
+        }
+        ASSERT_NE(executor.getStatistics().hedgeDelayNs, 0U);
+    }
+
+    /**
+     * @brief Wait until the losing launches finished
+     *
+     */
+    static bool waitForDiscarded(Executor& executor, std::size_t discarded) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (executor.getStatistics().discarded < discarded) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+TEST_F(HedgedExecutorTest, SlowDeviceTest) {
+    Executor executor(config, Finn::HedgeOptions{.budget = 0.1, .minSamples = 16, .minDelay = std::chrono::microseconds(500)});
+    ASSERT_EQ(executor.devices(), 2U);
+    warmUp(executor, 64);
+
+    Finn::vector<uint8_t> output(executor.testGetOutputBuffer(1).size(SIZE_SPECIFIER::TOTAL_DATA_SIZE));
+    FinnUtils::BufferFiller(0, 255).fillRandom(output.begin(), output.end());
+    executor.testGetOutputBuffer(1).testSetMap(output);
+
+    // Scheduling noise may already have caused duplicates during the warm up
+    const auto before = executor.getStatistics();
+    const auto launchesBefore = executor.getLaunches(1);
+    FinnUtils::LiveStats::reset();
+    FinnUtils::LiveStats::enable();
+
+    // Device 0 stalls, the duplicate on device 1 answers long before
+    executor.testSetDelay(0, std::chrono::seconds(2));
+    const auto start = std::chrono::steady_clock::now();
+    auto result = executor.submit(0, Finn::vector<Executor::InputType>(executor.inputSize())).get();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    auto outputShapePacked = unittestConfig.deviceWrappers[0].odmas[0]->packedShape;
+    auto outputShapeFolded = std::dynamic_pointer_cast<Finn::ExtendedBufferDescriptor>(unittestConfig.deviceWrappers[0].odmas[0])->foldedShape;
+    const Finn::DynamicMdSpan reshapedOutput(output.begin(), output.end(), outputShapePacked);
+    EXPECT_EQ(result, (Finn::unpackMultiDimensionalOutputs<OutputFinnType, Finn::vector<uint8_t>::iterator, false, Executor::OutputType>(output.begin(), output.end(), reshapedOutput, outputShapeFolded)));
+
+    auto stats = executor.getStatistics();
+    EXPECT_EQ(stats.hedges, before.hedges + 1);
+    EXPECT_EQ(stats.hedgeWins, before.hedgeWins + 1);
+    EXPECT_EQ(executor.getLaunches(1), launchesBefore + 1);
+    // The result of the stalled device is thrown away
+    EXPECT_TRUE(waitForDiscarded(executor, before.discarded + 1));
+    // Both launches moved data, but the request is one inference
+    EXPECT_EQ(FinnUtils::LiveStats::snapshot().inferences, 1U);
+    EXPECT_EQ(FinnUtils::LiveStats::snapshot().hedges, 1U);
+    FinnUtils::LiveStats::disable();
+    FinnUtils::LiveStats::reset();
+}
+
+TEST_F(HedgedExecutorTest, BudgetTest) {
+    // Without budget, slow requests are never duplicated
+    Executor executor(config, Finn::HedgeOptions{.budget = 0.0, .minSamples = 16, .minDelay = std::chrono::microseconds(500)});
+    warmUp(executor, 32);
+    const auto before = executor.getStatistics();
+    executor.testSetDelay(0, std::chrono::milliseconds(20));
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(executor.submit(0, Finn::vector<Executor::InputType>(executor.inputSize())).get().size(), 10U);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    auto stats = executor.getStatistics();
+    EXPECT_EQ(stats.hedges, 0U);
+    EXPECT_EQ(stats.budgetDenied, before.budgetDenied + 1);
+    EXPECT_EQ(executor.getLaunches(1), 16U);
+
+    // Requests that are not latency critical are never duplicated either
+    Executor generous(config, Finn::HedgeOptions{.budget = 1.0, .minSamples = 16, .minDelay = std::chrono::microseconds(500)});
+    warmUp(generous, 32);
+    const auto generousBefore = generous.getStatistics();
+    generous.testSetDelay(0, std::chrono::milliseconds(20));
+    EXPECT_EQ(generous.submit(0, Finn::vector<Executor::InputType>(generous.inputSize()), false).get().size(), 10U);
+    EXPECT_EQ(generous.getStatistics().hedges, generousBefore.hedges);
+    EXPECT_EQ(generous.getStatistics().budgetDenied, generousBefore.budgetDenied);
+}
+
+TEST_F(HedgedExecutorTest, FastDevicesTest) {
+    constexpr std::size_t requests = 400;
+    Executor executor(config, Finn::HedgeOptions{.budget = 0.05, .minSamples = 16});
+    for (std::size_t i = 0; i < requests; ++i) {
+        EXPECT_EQ(executor.submit(Finn::vector<Executor::InputType>(executor.inputSize())).get().size(), 10U);
+    }
+    // Noise may trigger duplicates, but never more than the budget allows
+    auto stats = executor.getStatistics();
+    EXPECT_EQ(stats.requests, requests);
+    EXPECT_EQ(stats.critical, requests);
+    EXPECT_LE(static_cast<double>(stats.hedges), 0.05 * requests);
+    EXPECT_GE(executor.getLaunches(0) + executor.getLaunches(1), requests);
+    EXPECT_LE(executor.getLaunches(0) + executor.getLaunches(1), requests + stats.hedges);
+}
+
+TEST_F(HedgedExecutorTest, ErrorTest) {
+    EXPECT_THROW(Executor(config, Finn::HedgeOptions{.percentile = 1.5}), std::invalid_argument);
+    EXPECT_THROW(Executor(config, Finn::HedgeOptions{.budget = -0.1}), std::invalid_argument);
+    EXPECT_THROW(Executor(config, Finn::HedgeOptions{.window = 0}), std::invalid_argument);
+    Finn::Config other = config;
+    other.deviceWrappers[1].idmas[0] = std::make_shared<Finn::ExtendedBufferDescriptor>(*std::dynamic_pointer_cast<Finn::ExtendedBufferDescriptor>(other.deviceWrappers[1].idmas[0]));
+    other.deviceWrappers[1].idmas[0]->packedShape.back() += 1;
+    EXPECT_THROW(Executor(other, Finn::HedgeOptions{}), std::invalid_argument);
+
+    Executor executor(config, Finn::HedgeOptions{.minSamples = 1});
+    EXPECT_THROW(executor.submit(2, Finn::vector<Executor::InputType>(executor.inputSize())), std::out_of_range);
+    auto failed = executor.submit(Finn::vector<Executor::InputType>(executor.inputSize() - 1));
+    EXPECT_THROW(failed.get(), std::invalid_argument);
+    EXPECT_EQ(executor.submit(Finn::vector<Executor::InputType>(executor.inputSize())).get().size(), 10U);
+}
+
+TEST_F(HedgedExecutorTest, DestructionTest) {
+    std::vector<std::future<Finn::vector<Executor::OutputType>>> results;
+    {
+        Executor executor(config, Finn::HedgeOptions{.enabled = false});
+        executor.testSetDelay(0, std::chrono::milliseconds(200));
+        for (std::size_t i = 0; i < 4; ++i) {
+            results.emplace_back(executor.submit(0, Finn::vector<Executor::InputType>(executor.inputSize())));
+        }
+        // Wait until the first request is served, the others stay queued
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (executor.getLaunches(0) == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_EQ(executor.getLaunches(0), 1U);
+    }
+    // The request in flight is answered, the queued ones are not served anymore
+    EXPECT_EQ(results[0].get().size(), 10U);
+    for (std::size_t i = 1; i < results.size(); ++i) {
+        EXPECT_THROW(results[i].get(), std::runtime_error);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+/**
+ * @file MPMCQueueTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the lock-free MPMC submission queue
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+
+#include <FINNCppDriver/core/DeviceBuffer/AsyncDeviceBuffers.hpp>
+#include <FINNCppDriver/utils/MPMCQueue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "UnittestConfig.h"
+#include "gtest/gtest.h"
+#include "xrt/xrt_device.h"
+
+using Queue = Finn::MPMCQueue<int>;
+const std::size_t elementsPerPart = 5;
+
+TEST(MPMCQueueTest, InitTest) {
+    Queue queue(FinnUnittest::parts, elementsPerPart);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.full());
+    EXPECT_EQ(queue.size(SIZE_SPECIFIER::BATCHSIZE), FinnUnittest::parts);
+    EXPECT_EQ(queue.size(SIZE_SPECIFIER::FEATUREMAP_SIZE), elementsPerPart);
+    EXPECT_EQ(queue.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE), FinnUnittest::parts * elementsPerPart);
+    EXPECT_EQ(queue.size(SIZE_SPECIFIER::BYTES), FinnUnittest::parts * elementsPerPart * sizeof(int));
+    EXPECT_THROW(Queue(0, elementsPerPart), std::runtime_error);
+}
+
+TEST(MPMCQueueTest, FifoFullEmptyTest) {
+    Queue queue(8, elementsPerPart);
+    std::vector<int> part(elementsPerPart);
+    for (int i = 0; i < 8; ++i) {
+        std::fill(part.begin(), part.end(), i);
+        EXPECT_TRUE(queue.tryStorePart(part.begin()));
+    }
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.tryStorePart(part.begin()));
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.tryReadPart(part.begin()));
+        EXPECT_TRUE(std::all_of(part.begin(), part.end(), [i](int val) { return val == i; }));
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.tryReadPart(part.begin()));
+
+    // Multi part stores are split into parts
+    std::vector<int> parts(3 * elementsPerPart);
+    std::iota(parts.begin(), parts.end(), 0);
+    EXPECT_TRUE(queue.store(parts.begin(), parts.end()));
+    EXPECT_EQ(queue.size(), 3U);
+    std::vector<int> out(3 * elementsPerPart);
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_TRUE(queue.read(out.begin() + static_cast<long>(i * elementsPerPart)));
+    }
+    EXPECT_EQ(out, parts);
+    EXPECT_THROW(queue.store(parts.begin(), parts.begin() + 3), std::runtime_error);
+}
+
+TEST(MPMCQueueTest, CapacityTest) {
+    // The capacity is not rounded to a power of two
+    Queue queue(5, elementsPerPart);
+    EXPECT_EQ(queue.size(SIZE_SPECIFIER::BATCHSIZE), 5U);
+    std::vector<int> part(elementsPerPart);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            std::fill(part.begin(), part.end(), round * 5 + i);
+            EXPECT_TRUE(queue.tryStorePart(part.begin()));
+        }
+        EXPECT_TRUE(queue.full());
+        EXPECT_FALSE(queue.tryStorePart(part.begin()));
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_TRUE(queue.tryReadPart(part.begin()));
+            EXPECT_TRUE(std::all_of(part.begin(), part.end(), [round, i](int val) { return val == round * 5 + i; }));
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(MPMCQueueTest, MultiProducerMultiConsumerTest) {
+    constexpr int producers = 8;
+    constexpr int consumers = 3;
+    constexpr int partsPerProducer = 2000;
+    // Small queue, so that producers block regularly
+    Queue queue(4, elementsPerPart);
+    std::vector<std::atomic<int>> received(producers * partsPerProducer);
+    std::atomic<int> receivedTotal{0};
+
+    {
+        std::vector<std::jthread> consumerThreads;
+        for (int c = 0; c < consumers; ++c) {
+            consumerThreads.emplace_back([&](std::stop_token stoken) {
+                std::vector<int> part(elementsPerPart);
+                while (queue.read(part.begin(), stoken)) {
+                    // Every part has to arrive unchanged
+                    EXPECT_TRUE(std::all_of(part.begin(), part.end(), [&part](int val) { return val == part[0]; }));
+                    received[static_cast<std::size_t>(part[0])].fetch_add(1);
+                    receivedTotal.fetch_add(1);
+                }
+            });
+        }
+        std::vector<std::jthread> producerThreads;
+        for (int p = 0; p < producers; ++p) {
+            producerThreads.emplace_back([&queue, p]() {
+                std::vector<int> part(elementsPerPart);
+                for (int i = 0; i < partsPerProducer; ++i) {
+                    std::fill(part.begin(), part.end(), p * partsPerProducer + i);
+                    queue.store(part.begin(), part.end());
+                }
+            });
+        }
+        producerThreads.clear();
+        while (receivedTotal.load() != producers * partsPerProducer) {
+            std::this_thread::yield();
+        }
+        // Consumers are blocked in read and have to be woken by the stop request
+    }
+    EXPECT_TRUE(std::all_of(received.begin(), received.end(), [](const std::atomic<int>& val) { return val.load() == 1; }));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPMCQueueTest, AsyncInputBufferTest) {
+    xrt::device device;
+    xrt::uuid uuid;
+    Finn::AsyncDeviceInputBuffer<uint8_t> buffer("InputBuffer", device, uuid, FinnUnittest::myShapePacked, FinnUnittest::parts, SUBMISSION_QUEUE::MPMC);
+    EXPECT_EQ(buffer.size(SIZE_SPECIFIER::BATCHSIZE), FinnUnittest::parts);
+    Finn::vector<uint8_t> data(buffer.size(SIZE_SPECIFIER::FEATUREMAP_SIZE));
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+    EXPECT_TRUE(buffer.store({data.begin(), data.end()}));
+    // The worker thread moves the part into the map
+    for (int i = 0; i < 1000 && buffer.testGetMap() != data; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(buffer.testGetMap(), data);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file ModelRegistryTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for hosting several models in one process
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+
+#include <FINNCppDriver/core/ModelRegistry.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "UnittestConfig.h"
+#include "gtest/gtest.h"
+#include "xrt/xrt_device.h"
+
+using namespace FinnUnittest;
+
+using ClassifierIn = Finn::DatatypeInt<2>;
+using ClassifierOut = Finn::DatatypeBinary;
+using RegressorIn = Finn::DatatypeUInt<2>;
+using RegressorOut = Finn::DatatypeUInt<8>;
+
+class ModelRegistryTest : public ::testing::Test {
+     protected:
+    std::string fn = "finn-accel.xclbin";
+    void SetUp() override {
+        std::fstream tmpfile(fn, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+    }
+
+    void TearDown() override { std::filesystem::remove(fn); }
+};
+
+TEST_F(ModelRegistryTest, RegistrationTest) {
+    Finn::ModelRegistry registry;
+    EXPECT_EQ((registry.registerModel<ClassifierIn, ClassifierOut>("classifier", unittestConfig, 1)), 0U);
+    EXPECT_EQ((registry.registerModel<RegressorIn, RegressorOut>("regressor", unittestConfig, 1)), 0U);
+    EXPECT_EQ((registry.registerModel<RegressorIn, RegressorOut>("regressor", unittestConfig, 1)), 1U);
+    // Replicas have to share the datatypes of the model
+    EXPECT_THROW((registry.registerModel<ClassifierIn, ClassifierOut>("regressor", unittestConfig, 1)), std::invalid_argument);
+
+    EXPECT_TRUE(registry.contains("classifier"));
+    EXPECT_EQ(registry.replicas("classifier"), 1U);
+    EXPECT_EQ(registry.replicas("regressor"), 2U);
+    auto names = registry.modelNames();
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, (std::vector<std::string>{"classifier", "regressor"}));
+
+    EXPECT_TRUE(registry.unregisterModel("classifier"));
+    EXPECT_FALSE(registry.unregisterModel("classifier"));
+    EXPECT_THROW(registry.replicas("classifier"), std::invalid_argument);
+}
+
+TEST_F(ModelRegistryTest, RoutingTest) {
+    Finn::ModelRegistry registry;
+    registry.registerModel<ClassifierIn, ClassifierOut>("classifier", unittestConfig, 1);
+    registry.registerModel<RegressorIn, RegressorOut>("regressor", unittestConfig, 1);
+
+    Finn::vector<int8_t> data(300, 1);
+    auto classes = registry.infer<ClassifierIn, ClassifierOut>("classifier", data.begin(), data.end());
+    EXPECT_EQ(classes.size(), 10U);
+    Finn::vector<uint8_t> unsignedData(300, 3);
+    auto values = registry.infer<RegressorIn, RegressorOut>("regressor", unsignedData.begin(), unsignedData.end());
+    EXPECT_EQ(values.size(), 10U);
+
+    // Typed requests have to use the datatypes of the model
+    EXPECT_THROW((registry.infer<RegressorIn, RegressorOut>("classifier", unsignedData.begin(), unsignedData.end())), std::invalid_argument);
+    EXPECT_THROW((registry.infer<ClassifierIn, ClassifierOut>("unknown", data.begin(), data.end())), std::invalid_argument);
+
+    Finn::vector<uint8_t> packed(registry.size("classifier", SIZE_SPECIFIER::TOTAL_DATA_SIZE), 0x55);
+    auto raw = registry.inferRaw("classifier", packed);
+    EXPECT_EQ(raw.size(), registry.size("classifier", SIZE_SPECIFIER::TOTAL_DATA_SIZE, false));
+
+    EXPECT_EQ(registry.getStatistics("classifier").requests, 2U);
+    EXPECT_EQ(registry.getStatistics("regressor").requests, 1U);
+}
+
+TEST_F(ModelRegistryTest, LoadBalancingTest) {
+    Finn::ModelRegistry registry;
+    constexpr std::size_t replicaCount = 3;
+    for (std::size_t i = 0; i < replicaCount; ++i) {
+        registry.registerModel<ClassifierIn, ClassifierOut>("classifier", unittestConfig, 1);
+    }
+
+    // Sequential requests find all replicas idle and are distributed round robin
+    Finn::vector<uint8_t> packed(registry.size("classifier", SIZE_SPECIFIER::TOTAL_DATA_SIZE), 0x55);
+    for (std::size_t i = 0; i < 3 * replicaCount; ++i) {
+        auto raw = registry.inferRaw("classifier", packed);
+    }
+    auto stats = registry.getStatistics("classifier");
+    EXPECT_EQ(stats.replicaRequests, std::vector<std::size_t>(replicaCount, 3));
+
+    // Concurrent requests from several threads
+    {
+        std::vector<std::jthread> clients;
+        for (int t = 0; t < 4; ++t) {
+            clients.emplace_back([&registry]() {
+                Finn::vector<int8_t> data(300, 1);
+                for (int i = 0; i < 20; ++i) {
+                    auto classes = registry.infer<ClassifierIn, ClassifierOut>("classifier", data.begin(), data.end());
+                    EXPECT_EQ(classes.size(), 10U);
+                }
+            });
+        }
+    }
+    stats = registry.getStatistics("classifier");
+    EXPECT_EQ(stats.requests, 3 * replicaCount + 80);
+    EXPECT_EQ(stats.inFlight, 0U);
+    EXPECT_TRUE(std::all_of(stats.replicaRequests.begin(), stats.replicaRequests.end(), [](std::size_t requests) { return requests > 3; }));
+    registry.logStatistics();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,196 @@
+/**
+ * @file SamplingVerifierTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the sampling golden reference verifier
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/config/FinnDriverUsedDatatypes.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+
+#include <FINNCppDriver/core/BaseDriver.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <FINNCppDriver/utils/SamplingVerifier.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#include "UnittestConfig.h"
+#include "gtest/gtest.h"
+#include "xrt/xrt_device.h"
+
+using namespace FinnUnittest;
+
+namespace {
+    /**
+     * @brief Options for tests. The full CPU budget avoids idle times between verifications.
+     *
+     */
+    Finn::VerifierOptions testOptions(std::size_t sampleEvery, std::size_t queueDepth = 4) { return {.sampleEvery = sampleEvery, .cpuBudget = 1.0, .queueDepth = queueDepth, .lowPriority = true}; }
+
+    /**
+     * @brief Wait until the verifier compared the expected number of samples
+     *
+     */
+    bool waitForVerified(const Finn::SamplingVerifier& verifier, std::size_t verified) {
+        for (int i = 0; i < 2000 && verifier.getStatistics().verified < verified; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return verifier.getStatistics().verified == verified;
+    }
+}  // namespace
+
+TEST(SamplingVerifierTest, InvalidOptionsTest) {
+    EXPECT_THROW(Finn::SamplingVerifier(nullptr), std::invalid_argument);
+    EXPECT_THROW(Finn::SamplingVerifier(Finn::SamplingVerifier::identityReference(), testOptions(0)), std::invalid_argument);
+    EXPECT_THROW(Finn::SamplingVerifier(Finn::SamplingVerifier::identityReference(), testOptions(1, 0)), std::invalid_argument);
+    EXPECT_THROW(Finn::SamplingVerifier(Finn::SamplingVerifier::identityReference(), {.cpuBudget = 0.0}), std::invalid_argument);
+}
+
+TEST(SamplingVerifierTest, SamplingRateTest) {
+    Finn::SamplingVerifier verifier(Finn::SamplingVerifier::identityReference(), testOptions(10));
+    std::size_t sampled = 0;
+    for (int i = 0; i < 1000; ++i) {
+        sampled += verifier.sample() ? 1 : 0;
+    }
+    EXPECT_EQ(sampled, 100U);
+    EXPECT_EQ(verifier.getStatistics().batches, 1000U);
+}
+
+TEST(SamplingVerifierTest, IdentityReferenceTest) {
+    Finn::SamplingVerifier verifier(Finn::SamplingVerifier::identityReference(), testOptions(1));
+    Finn::vector<uint8_t> data(256);
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+
+    EXPECT_TRUE(verifier.capture(data, data));
+    ASSERT_TRUE(waitForVerified(verifier, 1));
+    EXPECT_EQ(verifier.getStatistics().mismatches, 0U);
+
+    // A single flipped bit has to be detected
+    Finn::vector<uint8_t> corrupted = data;
+    corrupted[17] ^= 0x08;
+    EXPECT_TRUE(verifier.capture(data, corrupted));
+    ASSERT_TRUE(waitForVerified(verifier, 2));
+    EXPECT_EQ(verifier.getStatistics().mismatches, 1U);
+
+    // Output of the wrong size
+    EXPECT_TRUE(verifier.capture(data, std::span<const uint8_t>(data.data(), data.size() - 1)));
+    ASSERT_TRUE(waitForVerified(verifier, 3));
+    EXPECT_EQ(verifier.getStatistics().mismatches, 2U);
+}
+
+TEST(SamplingVerifierTest, SoftwareModelTest) {
+    using Type = Finn::DatatypeUInt<4>;
+    constexpr std::size_t rowElements = 6;
+    constexpr std::size_t rows = 16;
+    // Software model of a network that increments every element modulo 16
+    auto model = [](const Finn::vector<uint8_t>& in) {
+        Finn::vector<uint8_t> out(in.size());
+        std::transform(in.begin(), in.end(), out.begin(), [](uint8_t val) { return static_cast<uint8_t>((val + 1) % 16); });
+        return out;
+    };
+    Finn::SamplingVerifier verifier(Finn::SamplingVerifier::softwareModel<Type, Type>(model, rowElements, rowElements), testOptions(1));
+
+    Finn::vector<uint8_t> input(rows * rowElements);
+    FinnUtils::BufferFiller(0, 15).fillRandom(input.begin(), input.end());
+    Finn::vector<uint8_t> expected = model(input);
+    const Finn::DynamicMdSpan reshapedInput(input.begin(), input.end(), {rows, rowElements});
+    auto packedInput = Finn::packMultiDimensionalInputs<Type>(input.begin(), input.end(), reshapedInput, rowElements);
+    const Finn::DynamicMdSpan reshapedExpected(expected.begin(), expected.end(), {rows, rowElements});
+    auto packedExpected = Finn::packMultiDimensionalInputs<Type>(expected.begin(), expected.end(), reshapedExpected, rowElements);
+
+    EXPECT_TRUE(verifier.capture(packedInput, packedExpected));
+    EXPECT_TRUE(verifier.capture(packedInput, packedInput));
+    ASSERT_TRUE(waitForVerified(verifier, 2));
+    EXPECT_EQ(verifier.getStatistics().mismatches, 1U);
+}
+
+TEST(SamplingVerifierTest, DropWhenBehindTest) {
+    std::atomic<bool> release{false};
+    // Reference that blocks until released, so that the queue fills up
+    auto blocking = [&release](std::span<const uint8_t> input) {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return Finn::vector<uint8_t>(input.begin(), input.end());
+    };
+    Finn::SamplingVerifier verifier(blocking, testOptions(1, 2));
+    Finn::vector<uint8_t> data(64, 3);
+    std::size_t accepted = 0;
+    for (int i = 0; i < 10; ++i) {
+        accepted += verifier.capture(data, data) ? 1 : 0;
+    }
+    // At most the two slots can be in use, no matter whether the worker already took one
+    EXPECT_EQ(accepted, 2U);
+    EXPECT_EQ(verifier.getStatistics().dropped, 8U);
+    release = true;
+    ASSERT_TRUE(waitForVerified(verifier, 2));
+    EXPECT_EQ(verifier.getStatistics().mismatches, 0U);
+    // Slots are reused after verification
+    EXPECT_TRUE(verifier.capture(data, data));
+    ASSERT_TRUE(waitForVerified(verifier, 3));
+}
+
+class SamplingVerifierDriverTest : public ::testing::Test {
+     protected:
+    std::string fn = "finn-accel.xclbin";
+    void SetUp() override {
+        std::fstream tmpfile(fn, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+    }
+
+    void TearDown() override { std::filesystem::remove(fn); }
+};
+
+class TestDriver : public Finn::Driver<true> {
+     public:
+    TestDriver(const Finn::Config& pConfig, unsigned int hostBufferSize) : Finn::Driver<true>(pConfig, hostBufferSize) {}
+    Finn::vector<uint8_t> inferR(const Finn::vector<uint8_t>& data) { return infer(data, 0, inputDmaName, 0, outputDmaName, hostBufferSize, true); }
+};
+
+TEST_F(SamplingVerifierDriverTest, DriverIntegrationTest) {
+    auto driver = TestDriver(unittestConfig, hostBufferSize);
+    Finn::vector<uint8_t> data(driver.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE, 0, inputDmaName));
+    FinnUtils::BufferFiller(0, 255).fillRandom(data.begin(), data.end());
+    Finn::vector<uint8_t> output(driver.size(SIZE_SPECIFIER::TOTAL_DATA_SIZE, 0, outputDmaName));
+    FinnUtils::BufferFiller(0, 255).fillRandom(output.begin(), output.end());
+    driver.getDeviceHandler(0).getOutputBuffer(outputDmaName)->testSetMap(output);
+
+    // Known answer: The mock returns the output map for every input
+    auto verifier = std::make_shared<Finn::SamplingVerifier>([&output](std::span<const uint8_t>) { return output; }, testOptions(4));
+    driver.setVerifier(verifier);
+    EXPECT_EQ(driver.getVerifier(), verifier);
+
+    for (int i = 0; i < 8; ++i) {
+        auto result = driver.inferR(data);
+        EXPECT_EQ(result, output);
+    }
+    ASSERT_TRUE(waitForVerified(*verifier, 2));
+    EXPECT_EQ(verifier->getStatistics().batches, 8U);
+    EXPECT_EQ(verifier->getStatistics().mismatches, 0U);
+
+    // The identity reference does not match the mock output
+    driver.setVerifier(std::make_shared<Finn::SamplingVerifier>(Finn::SamplingVerifier::identityReference(), testOptions(1)));
+    auto result = driver.inferR(data);
+    ASSERT_TRUE(waitForVerified(*driver.getVerifier(), 1));
+    EXPECT_EQ(driver.getVerifier()->getStatistics().mismatches, 1U);
+
+    driver.setVerifier(nullptr);
+    result = driver.inferR(data);
+    EXPECT_EQ(result, output);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,174 @@
+/**
+ * @file ShardedExecutorTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the thread per core sharded execution
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/AllocationCounter.h>
+#include <FINNCppDriver/utils/AllocationHooks.h>
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <sched.h>
+
+#include <FINNCppDriver/core/ShardedExecutor.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "UnittestConfig.h"
+#include "gtest/gtest.h"
+#include "xrt/xrt_device.h"
+
+using namespace FinnUnittest;
+
+using InputFinnType = Finn::DatatypeInt<2>;
+using OutputFinnType = Finn::DatatypeBinary;
+using Executor = Finn::ShardedExecutor<InputFinnType, OutputFinnType>;
+
+class ShardedExecutorTest : public ::testing::Test {
+     protected:
+    std::string fn = "finn-accel.xclbin";
+    void SetUp() override {
+        std::fstream tmpfile(fn, std::fstream::out);
+        tmpfile << "some stuff\n";
+        tmpfile.close();
+    }
+
+    void TearDown() override { std::filesystem::remove(fn); }
+};
+
+TEST_F(ShardedExecutorTest, PrivateBufferTest) {
+    Executor executor(unittestConfig, Finn::ShardOptions{.shards = 2});
+    ASSERT_EQ(executor.shards(), 2U);
+
+    Finn::vector<Executor::InputType> input(executor.inputSize());
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<int> sampler(-2, 1);
+    std::generate(input.begin(), input.end(), [&]() { return static_cast<Executor::InputType>(sampler(engine)); });
+    Finn::vector<uint8_t> output(executor.testGetOutputBuffer(1).size(SIZE_SPECIFIER::TOTAL_DATA_SIZE));
+    FinnUtils::BufferFiller(0, 255).fillRandom(output.begin(), output.end());
+    executor.testGetOutputBuffer(1).testSetMap(output);
+
+    auto result = executor.submit(1, input).get();
+
+    // Only the buffer objects of the selected shard were used
+    const Finn::DynamicMdSpan reshapedInput(input.begin(), input.end(), myShapeFolded);
+    auto packed = Finn::packMultiDimensionalInputs<InputFinnType>(input.begin(), input.end(), reshapedInput, myShapeFolded.back());
+    auto shardMap = executor.testGetInputBuffer(1).testGetMap();
+    EXPECT_TRUE(std::equal(packed.begin(), packed.end(), shardMap.begin()));
+    auto otherMap = executor.testGetInputBuffer(0).testGetMap();
+    EXPECT_TRUE(std::all_of(otherMap.begin(), otherMap.end(), [](uint8_t value) { return value == 0; }));
+
+    auto outputShapePacked = unittestConfig.deviceWrappers[0].odmas[0]->packedShape;
+    auto outputShapeFolded = std::dynamic_pointer_cast<Finn::ExtendedBufferDescriptor>(unittestConfig.deviceWrappers[0].odmas[0])->foldedShape;
+    const Finn::DynamicMdSpan reshapedOutput(output.begin(), output.end(), outputShapePacked);
+    auto expected = Finn::unpackMultiDimensionalOutputs<OutputFinnType, Finn::vector<uint8_t>::iterator, false, Executor::OutputType>(output.begin(), output.end(), reshapedOutput, outputShapeFolded);
+    EXPECT_EQ(result, expected);
+
+    EXPECT_EQ(executor.getStatistics(0).requests, 0U);
+    EXPECT_EQ(executor.getStatistics(1).requests, 1U);
+}
+
+TEST_F(ShardedExecutorTest, ConcurrentSubmitTest) {
+    constexpr std::size_t shardCount = 4;
+    constexpr std::size_t clients = 4;
+    constexpr std::size_t requestsPerClient = 25;
+    Executor executor(unittestConfig, Finn::ShardOptions{.shards = shardCount});
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < clients; ++t) {
+            threads.emplace_back([&executor]() {
+                std::vector<std::future<Finn::vector<Executor::OutputType>>> futures;
+                for (std::size_t i = 0; i < requestsPerClient; ++i) {
+                    futures.emplace_back(executor.submit(Finn::vector<Executor::InputType>(executor.inputSize(), 1)));
+                }
+                for (auto& future : futures) {
+                    EXPECT_EQ(future.get().size(), 10U);
+                }
+            });
+        }
+    }
+    // Round robin submission spreads the requests evenly
+    for (std::size_t shard = 0; shard < shardCount; ++shard) {
+        auto stats = executor.getStatistics(shard);
+        EXPECT_EQ(stats.requests, clients * requestsPerClient / shardCount);
+        EXPECT_EQ(stats.failures, 0U);
+    }
+}
+
+TEST_F(ShardedExecutorTest, ErrorTest) {
+    EXPECT_THROW(Executor(unittestConfig, Finn::ShardOptions{.shards = 0}), std::invalid_argument);
+
+    Executor executor(unittestConfig, Finn::ShardOptions{.shards = 1});
+    EXPECT_THROW(executor.submit(1, Finn::vector<Executor::InputType>(executor.inputSize())), std::out_of_range);
+
+    auto failed = executor.submit(Finn::vector<Executor::InputType>(executor.inputSize() - 1));
+    EXPECT_THROW(failed.get(), std::invalid_argument);
+    // The shard keeps serving requests after a failed one
+    EXPECT_EQ(executor.submit(Finn::vector<Executor::InputType>(executor.inputSize())).get().size(), 10U);
+    EXPECT_EQ(executor.getStatistics(0).requests, 2U);
+    EXPECT_EQ(executor.getStatistics(0).failures, 1U);
+}
+
+TEST_F(ShardedExecutorTest, AllocationFreeTest) {
+    using FinnUtils::AllocationCounter;
+    Executor executor(unittestConfig, Finn::ShardOptions{.shards = 2});
+    Finn::vector<Executor::InputType> input(executor.inputSize(), 1);
+    Finn::vector<Executor::OutputType> output;
+    executor.testProcess(1, input, output);
+    ASSERT_EQ(output.size(), 10U);
+
+    // Recycled output vectors are reused by submit
+    const auto* data = output.data();
+    auto recycled = executor.submit(1, input, std::move(output)).get();
+    EXPECT_EQ(recycled.data(), data);
+
+    // Debug builds log every launch of a buffer
+    boost::log::core::get()->set_logging_enabled(false);
+    AllocationCounter::reset();
+    AllocationCounter::enable();
+    for (int i = 0; i < 10; ++i) {
+        executor.testProcess(1, input, recycled);
+    }
+    AllocationCounter::disable();
+    boost::log::core::get()->set_logging_enabled(true);
+    // Counted over all threads, including the codec threads
+    EXPECT_EQ(AllocationCounter::total(AllocationCounter::globalStatistics()).allocations, 0U);
+    EXPECT_EQ(recycled.data(), data);
+}
+
+TEST_F(ShardedExecutorTest, PinningTest) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int core = 0;
+    while (!CPU_ISSET(core, &allowed)) {
+        ++core;
+    }
+
+    // Cores outside of the cpuset of the process cannot be used, the shard runs unpinned
+    Executor executor(unittestConfig, Finn::ShardOptions{.shards = 2, .cores = {core, CPU_SETSIZE - 1}});
+    EXPECT_EQ(executor.getStatistics(0).core, core);
+    EXPECT_EQ(executor.getStatistics(1).core, -1);
+    EXPECT_EQ(executor.submit(0, Finn::vector<Executor::InputType>(executor.inputSize())).get().size(), 10U);
+    EXPECT_EQ(executor.submit(1, Finn::vector<Executor::InputType>(executor.inputSize())).get().size(), 10U);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file CodecAutotunerTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the codec autotuner and its profile
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/CodecAutotuner.hpp>
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class CodecAutotunerTest : public ::testing::Test {
+     protected:
+    std::filesystem::path profilePath = std::filesystem::temp_directory_path() / "finn-codec-autotuner-test.json";
+    void SetUp() override { std::filesystem::remove(profilePath); }
+    void TearDown() override { std::filesystem::remove(profilePath); }
+};
+
+TEST_F(CodecAutotunerTest, ProfileCachingTest) {
+    using U = Finn::DatatypeInt<3>;
+    Finn::CodecTuning packTuning;
+    Finn::CodecTuning unpackTuning;
+    {
+        Finn::CodecAutotuner autotuner(profilePath, std::chrono::milliseconds(20));
+        packTuning = autotuner.tunePack<U>(16, 20000);
+        unpackTuning = autotuner.tuneUnpack<U>(16, 20000);
+        EXPECT_EQ(autotuner.getMeasuredOperations(), 2U);
+        // Already tuned operations are not measured again
+        EXPECT_EQ(autotuner.tunePack<U>(16, 20000), packTuning);
+        EXPECT_EQ(autotuner.getMeasuredOperations(), 2U);
+    }
+    ASSERT_TRUE(std::filesystem::exists(profilePath));
+
+    // A later start on the same host reuses the choices
+    Finn::CodecAutotuner reloaded(profilePath, std::chrono::milliseconds(20));
+    EXPECT_EQ(reloaded.tunePack<U>(16, 20000), packTuning);
+    EXPECT_EQ(reloaded.tuneUnpack<U>(16, 20000), unpackTuning);
+    EXPECT_EQ(reloaded.getMeasuredOperations(), 0U);
+    // Other shapes and datatypes are tuned separately
+    reloaded.tunePack<Finn::DatatypeUInt<7>>(16, 20000);
+    EXPECT_EQ(reloaded.getMeasuredOperations(), 1U);
+
+    // Another CPU model has its own section in the profile
+    Finn::CodecAutotuner otherHost(profilePath, std::chrono::milliseconds(1), "other cpu x1");
+    otherHost.tunePack<U>(16, 20000);
+    EXPECT_EQ(otherHost.getMeasuredOperations(), 1U);
+    EXPECT_TRUE(Finn::CodecProfile(profilePath).find(Finn::CodecAutotuner::operationKey<Finn::DatatypeUInt<7>>("pack", 16, 20000)).has_value());
+    EXPECT_TRUE(Finn::CodecProfile(profilePath, "other cpu x1").find(Finn::CodecAutotuner::operationKey<U>("pack", 16, 20000)).has_value());
+}
+
+TEST_F(CodecAutotunerTest, UnreadableProfileTest) {
+    {
+        std::ofstream file(profilePath);
+        file << "{ not json";
+    }
+    Finn::CodecAutotuner autotuner(profilePath, std::chrono::milliseconds(1));
+    autotuner.tunePack<Finn::DatatypeInt<2>>(1, 600);
+    EXPECT_EQ(autotuner.getMeasuredOperations(), 1U);
+    // The broken profile is replaced
+    EXPECT_TRUE(Finn::CodecProfile(profilePath).find(Finn::CodecAutotuner::operationKey<Finn::DatatypeInt<2>>("pack", 1, 600)).has_value());
+}
+
+TEST_F(CodecAutotunerTest, UnwritableProfileTest) {
+    {
+        std::ofstream file(profilePath);
+        file << "{}";
+    }
+    // The parent of the profile is a regular file, so the profile cannot be created
+    Finn::CodecAutotuner autotuner(profilePath / "profile.json", std::chrono::milliseconds(1));
+    EXPECT_NO_THROW(autotuner.tunePack<Finn::DatatypeInt<2>>(1, 600));
+    EXPECT_EQ(autotuner.getMeasuredOperations(), 1U);
+    EXPECT_FALSE(Finn::CodecProfile(profilePath / "profile.json").save());
+}
+
+TEST_F(CodecAutotunerTest, OperationKeyTest) {
+    EXPECT_EQ(Finn::CodecAutotuner::operationKey<Finn::DatatypeInt<2>>("pack", 1, 600), "pack INT2 1x600");
+    EXPECT_EQ(Finn::CodecAutotuner::operationKey<Finn::DatatypeUInt<5>>("unpack", 4, 10), "unpack UINT5 4x10");
+    EXPECT_EQ((Finn::CodecAutotuner::operationKey<Finn::DatatypeFixed<8, 4>>("pack", 1, 1)), "pack FIXED8 1x1");
+}
+
+TEST_F(CodecAutotunerTest, TuningDoesNotChangeResultsTest) {
+    using U = Finn::DatatypeInt<5>;
+    constexpr std::size_t rows = 3;
+    constexpr std::size_t rowElements = 70001;
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> sampler(-16, 15);
+    Finn::vector<int8_t> input(rows * rowElements);
+    std::generate(input.begin(), input.end(), [&]() { return static_cast<int8_t>(sampler(engine)); });
+    const Finn::DynamicMdSpan reshaped(input.begin(), input.end(), {rows, rowElements});
+    auto expected = Finn::packMultiDimensionalInputs<U>(input.begin(), input.end(), reshaped, rowElements);
+
+    for (const auto& tuning : {Finn::CodecTuning{1, 1}, Finn::CodecTuning{3, 1}, Finn::CodecTuning{8, 1024}, Finn::CodecTuning{0, 1UL << 20U}}) {
+        EXPECT_EQ(Finn::packMultiDimensionalInputs<U>(input.begin(), input.end(), reshaped, rowElements, tuning), expected);
+        const Finn::DynamicMdSpan reshapedPacked(expected.begin(), expected.end(), {rows, static_cast<unsigned int>(expected.size() / rows)});
+        EXPECT_EQ(Finn::unpackMultiDimensionalOutputs<U>(expected.begin(), expected.end(), reshapedPacked, {rows, rowElements}, tuning), input);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
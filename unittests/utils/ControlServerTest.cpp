@@ -0,0 +1,138 @@
+/**
+ * @file ControlServerTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the runtime tunables and their control socket
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <FINNCppDriver/utils/Logger.h>
+#include <FINNCppDriver/utils/Tunables.h>
+#include <FINNCppDriver/utils/Types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <FINNCppDriver/utils/ControlServer.hpp>
+#include <array>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class ControlServerTest : public ::testing::Test {
+     protected:
+    std::filesystem::path socketPath = std::filesystem::temp_directory_path() / "finn-control-test.sock";
+    void SetUp() override { FinnUtils::Tunables::reset(); }
+    void TearDown() override {
+        FinnUtils::Tunables::reset();
+        FinnUtils::Tunables::setLogLevel(loglevel::trace);
+        FinnUtils::LiveStats::disable();
+    }
+
+    /**
+     * @brief Send the commands over the socket and return everything the server replied until it closed the connection
+     *
+     */
+    std::string roundTrip(const std::string& commands) const {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        socketPath.string().copy(address.sun_path, sizeof(address.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            throw std::runtime_error("Could not connect to the control socket");
+        }
+        EXPECT_EQ(send(fd, commands.data(), commands.size(), MSG_NOSIGNAL), static_cast<ssize_t>(commands.size()));
+        shutdown(fd, SHUT_WR);
+        std::string reply;
+        std::array<char, 256> chunk{};
+        ssize_t received = 0;
+        while ((received = recv(fd, chunk.data(), chunk.size(), 0)) > 0) {
+            reply.append(chunk.data(), static_cast<std::size_t>(received));
+        }
+        close(fd);
+        return reply;
+    }
+};
+
+TEST_F(ControlServerTest, ExecuteTest) {
+    const auto generation = FinnUtils::Tunables::generation();
+    EXPECT_EQ(Finn::ControlServer::execute("set batch_size 16"), "ok");
+    EXPECT_EQ(FinnUtils::Tunables::batchSize(), 16U);
+    EXPECT_EQ(Finn::ControlServer::execute("set codec_threads 4"), "ok");
+    EXPECT_EQ(Finn::ControlServer::execute("set codec_min_elements 1024"), "ok");
+    EXPECT_EQ(FinnUtils::Tunables::codecThreads(), 4U);
+    EXPECT_EQ(FinnUtils::Tunables::codecMinElements(), 1024U);
+    EXPECT_EQ(FinnUtils::Tunables::generation(), generation + 3);
+
+    // Process wide tunables take effect without a new generation
+    EXPECT_EQ(Finn::ControlServer::execute("set wait_policy yield"), "ok");
+    EXPECT_EQ(FinnUtils::Tunables::waitPolicy(), WAIT_POLICY::YIELD);
+    EXPECT_EQ(Finn::ControlServer::execute("set log_level warning"), "ok");
+    EXPECT_EQ(FinnUtils::Tunables::logLevel(), loglevel::warning);
+    EXPECT_EQ(Finn::ControlServer::execute("set stats on"), "ok");
+    EXPECT_TRUE(FinnUtils::LiveStats::isEnabled());
+    EXPECT_EQ(FinnUtils::Tunables::generation(), generation + 3);
+
+    const auto state = Finn::ControlServer::execute("get");
+    for (const auto* line : {"batch_size 16\n", "codec_threads 4\n", "codec_min_elements 1024\n", "wait_policy yield\n", "log_level warning\n", "stats on"}) {
+        EXPECT_NE(state.find(line), std::string::npos) << line;
+    }
+}
+
+TEST_F(ControlServerTest, InvalidCommandTest) {
+    for (const auto* command : {"", "frobnicate", "get batch_size", "set batch_size", "set batch_size 0", "set batch_size -1", "set batch_size 12abc", "set batch_size 99999999999", "set codec_threads 1 2",
+                                "set wait_policy sleep", "set log_level loud", "set stats maybe", "set ring_size 4"}) {
+        EXPECT_TRUE(Finn::ControlServer::execute(command).starts_with("error:")) << command;
+    }
+    // Nothing was changed by the rejected commands
+    EXPECT_EQ(FinnUtils::Tunables::batchSize(), 0U);
+    EXPECT_EQ(FinnUtils::Tunables::codecThreads(), 0U);
+    EXPECT_EQ(FinnUtils::Tunables::waitPolicy(), WAIT_POLICY::SPIN);
+}
+
+TEST_F(ControlServerTest, ParseLogLevelTest) {
+    EXPECT_EQ(Finn::ControlServer::parseLogLevel("trace"), loglevel::trace);
+    EXPECT_EQ(Finn::ControlServer::parseLogLevel("warning"), loglevel::warning);
+    EXPECT_EQ(Finn::ControlServer::parseLogLevel("fatal"), loglevel::fatal);
+    EXPECT_FALSE(Finn::ControlServer::parseLogLevel("Warning"));
+    EXPECT_FALSE(Finn::ControlServer::parseLogLevel(""));
+}
+
+TEST_F(ControlServerTest, SocketTest) {
+    {
+        Finn::ControlServer server(socketPath);
+        EXPECT_TRUE(std::filesystem::is_socket(socketPath));
+        EXPECT_EQ(roundTrip("set batch_size 8\r\nset wait_policy nope\nset wait_policy yield\n"), "ok\nerror: wait_policy has to be spin or yield\nok\n");
+        EXPECT_EQ(FinnUtils::Tunables::batchSize(), 8U);
+        EXPECT_EQ(FinnUtils::Tunables::waitPolicy(), WAIT_POLICY::YIELD);
+        // The next client is served after the first one disconnected
+        EXPECT_NE(roundTrip("get\n").find("batch_size 8\n"), std::string::npos);
+    }
+    // The socket is removed with the server
+    EXPECT_FALSE(std::filesystem::exists(socketPath));
+
+    // A stale socket of a crashed run is replaced
+    const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.string().copy(address.sun_path, sizeof(address.sun_path) - 1);
+    ASSERT_EQ(bind(stale, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    close(stale);
+    ASSERT_TRUE(std::filesystem::is_socket(socketPath));
+    Finn::ControlServer server(socketPath);
+    EXPECT_EQ(roundTrip("help\n").substr(0, 4), "get ");
+    EXPECT_THROW(Finn::ControlServer(std::string(200, 'x')), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
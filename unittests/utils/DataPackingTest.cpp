@@ -21,6 +21,7 @@
 #include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <random>
 
 #include "gtest/gtest.h"
 
@@ -436,6 +437,44 @@ TEST(DataPacking, FloatingPointInputTest) {
     EXPECT_TRUE(mat23.size() == ret.size() && std::equal(ret.begin(), ret.end(), mat23.begin()));
 }
 
+template<typename U, typename Input, typename Expected>
+void expectPackInto(const Input& input, const Expected& expected) {
+    // The destination is poisoned, packInto has to write every byte
+    Finn::vector<uint8_t> destination(expected.size(), 0xAB);
+    EXPECT_EQ(Finn::packInto<U>(input.begin(), input.end(), destination), expected.size());
+    EXPECT_TRUE(std::equal(destination.begin(), destination.end(), expected.begin()));
+}
+
+TEST(DataPacking, PackIntoTest) {
+    // Same results as pack, but from const inputs
+    expectPackInto<Finn::DatatypeInt<32>>(inputMat, mat1);
+    expectPackInto<Finn::DatatypeInt<24>>(inputMat, mat2);
+    expectPackInto<Finn::DatatypeInt<16>>(inputMat, mat3);
+    expectPackInto<Finn::DatatypeInt<10>>(inputMat, mat4);
+    expectPackInto<Finn::DatatypeUInt<9>>(inputMat, mat5);
+    expectPackInto<Finn::DatatypeFloat>(inputMat, mat6);
+    expectPackInto<Finn::DatatypeFixed<12, 10>>(inputMat, mat7);
+    expectPackInto<Finn::DatatypeFixed<11, 10>>(inputMat, mat8);
+    expectPackInto<Finn::DatatypeFixed<16, 10>>(inputMat, mat9);
+    expectPackInto<Finn::DatatypeInt<10>>(inputMat1, mat10);
+    expectPackInto<Finn::DatatypeInt<8>>(inputMat1, mat11);
+    expectPackInto<Finn::DatatypeBinary>(inputMat1, mat12);
+    expectPackInto<Finn::DatatypeInt<8>>(inputMat2, mat13);
+    expectPackInto<Finn::DatatypeBipolar>(inputMat2, mat14);
+    expectPackInto<Finn::DatatypeTernary>(inputMat3, mat15);
+    expectPackInto<Finn::DatatypeUInt<8>>(inputMat4, mat16);
+    expectPackInto<Finn::DatatypeInt<8>>(inputMat4, mat17);
+    expectPackInto<Finn::DatatypeUInt<8>>(inputMat5, mat18);
+    expectPackInto<Finn::DatatypeInt<8>>(inputMat5, mat19);
+    expectPackInto<Finn::DatatypeUInt<8>>(inputMat6, mat20);
+    expectPackInto<Finn::DatatypeInt<9>>(inputMat6, mat21);
+    expectPackInto<Finn::DatatypeFloat>(inputMat7, mat22);
+    expectPackInto<Finn::DatatypeFixed<16, 10>>(inputMat7, mat23);
+
+    Finn::vector<uint8_t> tooSmall(mat4.size() - 1);
+    EXPECT_THROW(Finn::packInto<Finn::DatatypeInt<10>>(inputMat.begin(), inputMat.end(), tooSmall), std::length_error);
+}
+
 TEST(DataPacking, IntegralToBitsetTest) {
     Finn::vector<uint8_t> inp = {0, 1, 2, 3, 4, 5, 6, 7};
     auto ret = Finn::toBitset<Finn::DatatypeUInt<3>, true, false>(inp);
@@ -653,6 +692,69 @@ TEST(DataPacking, UnpackingMultiDimensionalInputs) {
     EXPECT_EQ(unpackedMerged, expectedResult2);
 }
 
+TEST(DataPacking, CodecSharding) {
+    // A single huge row is split into byte aligned shards
+    auto sharding = Finn::CodecSharding::create<Finn::DatatypeInt<3>>(1, 1000003, 8);
+    EXPECT_EQ(sharding.threads, 8U);
+    EXPECT_GE(sharding.tasks(), 8U);
+    EXPECT_EQ(sharding.shardElements % 8, 0U);  // lcm(3, 8) = 24 bits = 8 elements
+    std::size_t elements = 0;
+    for (std::size_t task = 0; task < sharding.tasks(); ++task) {
+        EXPECT_GT(sharding.elements(task), 0U);
+        elements += sharding.elements(task);
+    }
+    EXPECT_EQ(elements, 1000003U);
+    EXPECT_EQ(sharding.byteOffset(sharding.tasks()), FinnUtils::fastDivCeil(1000003UL * 3, 8UL));
+
+    // Many rows are not split, small inputs stay single threaded
+    auto rows = Finn::CodecSharding::create<Finn::DatatypeInt<3>>(1000, 1000, 8);
+    EXPECT_EQ(rows.shardsPerRow, 1U);
+    EXPECT_EQ(rows.tasks(), 1000U);
+    EXPECT_EQ(Finn::CodecSharding::create<Finn::DatatypeInt<3>>(1, 600, 8).threads, 1U);
+}
+
+TEST(DataPacking, ShardedMultiDimensionalCodecs) {
+    using U = Finn::DatatypeInt<3>;
+    // Force several threads, so that rows are sharded independent of the cores of the test machine
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(8);
+    for (const std::size_t rows : {1UL, 3UL}) {
+        EXPECT_GT(Finn::CodecSharding::create<U>(rows, 300001).shardsPerRow, 1U);
+        constexpr std::size_t rowElements = 300001;
+        Finn::vector<int8_t> inp(rows * rowElements);
+        std::mt19937 engine{42};
+        std::uniform_int_distribution<int> dist{-4, 3};
+        std::generate(inp.begin(), inp.end(), [&]() { return static_cast<int8_t>(dist(engine)); });
+
+        // Reference: every row packed on its own
+        const std::size_t rowBytes = FinnUtils::fastDivCeil(rowElements * 3, 8UL);
+        Finn::vector<uint8_t> expected;
+        for (std::size_t row = 0; row < rows; ++row) {
+            Finn::vector<int8_t> rowCopy(inp.begin() + static_cast<long>(row * rowElements), inp.begin() + static_cast<long>((row + 1) * rowElements));
+            auto packedRow = Finn::pack<U>(rowCopy.begin(), rowCopy.end());
+            expected.insert(expected.end(), packedRow.begin(), packedRow.end());
+        }
+
+        Finn::vector<int8_t> inpCopy(inp);
+        Finn::DynamicMdSpan shape(inpCopy.begin(), inpCopy.end(), {rows, rowElements});
+        auto packed = Finn::packMultiDimensionalInputs<U>(inpCopy.begin(), inpCopy.end(), shape, rowElements);
+        EXPECT_EQ(packed, expected);
+
+        Finn::vector<int8_t> inpCopy2(inp);
+        Finn::DynamicMdSpan shape2(inpCopy2.begin(), inpCopy2.end(), {rows, rowElements});
+        for (const MAP_TYPE mapType : {MAP_TYPE::CACHED, MAP_TYPE::WRITE_COMBINED, MAP_TYPE::UNCACHED}) {
+            Finn::vector<uint8_t> destination(rows * rowBytes, 0xAB);
+            EXPECT_EQ(Finn::packMultiDimensionalInputs<U>(inpCopy2.begin(), inpCopy2.end(), shape2, rowElements, destination, mapType), rows * rowBytes);
+            EXPECT_EQ(destination, expected);
+        }
+
+        Finn::DynamicMdSpan packedShape(packed.begin(), packed.end(), {rows, rowBytes});
+        auto unpacked = Finn::unpackMultiDimensionalOutputs<U>(packed.begin(), packed.end(), packedShape, {rows, rowElements});
+        EXPECT_EQ(unpacked, inp);
+    }
+    omp_set_num_threads(maxThreads);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,158 @@
+/**
+ * @file PackedViewTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the compact result types of sub-byte datatypes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <FINNCppDriver/utils/FinnDatatypes.hpp>
+#include <FINNCppDriver/utils/PackedView.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+namespace {
+    /**
+     * @brief Compares the view of random packed rows with unpackMultiDimensionalOutputs
+     *
+     * @tparam U
+     * @param rows
+     * @param rowElements
+     */
+    template<typename U>
+    void checkAgainstUnpack(std::size_t rows, std::size_t rowElements) {
+        const std::size_t rowBytes = FinnUtils::fastDivCeil(rowElements * U().bitwidth(), 8UL);
+        Finn::vector<uint8_t> packed(rows * rowBytes);
+        FinnUtils::BufferFiller(0, 255).fillRandom(packed.begin(), packed.end());
+        // The FPGA never sets padding bits
+        const std::size_t tailBits = (rowElements * U().bitwidth()) % 8;
+        if (tailBits != 0) {
+            for (std::size_t row = 0; row < rows; ++row) {
+                packed[(row + 1) * rowBytes - 1] &= static_cast<uint8_t>((1U << tailBits) - 1U);
+            }
+        }
+
+        const shapePacked_t packedShape{static_cast<unsigned int>(rows), static_cast<unsigned int>(rowBytes)};
+        const shapeFolded_t foldedShape{static_cast<unsigned int>(rows), static_cast<unsigned int>(rowElements)};
+        const Finn::DynamicMdSpan reshaped(packed.begin(), packed.end(), packedShape);
+        auto expected = Finn::unpackMultiDimensionalOutputs<U>(packed.begin(), packed.end(), reshaped, foldedShape);
+
+        const Finn::PackedView<U> view(std::span<const uint8_t>(packed.data(), packed.size()), rowElements);
+        ASSERT_EQ(view.size(), expected.size());
+        EXPECT_EQ(view.rowCount(), rows);
+        EXPECT_TRUE(std::equal(view.begin(), view.end(), expected.begin()));
+        EXPECT_EQ(view.expand(), expected);
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            EXPECT_EQ(view[i], expected[i]) << "index " << i;
+        }
+        // Row views see the same elements
+        const auto lastRow = view.row(rows - 1);
+        EXPECT_TRUE(std::equal(lastRow.begin(), lastRow.end(), expected.begin() + static_cast<long>((rows - 1) * rowElements)));
+
+        const std::size_t expectedPopcount = std::accumulate(packed.begin(), packed.end(), 0UL, [](std::size_t sum, uint8_t byte) { return sum + static_cast<std::size_t>(std::popcount(byte)); });
+        EXPECT_EQ(view.popcount(), expectedPopcount);
+    }
+}  // namespace
+
+TEST(PackedViewTest, BinaryTest) {
+    checkAgainstUnpack<Finn::DatatypeBinary>(7, 64);
+    checkAgainstUnpack<Finn::DatatypeBinary>(7, 13);
+    checkAgainstUnpack<Finn::DatatypeBinary>(1, 1);
+}
+
+TEST(PackedViewTest, NibbleTest) {
+    checkAgainstUnpack<Finn::DatatypeUInt<4>>(5, 32);
+    checkAgainstUnpack<Finn::DatatypeUInt<4>>(5, 7);
+    checkAgainstUnpack<Finn::DatatypeInt<4>>(5, 7);
+}
+
+TEST(PackedViewTest, OddBitwidthTest) {
+    checkAgainstUnpack<Finn::DatatypeInt<3>>(4, 11);
+    checkAgainstUnpack<Finn::DatatypeUInt<5>>(4, 16);
+    checkAgainstUnpack<Finn::DatatypeInt<7>>(3, 9);
+    checkAgainstUnpack<Finn::DatatypeUInt<8>>(3, 9);
+}
+
+TEST(PackedViewTest, BitViewTest) {
+    Finn::vector<uint8_t> bits{0b10110001, 0b00000101};
+    const Finn::BitView<Finn::DatatypeBinary> view(std::span<const uint8_t>(bits.data(), bits.size()), 11);
+    EXPECT_EQ(view.size(), 11U);
+    EXPECT_TRUE(view.test(0));
+    EXPECT_FALSE(view.test(1));
+    EXPECT_TRUE(view.test(7));
+    EXPECT_TRUE(view.test(10));
+    EXPECT_EQ(view.popcount(), 6U);
+    EXPECT_EQ(std::count(view.begin(), view.end(), 1), 6);
+}
+
+TEST(PackedViewTest, BipolarTest) {
+    Finn::vector<int8_t> values{-1, 1, 1, -1, -1, -1, 1, 1, 1, -1};
+    Finn::vector<int8_t> copy = values;
+    auto packed = Finn::pack<Finn::DatatypeBipolar>(copy.begin(), copy.end());
+    Finn::PackedVector<Finn::DatatypeBipolar> result(std::move(packed), values.size());
+    EXPECT_EQ(result.size(), values.size());
+    EXPECT_EQ(result.expand(), values);
+    EXPECT_EQ(result.popcount(), static_cast<std::size_t>(std::count(values.begin(), values.end(), 1)));
+
+    // Copied and moved vectors keep a valid view of their own storage
+    const auto copied = result;
+    const auto moved = std::move(result);
+    EXPECT_EQ(copied.expand(), values);
+    EXPECT_EQ(moved.expand(), values);
+}
+
+TEST(PackedViewTest, EmptyVectorTest) {
+    using Vector = Finn::PackedVector<Finn::DatatypeBinary>;
+    Finn::vector<uint8_t> values{1, 0, 0, 1, 1};
+    Vector result(Finn::pack<Finn::DatatypeBinary>(values.begin(), values.end()), values.size());
+
+    // Moving leaves an empty vector that can be moved and copied again
+    Vector target(std::move(result));
+    EXPECT_TRUE(result.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(result.popcount(), 0U);
+    Vector fromMovedFrom(std::move(result));
+    const Vector copyOfMovedFrom(fromMovedFrom);
+    EXPECT_TRUE(fromMovedFrom.empty());
+    EXPECT_TRUE(copyOfMovedFrom.empty());
+
+    // Same for default constructed vectors
+    const Vector defaultConstructed;
+    Vector copied(defaultConstructed);
+    Vector moved(std::move(copied));
+    EXPECT_TRUE(copied.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.begin(), moved.end());
+
+    // Assigning empty vectors replaces the content
+    Vector assigned = target;
+    assigned = defaultConstructed;
+    EXPECT_TRUE(assigned.empty());
+    assigned = std::move(target);
+    EXPECT_EQ(assigned.expand(), values);
+    EXPECT_TRUE(target.empty());  // NOLINT(bugprone-use-after-move)
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.empty());
+}
+
+TEST(PackedViewTest, InvalidSizeTest) {
+    Finn::vector<uint8_t> bytes(3);
+    EXPECT_THROW(Finn::NibbleView<Finn::DatatypeUInt<4>>(std::span<const uint8_t>(bytes.data(), bytes.size()), 4), std::runtime_error);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
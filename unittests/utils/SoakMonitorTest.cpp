@@ -0,0 +1,67 @@
+/**
+ * @file SoakMonitorTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the latency sampling of the soak test
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/SoakMonitor.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+using Finn::SoakMonitor;
+
+TEST(SoakMonitorTest, LatencyBucketTest) {
+    // Small latencies are exact, larger ones are off by less than one sub bucket
+    for (uint64_t ns = 0; ns < SoakMonitor::latencySubBuckets * 2; ++ns) {
+        EXPECT_EQ(SoakMonitor::latencyBucketUpperBound(SoakMonitor::latencyBucket(ns)), ns);
+    }
+    for (const uint64_t ns : {uint64_t{100}, uint64_t{1000}, uint64_t{123456}, uint64_t{999999999}, std::numeric_limits<uint64_t>::max()}) {
+        const auto bucket = SoakMonitor::latencyBucket(ns);
+        ASSERT_LT(bucket, SoakMonitor::latencyBuckets);
+        const auto upper = SoakMonitor::latencyBucketUpperBound(bucket);
+        EXPECT_GE(upper, ns);
+        EXPECT_LE(static_cast<double>(upper - ns), static_cast<double>(ns) / SoakMonitor::latencySubBuckets);
+        if (bucket > 0) {
+            EXPECT_LT(SoakMonitor::latencyBucketUpperBound(bucket - 1), ns);
+        }
+    }
+}
+
+TEST(SoakMonitorTest, SampleTest) {
+    SoakMonitor monitor(Finn::SoakThresholds{});
+    // 990 fast steps and 10 slow ones
+    for (std::size_t i = 0; i < 990; ++i) {
+        monitor.record(std::chrono::microseconds(10), 2);
+    }
+    for (std::size_t i = 0; i < 10; ++i) {
+        monitor.record(std::chrono::milliseconds(1), 2);
+    }
+    const auto sample = monitor.sample();
+    EXPECT_EQ(sample.inferences, 2000U);
+    EXPECT_GE(sample.p50, 10.0);
+    EXPECT_LE(sample.p50, 10.0 * (1.0 + 1.0 / SoakMonitor::latencySubBuckets));
+    EXPECT_LT(sample.p99, 1000.0);
+    EXPECT_GE(sample.p999, 1000.0);
+    EXPECT_DOUBLE_EQ(sample.max, 1000.0);
+
+    // A new interval starts empty
+    const auto empty = monitor.sample();
+    EXPECT_EQ(empty.inferences, 0U);
+    EXPECT_EQ(empty.p50, 0.0);
+    EXPECT_EQ(empty.max, 0.0);
+    EXPECT_EQ(monitor.getSamples().size(), 2U);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
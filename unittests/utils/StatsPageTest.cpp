@@ -0,0 +1,173 @@
+/**
+ * @file StatsPageTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the live statistics and their shared memory stats page
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/LiveStats.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <FINNCppDriver/utils/StatsPage.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using FinnUtils::LiveStats;
+
+class StatsPageTest : public ::testing::Test {
+     protected:
+    void SetUp() override {
+        LiveStats::reset();
+        LiveStats::enable();
+    }
+
+    void TearDown() override {
+        LiveStats::disable();
+        LiveStats::reset();
+    }
+};
+
+TEST_F(StatsPageTest, RecordingTest) {
+    LiveStats::recordInference(100, 10, 4);
+    LiveStats::recordInference(100, 10, 4);
+    LiveStats::recordPolls(7);
+    LiveStats::setRingOccupancy(3, 16);
+    LiveStats::recordDeviceBusy(1, 500);
+    LiveStats::recordDeviceBusy(LiveStats::maxDevices, 500);
+    for (uint64_t i = 0; i < 99; ++i) {
+        LiveStats::recordLatency(DRIVER_STAGE::EXECUTE, 1000);
+    }
+    LiveStats::recordLatency(DRIVER_STAGE::EXECUTE, 1'000'000);
+
+    auto snapshot = LiveStats::snapshot();
+    EXPECT_EQ(snapshot.inferences, 2U);
+    EXPECT_EQ(snapshot.batchElements, 8U);
+    EXPECT_EQ(snapshot.bytesIn, 200U);
+    EXPECT_EQ(snapshot.bytesOut, 20U);
+    EXPECT_EQ(snapshot.waitPolls, 7U);
+    EXPECT_EQ(snapshot.ringUsed, 3U);
+    EXPECT_EQ(snapshot.ringCapacity, 16U);
+    EXPECT_EQ(snapshot.deviceBusyNs[1], 500U);
+
+    // Percentiles are reported as the upper bound of their bucket
+    const auto& execute = snapshot.latency[static_cast<std::size_t>(DRIVER_STAGE::EXECUTE)];
+    EXPECT_EQ(LiveStats::percentile(execute, 0.5), 1024U);
+    EXPECT_EQ(LiveStats::percentile(execute, 0.99), 1024U);
+    EXPECT_EQ(LiveStats::percentile(execute, 1.0), 1U << 20);
+    EXPECT_EQ(LiveStats::percentile(snapshot.latency[static_cast<std::size_t>(DRIVER_STAGE::PACK)], 0.5), 0U);
+
+    // Nothing is recorded while disabled
+    LiveStats::disable();
+    LiveStats::recordInference(100, 10, 4);
+    {
+        const LiveStats::StageTimer timer(DRIVER_STAGE::PACK);
+    }
+    snapshot = LiveStats::snapshot();
+    EXPECT_EQ(snapshot.inferences, 2U);
+    EXPECT_EQ(LiveStats::percentile(snapshot.latency[static_cast<std::size_t>(DRIVER_STAGE::PACK)], 0.5), 0U);
+}
+
+TEST_F(StatsPageTest, StageTimerTest) {
+    {
+        LiveStats::StageTimer timer(DRIVER_STAGE::EXECUTE, 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        timer.stop();
+        // Stopping twice records only once
+        timer.stop();
+    }
+    const auto snapshot = LiveStats::snapshot();
+    const auto& execute = snapshot.latency[static_cast<std::size_t>(DRIVER_STAGE::EXECUTE)];
+    EXPECT_EQ(std::count_if(execute.begin(), execute.end(), [](uint64_t count) { return count != 0; }), 1);
+    EXPECT_GE(LiveStats::percentile(execute, 0.5), 2'000'000U);
+    EXPECT_GE(snapshot.deviceBusyNs[2], 2'000'000U);
+}
+
+TEST_F(StatsPageTest, PublishAndReadTest) {
+    std::string pageName;
+    {
+        Finn::StatsPublisher publisher("UnittestDriver", std::chrono::milliseconds(5));
+        pageName = publisher.getPageName();
+        EXPECT_EQ(pageName, Finn::StatsPages::pageName(getpid()));
+        auto pages = Finn::StatsPages::list();
+        EXPECT_NE(std::find(pages.begin(), pages.end(), pageName), pages.end());
+
+        Finn::StatsPageReader reader(pageName);
+        auto data = reader.read();
+        ASSERT_TRUE(data.has_value());
+        EXPECT_EQ(data->pid, getpid());
+        EXPECT_EQ(std::string(data->name), "UnittestDriver");
+
+        LiveStats::recordInference(64, 8, 2);
+        publisher.publish();
+        data = reader.read();
+        ASSERT_TRUE(data.has_value());
+        EXPECT_EQ(data->stats.inferences, 1U);
+        EXPECT_EQ(data->stats.bytesIn, 64U);
+        EXPECT_LE(data->publishTimeNs, Finn::StatsPages::monotonicNs());
+    }
+    // The page is removed with the publisher
+    EXPECT_THROW(Finn::StatsPageReader reader(pageName), std::runtime_error);
+    EXPECT_FALSE(LiveStats::isEnabled());
+}
+
+TEST_F(StatsPageTest, StalePageTest) {
+    // A driver that is killed cannot remove its page
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        _exit(0);
+    }
+    ASSERT_EQ(waitpid(child, nullptr, 0), child);
+    const std::string stalePage = Finn::StatsPages::pageName(child);
+    const int fd = shm_open(stalePage.c_str(), O_CREAT | O_RDWR, 0600);
+    ASSERT_NE(fd, -1);
+    close(fd);
+
+    Finn::StatsPublisher publisher("LiveDriver", std::chrono::milliseconds(5));
+    auto pages = Finn::StatsPages::list();
+    EXPECT_EQ(std::find(pages.begin(), pages.end(), stalePage), pages.end());
+    EXPECT_NE(std::find(pages.begin(), pages.end(), publisher.getPageName()), pages.end());
+    // The stale page was removed
+    EXPECT_EQ(shm_open(stalePage.c_str(), O_RDONLY, 0), -1);
+}
+
+TEST_F(StatsPageTest, ConsistentReadTest) {
+    Finn::StatsPublisher publisher("ConcurrentDriver", std::chrono::milliseconds(1));
+    Finn::StatsPageReader reader(publisher.getPageName());
+    std::atomic<bool> done{false};
+    std::jthread producer([&done]() {
+        while (!done) {
+            LiveStats::recordInference(3, 1, 1);
+        }
+    });
+    // Reads overlap with the publisher thread, but always return a complete publish
+    uint64_t lastInferences = 0;
+    uint64_t lastPublish = 0;
+    for (int i = 0; i < 2000; ++i) {
+        auto data = reader.read();
+        ASSERT_TRUE(data.has_value());
+        EXPECT_EQ(data->magic, Finn::StatsPageData::pageMagic);
+        EXPECT_EQ(std::string(data->name), "ConcurrentDriver");
+        EXPECT_GE(data->stats.inferences, lastInferences);
+        EXPECT_GE(data->publishTimeNs, lastPublish);
+        lastInferences = data->stats.inferences;
+        lastPublish = data->publishTimeNs;
+    }
+    done = true;
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file StreamingCopyTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the copy routines used to access buffer object maps
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/FinnUtils.h>
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/utils/DataPacking.hpp>
+#include <FINNCppDriver/utils/DynamicMdSpan.hpp>
+#include <FINNCppDriver/utils/StreamingCopy.hpp>
+#include <array>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace {
+    // Sizes and offsets cover empty copies, copies shorter than a vector and unaligned heads and tails
+    constexpr std::array<std::size_t, 9> sizes = {0, 1, 15, 16, 17, 63, 64, 65, 4099};
+    constexpr std::array<std::size_t, 4> offsets = {0, 1, 7, 15};
+
+    template<typename CopyFunc>
+    void checkCopy(CopyFunc copy) {
+        FinnUtils::BufferFiller filler(0, 255);
+        for (auto size : sizes) {
+            for (auto srcOffset : offsets) {
+                for (auto dstOffset : offsets) {
+                    Finn::vector<uint8_t> src(size + srcOffset);
+                    filler.fillRandom(src.begin(), src.end());
+                    Finn::vector<uint8_t> dst(size + dstOffset + 1, 0xAB);
+                    copy(dst.data() + dstOffset, src.data() + srcOffset, size);
+                    EXPECT_TRUE(std::equal(src.begin() + static_cast<long>(srcOffset), src.end(), dst.begin() + static_cast<long>(dstOffset))) << "size " << size << " src offset " << srcOffset << " dst offset " << dstOffset;
+                    // Nothing around the destination range is overwritten
+                    EXPECT_TRUE(std::all_of(dst.begin(), dst.begin() + static_cast<long>(dstOffset), [](uint8_t val) { return val == 0xAB; }));
+                    EXPECT_EQ(dst.back(), 0xAB);
+                }
+            }
+        }
+    }
+}  // namespace
+
+TEST(StreamingCopyTest, StreamingStoreTest) { checkCopy(FinnUtils::streamingStore); }
+
+TEST(StreamingCopyTest, StreamingLoadTest) { checkCopy(FinnUtils::streamingLoad); }
+
+TEST(StreamingCopyTest, MapTypeDispatchTest) {
+    for (auto mapType : {MAP_TYPE::CACHED, MAP_TYPE::WRITE_COMBINED, MAP_TYPE::UNCACHED}) {
+        checkCopy([mapType](void* dst, const void* src, std::size_t bytes) { FinnUtils::copyToMap(mapType, dst, src, bytes); });
+        checkCopy([mapType](void* dst, const void* src, std::size_t bytes) { FinnUtils::copyFromMap(mapType, dst, src, bytes); });
+    }
+}
+
+TEST(StreamingCopyTest, PackIntoMapTest) {
+    constexpr std::size_t rows = 300;
+    constexpr std::size_t elementsPerRow = 7;
+    FinnUtils::BufferFiller filler(0, 31);
+    Finn::vector<uint8_t> raw(rows * elementsPerRow);
+    filler.fillRandom(raw.begin(), raw.end());
+    // Shift into the value range of DatatypeInt<5>
+    Finn::vector<int8_t> data(raw.size());
+    std::transform(raw.begin(), raw.end(), data.begin(), [](uint8_t val) { return static_cast<int8_t>(static_cast<int>(val) - 16); });
+
+    for (auto mapType : {MAP_TYPE::CACHED, MAP_TYPE::WRITE_COMBINED, MAP_TYPE::UNCACHED}) {
+        // Packing modifies the input in place, so every packing call gets its own copy
+        Finn::vector<int8_t> inputExpected(data);
+        Finn::DynamicMdSpan spanExpected(inputExpected.begin(), inputExpected.end(), {1, rows, elementsPerRow});
+        auto expected = Finn::packMultiDimensionalInputs<Finn::DatatypeInt<5>>(inputExpected.begin(), inputExpected.end(), spanExpected, elementsPerRow);
+
+        Finn::vector<int8_t> input(data);
+        Finn::DynamicMdSpan span(input.begin(), input.end(), {1, rows, elementsPerRow});
+        Finn::vector<uint8_t> map(expected.size() + 3, 0);
+        auto written = Finn::packMultiDimensionalInputs<Finn::DatatypeInt<5>>(input.begin(), input.end(), span, elementsPerRow, std::span<uint8_t>(map.data() + 3, expected.size()), mapType);
+        EXPECT_EQ(written, expected.size());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), map.begin() + 3));
+    }
+
+    Finn::vector<int8_t> input(data);
+    Finn::DynamicMdSpan span(input.begin(), input.end(), {1, rows, elementsPerRow});
+    Finn::vector<uint8_t> tooSmall(10);
+    EXPECT_THROW(Finn::packMultiDimensionalInputs<Finn::DatatypeInt<5>>(input.begin(), input.end(), span, elementsPerRow, std::span<uint8_t>(tooSmall), MAP_TYPE::WRITE_COMBINED), std::length_error);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
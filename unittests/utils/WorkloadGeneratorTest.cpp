@@ -0,0 +1,128 @@
+/**
+ * @file WorkloadGeneratorTest.cpp
+ * @author Linus Jungemann (linus.jungemann@uni-paderborn.de) and others
+ * @brief Unittest for the synthetic workload generator
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ * @license All rights reserved. This program and the accompanying materials are made available under the terms of the MIT license.
+ *
+ */
+
+#include <FINNCppDriver/utils/Types.h>
+
+#include <FINNCppDriver/utils/WorkloadGenerator.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+    constexpr std::size_t frameElements = 100;
+    constexpr std::size_t batchSize = 4;
+    constexpr std::size_t batchCount = 32;
+
+    /**
+     * @brief Collect all frames of all precomputed batches
+     *
+     * @tparam T
+     * @param generator
+     * @return std::vector<std::vector<T>>
+     */
+    template<typename T>
+    std::vector<std::vector<T>> frames(const Finn::WorkloadGenerator<T>& generator) {
+        std::vector<std::vector<T>> ret;
+        for (std::size_t i = 0; i < generator.size(); ++i) {
+            auto batch = generator.batch(i);
+            for (std::size_t frame = 0; frame < batchSize; ++frame) {
+                ret.emplace_back(batch.begin() + static_cast<long>(frame * frameElements), batch.begin() + static_cast<long>((frame + 1) * frameElements));
+            }
+        }
+        return ret;
+    }
+}  // namespace
+
+TEST(WorkloadGeneratorTest, UniformTest) {
+    Finn::WorkloadGenerator<int8_t> generator(frameElements, batchSize, batchCount, -2, 1, {.seed = 42});
+    EXPECT_EQ(generator.size(), batchCount);
+    EXPECT_EQ(generator.batchElements(), frameElements * batchSize);
+
+    std::map<int8_t, std::size_t> histogram;
+    for (std::size_t i = 0; i < batchCount; ++i) {
+        for (auto val : generator.next()) {
+            ++histogram[val];
+        }
+    }
+    // All values of the range occur, and nothing outside of it
+    ASSERT_EQ(histogram.size(), 4U);
+    EXPECT_EQ(histogram.begin()->first, -2);
+    EXPECT_EQ(histogram.rbegin()->first, 1);
+    for (auto&& [val, count] : histogram) {
+        EXPECT_GT(count, frameElements * batchSize * batchCount / 8) << "value " << static_cast<int>(val);
+    }
+
+    // The stream wraps around and the same seed reproduces the stream
+    auto first = generator.next();
+    Finn::WorkloadGenerator<int8_t> same(frameElements, batchSize, batchCount, -2, 1, {.seed = 42});
+    EXPECT_TRUE(std::equal(first.begin(), first.end(), same.batch(0).begin()));
+
+    Finn::WorkloadGenerator<float> floats(frameElements, batchSize, batchCount, -1.0F, 1.0F, {.seed = 7});
+    auto batch = floats.next();
+    EXPECT_TRUE(std::all_of(batch.begin(), batch.end(), [](float val) { return val >= -1.0F && val <= 1.0F; }));
+}
+
+TEST(WorkloadGeneratorTest, ZipfTest) {
+    Finn::WorkloadGenerator<uint8_t> generator(frameElements, batchSize, batchCount, 0, 255, {.type = WORKLOAD::ZIPF, .distinctFrames = 8, .zipfExponent = 1.5, .seed = 42});
+    std::map<std::vector<uint8_t>, std::size_t> histogram;
+    for (auto&& frame : frames(generator)) {
+        ++histogram[frame];
+    }
+    EXPECT_LE(histogram.size(), 8U);
+    // The most popular frame dominates the stream
+    std::size_t maxCount = 0;
+    for (auto&& [frame, count] : histogram) {
+        maxCount = std::max(maxCount, count);
+    }
+    EXPECT_GT(maxCount, batchSize * batchCount / 4);
+}
+
+TEST(WorkloadGeneratorTest, CorrelatedTest) {
+    Finn::WorkloadGenerator<uint8_t> generator(frameElements, batchSize, batchCount, 0, 255, {.type = WORKLOAD::CORRELATED, .deltaFraction = 0.05, .seed = 42});
+    auto all = frames(generator);
+    std::size_t changedTotal = 0;
+    for (std::size_t i = 1; i < all.size(); ++i) {
+        std::size_t changed = 0;
+        for (std::size_t j = 0; j < frameElements; ++j) {
+            changed += (all[i][j] != all[i - 1][j]) ? 1U : 0U;
+        }
+        EXPECT_LE(changed, 5U);
+        changedTotal += changed;
+    }
+    EXPECT_GT(changedTotal, 0U);
+}
+
+TEST(WorkloadGeneratorTest, BurstyTest) {
+    Finn::WorkloadGenerator<uint8_t> generator(frameElements, batchSize, batchCount, 0, 255, {.type = WORKLOAD::BURSTY, .burstLength = 4, .burstGap = std::chrono::microseconds(250), .seed = 42});
+    for (std::size_t i = 0; i < 3 * batchCount; ++i) {
+        const auto expected = (i != 0 && i % 4 == 0) ? std::chrono::microseconds(250) : std::chrono::microseconds(0);
+        EXPECT_EQ(generator.arrivalDelay(i), expected);
+    }
+    Finn::WorkloadGenerator<uint8_t> uniform(frameElements, batchSize, batchCount, 0, 255);
+    EXPECT_EQ(uniform.arrivalDelay(4), std::chrono::microseconds(0));
+}
+
+TEST(WorkloadGeneratorTest, ParseTest) {
+    for (auto workload : {WORKLOAD::UNIFORM, WORKLOAD::ZIPF, WORKLOAD::CORRELATED, WORKLOAD::BURSTY}) {
+        EXPECT_EQ(Finn::workloadFromString(Finn::toString(workload)), workload);
+    }
+    EXPECT_THROW(Finn::workloadFromString("random"), std::invalid_argument);
+    EXPECT_THROW(Finn::WorkloadGenerator<uint8_t>(0, batchSize, batchCount, 0, 255), std::runtime_error);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
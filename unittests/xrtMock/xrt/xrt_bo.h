@@ -3,15 +3,21 @@
 
 #include <FINNCppDriver/utils/Logger.h>
 
+#include <cstdint>
+
 #include "../xrt.h"
 #include "xrt_device.h"
 
 namespace xrt {
     class bo {
+         public:
+        enum class flags : uint32_t { normal = 0, cacheable = (1U << 24U), svm = (1U << 27U), device_only = (1U << 28U), host_only = (1U << 29U), p2p = (1U << 30U) };
+
          private:
         xrt::device device;
         size_t byteSize;
         unsigned int group;
+        flags boFlags = flags::normal;
 
         void* memmap = nullptr;
 
@@ -20,7 +26,11 @@ namespace xrt {
          public:
         bo(xrt::device pDevice, size_t pBytesize, unsigned int pGroup) : device(pDevice), byteSize(pBytesize), group(pGroup), logger(Logger::getLogger()) { FINN_LOG(logger, loglevel::debug) << "(xrtMock) xrt::bo object created!\n"; }
 
-        bo(bo&& other) noexcept : device(std::move(other.device)), byteSize(other.byteSize), group(other.group), memmap(nullptr), logger(Logger::getLogger()) { std::swap(memmap, other.memmap); }
+        bo(xrt::device pDevice, size_t pBytesize, flags pFlags, unsigned int pGroup) : device(pDevice), byteSize(pBytesize), group(pGroup), boFlags(pFlags), logger(Logger::getLogger()) {
+            FINN_LOG(logger, loglevel::debug) << "(xrtMock) xrt::bo object created!\n";
+        }
+
+        bo(bo&& other) noexcept : device(std::move(other.device)), byteSize(other.byteSize), group(other.group), boFlags(other.boFlags), memmap(nullptr), logger(Logger::getLogger()) { std::swap(memmap, other.memmap); }
 
         void sync(xclBOSyncDirection);
         void sync(xclBOSyncDirection dir, size_t sz, size_t offset);
@@ -42,6 +52,8 @@ namespace xrt {
         }
 
         uint64_t address() const { return 0; };
+
+        flags get_flags() const { return boFlags; }
     };
 }  // namespace xrt
 